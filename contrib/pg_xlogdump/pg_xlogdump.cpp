@@ -243,10 +243,11 @@ static void XLogDumpTablePage(XLogReaderState* record, int block_id, RelFileNode
     if (fd < 0)
         fatal_error("could not create file %s :%m", block_path);
 
-    RestoreBlockImage(record->blocks[block_id].bkp_image,
+    if (!RestoreBlockImage(record->blocks[block_id].bkp_image,
         record->blocks[block_id].hole_offset,
         record->blocks[block_id].hole_length,
-        page);
+        page))
+        fatal_error("could not decompress image of block %u", blk);
 
     nbyte = write(fd, page, BLCKSZ);
     if (nbyte != BLCKSZ)
@@ -585,9 +586,16 @@ static void XLogDumpDisplayRecord(XLogDumpConfig* config, XLogReaderState* recor
         printf(" lastlsn %X/%X", (uint32)(lsn >> 32), (uint32)lsn);
         if (XLogRecHasBlockImage(record, block_id)) {
             if (config->bkp_details) {
-                printf(" (FPW); hole: offset: %u, length: %u",
-                    record->blocks[block_id].hole_offset,
-                    record->blocks[block_id].hole_length);
+                if (BKPIMAGE_IS_COMPRESSED(record->blocks[block_id].hole_offset)) {
+                    printf(" (FPW); compressed %s, length: %u",
+                        (record->blocks[block_id].hole_offset & BKPIMAGE_COMPRESS_MASK) == BKPIMAGE_COMPRESS_LZ4 ?
+                        "lz4" : "zstd",
+                        BLCKSZ - record->blocks[block_id].hole_length);
+                } else {
+                    printf(" (FPW); hole: offset: %u, length: %u",
+                        record->blocks[block_id].hole_offset,
+                        record->blocks[block_id].hole_length);
+                }
 
                 if (config->write_fpw)
                     XLogDumpTablePage(record, block_id, rnode, blk);
@@ -43,6 +43,20 @@ typedef struct
     int            ret;
 } restore_files_arg;
 
+typedef struct
+{
+    parray       *dest_files;
+    parray       *dest_external_dirs;
+    bool        skip_external_dirs;
+    const char *to_root;
+
+    /*
+     * Return value from the thread.
+     * 0 means there is no error, 1 - there is an error.
+     */
+    int            ret;
+} sync_files_arg;
+
 static void create_recovery_conf(time_t backup_id,
                                  pgRecoveryTarget *rt,
                                  pgBackup *backup,
@@ -51,6 +65,7 @@ static void construct_restore_cmd(FILE *fp, pgRecoveryTarget *rt,
                                   bool restore_command_provided,
                                   bool target_immediate);
 static void *restore_files(void *arg);
+static void *sync_files(void *arg);
 static void set_orphan_status(parray *backups, pgBackup *parent_backup);
 static void pg12_recovery_config(pgBackup *backup, bool add_include);
 
@@ -1083,23 +1098,87 @@ static void sync_restored_files(parray *dest_files,
                                 pgRestoreParams *params,
                                 const char *pgdata_path)
 {
+    int         i;
     char        pretty_time[20];
     time_t      start_time, end_time;
-    
+    bool        sync_isok = true;
+    pthread_t  *threads;
+    sync_files_arg *threads_args;
+
     elog(INFO, "Syncing restored files to disk");
     time(&start_time);
+    thread_interrupted = false;
 
-    for (size_t i = 0; i < parray_num(dest_files); i++)
+    /* restore threads have consumed the file locks, hand them out again */
+    for (size_t j = 0; j < parray_num(dest_files); j++)
     {
-        char        to_fullpath[MAXPGPATH];
-        pgFile       *dest_file = (pgFile *)parray_get(dest_files, i);
+        pgFile *file = (pgFile *)parray_get(dest_files, j);
+
+        pg_atomic_clear_flag(&file->lock);
+    }
+
+    threads = (pthread_t *) palloc(sizeof(pthread_t) * num_threads);
+    threads_args = (sync_files_arg *) palloc(sizeof(sync_files_arg) * num_threads);
+
+    for (i = 0; i < num_threads; i++)
+    {
+        sync_files_arg *arg = &(threads_args[i]);
+
+        arg->dest_files = dest_files;
+        arg->dest_external_dirs = external_dirs;
+        arg->skip_external_dirs = params->skip_external_dirs;
+        arg->to_root = pgdata_path;
+        /* By default there are some error */
+        arg->ret = 1;
+
+        pthread_create(&threads[i], NULL, sync_files, arg);
+    }
+
+    for (i = 0; i < num_threads; i++)
+    {
+        pthread_join(threads[i], NULL);
+        if (threads_args[i].ret == 1)
+            sync_isok = false;
+    }
+
+    pfree(threads);
+    pfree(threads_args);
+
+    if (!sync_isok)
+        elog(ERROR, "Syncing restored files failed");
+
+    time(&end_time);
+    pretty_time_interval(difftime(end_time, start_time),
+                         pretty_time, lengthof(pretty_time));
+    elog(INFO, "Restored backup files are synced, time elapsed: %s", pretty_time);
+}
+
+/*
+ * Sync restored files to disk.  fsync() of a big data file can take a while,
+ * so the files are shared out between threads the same way as for restore.
+ */
+static void *
+sync_files(void *arg)
+{
+    char        to_fullpath[MAXPGPATH];
+    sync_files_arg *arguments = (sync_files_arg *) arg;
+
+    for (size_t i = 0; i < parray_num(arguments->dest_files); i++)
+    {
+        pgFile       *dest_file = (pgFile *)parray_get(arguments->dest_files, i);
 
         if (S_ISDIR(dest_file->mode))
             continue;
 
+        if (!pg_atomic_test_set_flag(&dest_file->lock))
+            continue;
+
+        if (interrupted || thread_interrupted)
+            elog(ERROR, "Interrupted during sync");
+
         /* skip external files if ordered to do so */
         if (dest_file->external_dir_num > 0 &&
-            params->skip_external_dirs)
+            arguments->skip_external_dirs)
             continue;
 
         /* construct fullpath */
@@ -1109,11 +1188,12 @@ static void sync_restored_files(parray *dest_files,
                 continue;
             if (strcmp(DATABASE_MAP, dest_file->rel_path) == 0)
                 continue;
-            join_path_components(to_fullpath, pgdata_path, dest_file->rel_path);
+            join_path_components(to_fullpath, arguments->to_root, dest_file->rel_path);
         }
         else
         {
-            char *external_path = (char *)parray_get(external_dirs, dest_file->external_dir_num - 1);
+            char *external_path = (char *)parray_get(arguments->dest_external_dirs,
+                                                     dest_file->external_dir_num - 1);
             join_path_components(to_fullpath, external_path, dest_file->rel_path);
         }
 
@@ -1122,10 +1202,12 @@ static void sync_restored_files(parray *dest_files,
             elog(ERROR, "Failed to sync file \"%s\": %s", to_fullpath, strerror(errno));
     }
 
-    time(&end_time);
-    pretty_time_interval(difftime(end_time, start_time),
-                         pretty_time, lengthof(pretty_time));
-    elog(INFO, "Restored backup files are synced, time elapsed: %s", pretty_time);
+    /* ssh connection to longer needed */
+    fio_disconnect();
+
+    arguments->ret = 0;
+
+    return NULL;
 }
 
 inline void RestoreCompressFile(FILE *out, char *to_fullpath, pgFile *dest_file)
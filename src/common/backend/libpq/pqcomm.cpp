@@ -136,6 +136,7 @@ void pq_close(int code, Datum arg);
 
 /* Internal functions */
 static int internal_flush(void);
+static int internal_flush_buffer(const char* buf, size_t* start, size_t* end);
 static void pq_set_nonblocking(bool nonblocking);
 static void pq_disk_generate_checking_header(
     const char* src_data, StringInfo dest_data, uint32 data_len, uint32 seq_num);
@@ -1532,6 +1533,26 @@ int internal_putbytes(const char* s, size_t len)
     size_t amount;
 
     while (len > 0) {
+        /*
+         * If the buffer is empty and the data doesn't fit in it anyway, send
+         * it straight from the caller's memory: copying it through the buffer
+         * only to flush it right away is the bulk of the cost of streaming
+         * large rows.  Results spooled to a temp file and the comm proxy xlog
+         * path always go through the buffer.
+         */
+        if (t_thrd.libpq_cxt.PqSendStart == t_thrd.libpq_cxt.PqSendPointer &&
+            len >= (size_t)t_thrd.libpq_cxt.PqSendBufferSize && !pq_disk_is_temp_file_enabled() &&
+            !(t_thrd.walsender_cxt.ep_fd != -1 && g_comm_proxy_config.s_send_xlog_mode == CommSendXlogWaitIn)) {
+            size_t start = 0;
+
+            StmtRetrySetFileExceededFlag(); /* once flush data to frontend, can not retry this query anymore */
+            pq_set_nonblocking(false);
+            if (internal_flush_buffer(s, &start, &len)) {
+                return EOF;
+            }
+            break;
+        }
+
         /* If buffer is full, then flush it out */
         if (t_thrd.libpq_cxt.PqSendPointer >= t_thrd.libpq_cxt.PqSendBufferSize) {
             if (pq_disk_is_temp_file_enabled()) {
@@ -1655,11 +1676,30 @@ int internal_flush(void)
         return libnet_flush();
     }
 
+    size_t start = (size_t)t_thrd.libpq_cxt.PqSendStart;
+    size_t end = (size_t)t_thrd.libpq_cxt.PqSendPointer;
+    int res = internal_flush_buffer(t_thrd.libpq_cxt.PqSendBuffer, &start, &end);
+
+    t_thrd.libpq_cxt.PqSendStart = (int)start;
+    t_thrd.libpq_cxt.PqSendPointer = (int)end;
+    return res;
+}
+
+/* --------------------------------
+ *		internal_flush_buffer - flush buf[*start .. *end)
+ *
+ * *start is advanced over what got sent.  Both are reset to 0 once all of
+ * it is sent, or when it is dropped after a send failure.  Return value as
+ * for internal_flush.
+ * --------------------------------
+ */
+static int internal_flush_buffer(const char* buf, size_t* start, size_t* end)
+{
     static THR_LOCAL int last_reported_send_errno = 0;
 
     errno_t ret;
-    char* bufptr = t_thrd.libpq_cxt.PqSendBuffer + t_thrd.libpq_cxt.PqSendStart;
-    char* bufend = t_thrd.libpq_cxt.PqSendBuffer + t_thrd.libpq_cxt.PqSendPointer;
+    const char* bufptr = buf + *start;
+    const char* bufend = buf + *end;
     char connTimeInfoStr[INITIAL_EXPBUFFER_SIZE] = {'\0'};
     WaitState oldStatus = pgstat_report_waitstatus(STATE_WAIT_UNDEFINED, true);
 
@@ -1691,7 +1731,7 @@ int internal_flush(void)
     while (bufptr < bufend) {
         int r;
 
-        r = secure_write(u_sess->proc_cxt.MyProcPort, bufptr, bufend - bufptr);
+        r = secure_write(u_sess->proc_cxt.MyProcPort, (void*)bufptr, bufend - bufptr);
         if (unlikely(r == 0 && (StreamThreadAmI() == true || u_sess->proc_cxt.MyProcPort->is_logic_conn))) {
             /* Stop query when cancel happend */
             if (t_thrd.int_cxt.QueryCancelPending) {
@@ -1747,7 +1787,7 @@ int internal_flush(void)
              * flag that'll cause the next CHECK_FOR_INTERRUPTS to terminate
              * the connection.
              */
-            t_thrd.libpq_cxt.PqSendStart = t_thrd.libpq_cxt.PqSendPointer = 0;
+            *start = *end = 0;
             SetConnectionLostFlag();
             (void)pgstat_report_waitstatus(oldStatus);
             return EOF;
@@ -1755,10 +1795,10 @@ int internal_flush(void)
 
         last_reported_send_errno = 0; /* reset after any successful send */
         bufptr += r;
-        t_thrd.libpq_cxt.PqSendStart += r;
+        *start += r;
     }
 
-    t_thrd.libpq_cxt.PqSendStart = t_thrd.libpq_cxt.PqSendPointer = 0;
+    *start = *end = 0;
     (void)pgstat_report_waitstatus(oldStatus);
     return 0;
 }
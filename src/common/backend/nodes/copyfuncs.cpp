@@ -1302,6 +1302,7 @@ static Sort* _copySort(const Sort* from)
         COPY_POINTER_FIELD(collations, from->numCols * sizeof(Oid));
         COPY_POINTER_FIELD(nullsFirst, from->numCols * sizeof(bool));
     }
+    COPY_SCALAR_FIELD(numPresorted);
 #ifdef PGXC
     COPY_SCALAR_FIELD(srt_start_merge);
 #endif
@@ -1360,6 +1361,7 @@ static Agg* _copyAgg(const Agg* from)
     COPY_SCALAR_FIELD(is_dummy);
     COPY_SCALAR_FIELD(skew_optimize);
     COPY_SCALAR_FIELD(unique_check);
+    COPY_SCALAR_FIELD(upper_combine);
     return newnode;
 }
 
@@ -1728,6 +1730,7 @@ static VecAgg* _copyVecAgg(const VecAgg* from)
     COPY_SCALAR_FIELD(is_sonichash);
     COPY_SCALAR_FIELD(skew_optimize);
     COPY_SCALAR_FIELD(unique_check);
+    COPY_SCALAR_FIELD(upper_combine);
     CopyMemInfoFields(&from->mem_info, &newnode->mem_info);
 
     return newnode;
@@ -1649,6 +1649,9 @@ static void _outVecHashAgg(StringInfo str, VecAgg* node)
     if (t_thrd.proc->workingVersionNum >= SUBLINKPULLUP_VERSION_NUM) {
         WRITE_BOOL_FIELD(unique_check);
     }
+    if (t_thrd.proc->workingVersionNum >= AGG_UPPER_COMBINE_VERSION_NUM) {
+        WRITE_BOOL_FIELD(upper_combine);
+    }
 }
 
 static void _outAgg(StringInfo str, Agg* node)
@@ -1681,6 +1684,9 @@ static void _outAgg(StringInfo str, Agg* node)
     if (t_thrd.proc->workingVersionNum >= SUBLINKPULLUP_VERSION_NUM) {
         WRITE_BOOL_FIELD(unique_check);
     }
+    if (t_thrd.proc->workingVersionNum >= AGG_UPPER_COMBINE_VERSION_NUM) {
+        WRITE_BOOL_FIELD(upper_combine);
+    }
 }
 
 static void _outWindowAgg(StringInfo str, WindowAgg* node)
@@ -1844,6 +1850,7 @@ static void _outSort(StringInfo str, Sort* node)
         appendStringInfo(str, " %s", booltostr(node->nullsFirst[i]));
     }
     out_mem_info(str, &node->mem_info);
+    WRITE_INT_FIELD(numPresorted);
 }
 
 static void _outUnique(StringInfo str, Unique* node)
@@ -3302,6 +3302,12 @@ static Agg* _readAgg(Agg* local_node)
         READ_BOOL_FIELD(unique_check);
     }
 
+    if (t_thrd.proc->workingVersionNum >= AGG_UPPER_COMBINE_VERSION_NUM) {
+        IF_EXIST(upper_combine) {
+            READ_BOOL_FIELD(upper_combine);
+        }
+    }
+
     READ_DONE();
 }
 
@@ -3815,6 +3821,9 @@ static Sort* _readSort(Sort* local_node)
 
     READ_BOOL_ARRAY(nullsFirst, numCols);
     read_mem_info(&local_node->mem_info);
+    IF_EXIST(numPresorted) {
+        READ_INT_FIELD(numPresorted);
+    }
 
     READ_DONE();
 }
@@ -4916,6 +4925,12 @@ static VecAgg* _readVecAgg(VecAgg* local_node)
         READ_BOOL_FIELD(unique_check);
     }
 
+    if (t_thrd.proc->workingVersionNum >= AGG_UPPER_COMBINE_VERSION_NUM) {
+        IF_EXIST(upper_combine) {
+            READ_BOOL_FIELD(upper_combine);
+        }
+    }
+
     READ_DONE();
 }
 
@@ -66,10 +66,35 @@ static PGShmemHeader* PGSharedMemoryAttach(IpcMemoryKey key, IpcMemoryId* shmid)
  */
 static void* InternalIpcMemoryCreate(IpcMemoryKey memKey, Size size)
 {
-    IpcMemoryId shmid;
+    IpcMemoryId shmid = -1;
     void* memAddress = NULL;
 
-    shmid = shmget(memKey, size, IPC_CREAT | IPC_EXCL | IPCProtection);
+#ifdef SHM_HUGETLB
+    /*
+     * Try to back the segment with huge pages first, which saves a lot of TLB
+     * misses on a big buffer pool.  If the kernel has no huge pages to spare,
+     * carry on with normal pages rather than refusing to start.
+     */
+    if (g_instance.attr.attr_storage.enable_huge_pages) {
+        shmid = shmget(memKey, size, IPC_CREAT | IPC_EXCL | IPCProtection | SHM_HUGETLB);
+        if (shmid < 0) {
+            if (errno == EEXIST || errno == EACCES
+#ifdef EIDRM
+                || errno == EIDRM
+#endif
+            )
+                return NULL;
+
+            ereport(LOG,
+                (errmsg("could not create shared memory segment of %lu bytes with huge pages: %m", (unsigned long)size),
+                    errhint("Falling back to normal pages. Check vm.nr_hugepages and the memlock limit.")));
+        }
+    }
+#endif
+
+    if (shmid < 0) {
+        shmid = shmget(memKey, size, IPC_CREAT | IPC_EXCL | IPCProtection);
+    }
     if (shmid < 0) {
         /*
          * Fail quietly if error indicates a collision with existing segment.
@@ -5762,18 +5762,15 @@ bool is_role_independent(Oid roleid)
     bool isNull = false;
     bool flag = false;
 
-    Relation relation = heap_open(AuthIdRelationId, AccessShareLock);
-
-    TupleDesc pg_authid_dsc = RelationGetDescr(relation);
-
     /* Look up the information in pg_authid. */
     rtup = SearchSysCache1(AUTHOID, ObjectIdGetDatum(roleid));
     if (HeapTupleIsValid(rtup)) {
         /*
-         * For upgrade reason,  we must get field value through heap_getattr function
-         * although it is a char type value.
+         * For upgrade reason, we must get field value through heap_getattr function
+         * although it is a char type value.  SysCacheGetAttr does that with the
+         * catalog's descriptor kept by the cache, so pg_authid need not be opened.
          */
-        Datum authidrolkindDatum = heap_getattr(rtup, Anum_pg_authid_rolkind, pg_authid_dsc, &isNull);
+        Datum authidrolkindDatum = SysCacheGetAttr(AUTHOID, rtup, Anum_pg_authid_rolkind, &isNull);
 
         if (DatumGetChar(authidrolkindDatum) == ROLKIND_INDEPENDENT)
             flag = true;
@@ -5783,8 +5780,6 @@ bool is_role_independent(Oid roleid)
         ReleaseSysCache(rtup);
     }
 
-    heap_close(relation, AccessShareLock);
-
     return flag;
 }
 
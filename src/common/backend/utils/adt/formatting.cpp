@@ -3189,6 +3189,28 @@ static int from_char_seq_search(int* dest, char** src, char** array, int type, i
                 (errcode(ERRCODE_DATETIME_VALUE_OUT_OF_RANGE), errmsg("localized string format value too long"))); \
     } while (0)
 
+/*
+ * Common case of DCH_to_char for a numeric field: no FM or TH suffix, so the
+ * value is printed zero-padded to exactly "width" digits.  Do that without
+ * going through sprintf_s, and return false for anything else, which the
+ * caller then formats the normal way.
+ */
+static inline bool DCH_to_char_fixed_digits(char* s, int len, int value, int width, const FormatNode* n)
+{
+    static const int limits[] = {1, 10, 100, 1000, 10000};
+
+    if (S_FM(n->suffix) || S_THth(n->suffix) || value < 0 || value >= limits[width] || len <= width) {
+        return false;
+    }
+
+    for (int i = width - 1; i >= 0; i--) {
+        s[i] = (char)('0' + value % 10);
+        value /= 10;
+    }
+    s[width] = '\0';
+    return true;
+}
+
 /* ----------
  * Process a TmToChar struct as denoted by a list of FormatNodes.
  * The formatted data is written to the string pointed to by 'out'.
@@ -3258,6 +3280,10 @@ static void DCH_to_char(FormatNode* node, bool is_interval, TmToChar* in, char*
                 s += strlen(s);
                 break;
             case DCH_HH24:
+                if (DCH_to_char_fixed_digits(s, len, tm->tm_hour, 2, n)) {
+                    s += 2;
+                    break;
+                }
                 rc = sprintf_s(s, len, "%0*d", S_FM(n->suffix) ? 0 : 2, tm->tm_hour);
                 securec_check_ss(rc, "\0", "\0");
                 if (S_THth(n->suffix))
@@ -3265,6 +3291,10 @@ static void DCH_to_char(FormatNode* node, bool is_interval, TmToChar* in, char*
                 s += strlen(s);
                 break;
             case DCH_MI:
+                if (DCH_to_char_fixed_digits(s, len, tm->tm_min, 2, n)) {
+                    s += 2;
+                    break;
+                }
                 rc = sprintf_s(s, len, "%0*d", S_FM(n->suffix) ? 0 : 2, tm->tm_min);
                 securec_check_ss(rc, "\0", "\0");
                 if (S_THth(n->suffix))
@@ -3272,6 +3302,10 @@ static void DCH_to_char(FormatNode* node, bool is_interval, TmToChar* in, char*
                 s += strlen(s);
                 break;
             case DCH_SS:
+                if (DCH_to_char_fixed_digits(s, len, tm->tm_sec, 2, n)) {
+                    s += 2;
+                    break;
+                }
                 rc = sprintf_s(s, len, "%0*d", S_FM(n->suffix) ? 0 : 2, tm->tm_sec);
                 securec_check_ss(rc, "\0", "\0");
                 if (S_THth(n->suffix))
@@ -3484,6 +3518,10 @@ static void DCH_to_char(FormatNode* node, bool is_interval, TmToChar* in, char*
                 s += strlen(s);
                 break;
             case DCH_MM:
+                if (DCH_to_char_fixed_digits(s, len, tm->tm_mon, 2, n)) {
+                    s += 2;
+                    break;
+                }
                 rc = sprintf_s(s, len, "%0*d", S_FM(n->suffix) ? 0 : 2, tm->tm_mon);
                 securec_check_ss(rc, "\0", "\0");
                 if (S_THth(n->suffix))
@@ -3571,6 +3609,10 @@ static void DCH_to_char(FormatNode* node, bool is_interval, TmToChar* in, char*
                 s += strlen(s);
                 break;
             case DCH_DD:
+                if (DCH_to_char_fixed_digits(s, len, tm->tm_mday, 2, n)) {
+                    s += 2;
+                    break;
+                }
                 rc = sprintf_s(s, len, "%0*d", S_FM(n->suffix) ? 0 : 2, tm->tm_mday);
                 securec_check_ss(rc, "\0", "\0");
                 if (S_THth(n->suffix))
@@ -3641,13 +3683,14 @@ static void DCH_to_char(FormatNode* node, bool is_interval, TmToChar* in, char*
                 break;
             case DCH_YYYY:
             case DCH_IYYY:
-                rc = sprintf_s(s,
-                    len,
-                    "%0*d",
-                    S_FM(n->suffix) ? 0 : 4,
-                    ((n->key->id == DCH_YYYY)
-                            ? ADJUST_YEAR(tm->tm_year, is_interval)
-                            : ADJUST_YEAR(date2isoyear(tm->tm_year, tm->tm_mon, tm->tm_mday), is_interval)));
+                i = (n->key->id == DCH_YYYY)
+                        ? ADJUST_YEAR(tm->tm_year, is_interval)
+                        : ADJUST_YEAR(date2isoyear(tm->tm_year, tm->tm_mon, tm->tm_mday), is_interval);
+                if (DCH_to_char_fixed_digits(s, len, i, 4, n)) {
+                    s += 4;
+                    break;
+                }
+                rc = sprintf_s(s, len, "%0*d", S_FM(n->suffix) ? 0 : 4, i);
                 securec_check_ss(rc, "\0", "\0");
                 if (S_THth(n->suffix))
                     str_numth(s, s, S_TH_TYPE(n->suffix));
@@ -28,6 +28,7 @@
 #include "parser/parse_coerce.h"
 #include "utils/array.h"
 #include "utils/builtins.h"
+#include "utils/bytescan.h"
 #include "utils/lsyscache.h"
 #include "utils/json.h"
 #include "utils/jsonapi.h"
@@ -616,17 +617,38 @@ static inline void json_lex_string(JsonLexContext *lex)
     char *s = NULL;
     int len;
     int hi_surrogate = -1;
+    ByteScanSet plainSet;
 
     if (lex->strval != NULL) {
         resetStringInfo(lex->strval);
     }
 
+    /*
+     * Runs of bytes that need no special treatment are skipped (or copied)
+     * in one go.  In multibyte encodings other than UTF8 a trailing byte
+     * may look like a backslash or a quote, so stop at every non-ASCII
+     * byte there and leave it to the per-character code below.
+     */
+    ByteScanSetInit(&plainSet, "\"\\", 2,
+        GetDatabaseEncoding() != PG_UTF8 && pg_database_encoding_max_length() > 1, true);
+
     Assert(lex->input_length > 0);
     s = lex->token_start;
     len = lex->token_start - lex->input;
     for (;;) {
         s++;
         len++;
+        if (hi_surrogate == -1 && len < lex->input_length) {
+            int plain = ByteScanPlain(&plainSet, s, lex->input_length - len);
+
+            if (plain > 0) {
+                if (lex->strval != NULL) {
+                    appendBinaryStringInfo(lex->strval, s, plain);
+                }
+                s += plain;
+                len += plain;
+            }
+        }
         /* Premature end of the string. */
         if (len >= lex->input_length) {
             lex->token_terminator = s;
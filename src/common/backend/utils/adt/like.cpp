@@ -116,6 +116,7 @@ static char SB_lower_char(unsigned char c, pg_locale_t locale, bool locale_is_c)
 #define CHAREQ(p1, p2) (*(p1) == *(p2))
 #define NextChar(p, plen) NextByte((p), (plen))
 #define CopyAdvChar(dst, src, srclen) (*(dst)++ = *(src)++, (srclen)--)
+#define MATCH_MEMCHR
 
 #define MatchText SB_MatchText
 #define do_like_escape SB_do_like_escape
@@ -138,6 +139,7 @@ static char SB_lower_char(unsigned char c, pg_locale_t locale, bool locale_is_c)
         (plen)--;         \
     } while ((plen) > 0 && (*(p)&0xC0) == 0x80)
 #define CHAREQ(p1, p2) wchareq((p1), (p2))
+#define MATCH_MEMCHR
 #define MatchText UTF8_MatchText
 
 #include "like_match.cpp"
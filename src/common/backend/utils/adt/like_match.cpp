@@ -15,6 +15,9 @@
  * MatchText - to name of function wanted
  * do_like_escape - name of function if wanted - needs CHAREQ and CopyAdvChar
  * MATCH_LOWER - define for case (4) to specify case folding for 1-byte chars
+ * MATCH_MEMCHR - define if a byte equal to the first byte of a character can
+ *		only occur at a character boundary, so that candidate positions after a
+ *		% can be found with memchr()
  *
  * Copyright (c) 1996-2012, PostgreSQL Global Development Group
  *
@@ -158,6 +161,23 @@ static int MatchText(char* t, int tlen, char* p, int plen, pg_locale_t locale, b
             } else
                 firstpat = GETCHAR(*p);
 
+#ifdef MATCH_MEMCHR
+            while (tlen > 0) {
+                char* next = (char*)memchr(t, firstpat, tlen);
+                int matched;
+
+                if (next == NULL)
+                    break;
+                tlen -= next - t;
+                t = next;
+
+                matched = MatchText(t, tlen, p, plen, locale, locale_is_c);
+                if (matched != LIKE_FALSE)
+                    return matched; /* TRUE or ABORT */
+
+                NextChar(t, tlen);
+            }
+#else
             while (tlen > 0) {
                 if (GETCHAR(*t) == firstpat) {
                     int matched = MatchText(t, tlen, p, plen, locale, locale_is_c);
@@ -168,6 +188,7 @@ static int MatchText(char* t, int tlen, char* p, int plen, pg_locale_t locale, b
 
                 NextChar(t, tlen);
             }
+#endif
 
             /*
              * End of text with no match, so no point in trying later places
@@ -323,6 +344,10 @@ static text* do_like_escape(text* pat, text* esc)
 
 #undef GETCHAR
 
+#ifdef MATCH_MEMCHR
+#undef MATCH_MEMCHR
+#endif
+
 #ifdef MATCH_LOWER
 #undef MATCH_LOWER
 
@@ -151,6 +151,102 @@ static int datum_float8_cmp(const void* arg1, const void* arg2)
 
 static const double HALF_FACTOR = 0.5;
 
+/* Ranges this small are just sorted by median_select_datum */
+#define MEDIAN_SELECT_SMALL_RANGE 16
+
+static inline void swap_datum(Datum* values, int64 i, int64 j)
+{
+    Datum tmp = values[i];
+    values[i] = values[j];
+    values[j] = tmp;
+}
+
+/*
+ * Reorder values[0 .. nelems) so that values[k] is the element a full sort
+ * would put there, everything before it is not greater and everything after
+ * it is not smaller.  This is quickselect with a median-of-three pivot, which
+ * falls back to qsort on the remaining range once it has partitioned more
+ * often than a balanced run would need, so the worst case stays O(n log n).
+ */
+static void median_select_datum(Datum* values, uint32 nelems, uint32 k, int (*cmp)(const void*, const void*))
+{
+    int64 lo = 0;
+    int64 hi = (int64)nelems - 1;
+    int depthLimit = 0;
+
+    for (uint32 n = nelems; n > 0; n >>= 1) {
+        depthLimit += 2;
+    }
+
+    while (hi > lo) {
+        if (hi - lo < MEDIAN_SELECT_SMALL_RANGE || depthLimit-- == 0) {
+            qsort(values + lo, (size_t)(hi - lo + 1), sizeof(Datum), cmp);
+            return;
+        }
+
+        int64 mid = lo + (hi - lo) / 2;
+        if (cmp(&values[mid], &values[lo]) < 0) {
+            swap_datum(values, mid, lo);
+        }
+        if (cmp(&values[hi], &values[lo]) < 0) {
+            swap_datum(values, hi, lo);
+        }
+        if (cmp(&values[hi], &values[mid]) < 0) {
+            swap_datum(values, hi, mid);
+        }
+
+        Datum pivot = values[mid];
+        int64 i = lo;
+        int64 j = hi;
+        while (i <= j) {
+            while (cmp(&values[i], &pivot) < 0) {
+                i++;
+            }
+            while (cmp(&values[j], &pivot) > 0) {
+                j--;
+            }
+            if (i <= j) {
+                swap_datum(values, i, j);
+                i++;
+                j--;
+            }
+        }
+
+        /* values[lo .. j] <= pivot <= values[i .. hi], anything in between equals pivot */
+        if ((int64)k <= j) {
+            hi = j;
+        } else if ((int64)k >= i) {
+            lo = i;
+        } else {
+            return;
+        }
+    }
+}
+
+/*
+ * Find the middle element(s) of the accumulated values without sorting all
+ * of them.  On return values[nelems / 2] is the upper median, and for an even
+ * count *lower is set to the lower one.
+ */
+static void median_find_middle(MedianBuildState* mstate, int (*cmp)(const void*, const void*), Datum* lower)
+{
+    uint32 mid = mstate->nelems / 2;
+    Datum* values = mstate->dvalues;
+
+    median_select_datum(values, mstate->nelems, mid, cmp);
+
+    if (mstate->nelems % 2 == 0) {
+        /* the lower median is the largest of the elements before the upper one */
+        uint32 best = 0;
+        for (uint32 i = 1; i < mid; i++) {
+            if (cmp(&values[i], &values[best]) > 0) {
+                best = i;
+            }
+        }
+        *lower = values[best];
+    }
+}
+
 /*
  * the final function for median(float8)
  */
@@ -178,14 +274,15 @@ Datum median_float8_finalfn(PG_FUNCTION_ARGS)
     Assert(mstate->dtype == FLOAT8OID);
     Assert(mstate->typlen == sizeof(float8));
 
-    /* sort all elements and find the median */
-    qsort(mstate->dvalues, mstate->nelems, sizeof(Datum), datum_float8_cmp);
+    /* find the median */
+    Datum lower = (Datum)0;
+    median_find_middle(mstate, datum_float8_cmp, &lower);
 
     uint32 i = mstate->nelems / 2;
     if (mstate->nelems % 2 == 1) {
         result = mstate->dvalues[i];
     } else {
-        double low = DatumGetFloat8(mstate->dvalues[i - 1]);
+        double low = DatumGetFloat8(lower);
         double high = DatumGetFloat8(mstate->dvalues[i]);
         result = Float8GetDatum(low + (high - low) * HALF_FACTOR);
     }
@@ -231,15 +328,16 @@ Datum median_interval_finalfn(PG_FUNCTION_ARGS)
     Assert(mstate->typlen == sizeof(Interval));
     Assert(!mstate->typbyval);  /* INTERVAL is passed by reference */
 
-    /* sort all elements and find the median */
-    qsort(mstate->dvalues, mstate->nelems, sizeof(Datum), datum_interval_cmp);
+    /* find the median */
+    Datum lower = (Datum)0;
+    median_find_middle(mstate, datum_interval_cmp, &lower);
 
     Datum result;
     uint32 i = mstate->nelems / 2;
     if (mstate->nelems % 2 == 1) {
         result = mstate->dvalues[i];
     } else {
-        Datum low = mstate->dvalues[i - 1];
+        Datum low = lower;
         Datum high = mstate->dvalues[i];
 
         /* compute the result by LOW + (HIGH - LOW) * 0.5 */
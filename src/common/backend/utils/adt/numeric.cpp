@@ -7208,6 +7208,10 @@ ScalarVector* vnumeric_sum(PG_FUNCTION_ARGS)
                 num2Flags = NUMERIC_NB_FLAGBITS(rightarg);
 
                 if (likely(NUMERIC_FLAG_IS_BI(num1Flags) && NUMERIC_FLAG_IS_BI(num2Flags))) {
+                    /* same scale, add in place */
+                    if (likely(BiAggAddSameScale(leftarg, rightarg))) {
+                        continue;
+                    }
                     arg1 = NUMERIC_FLAG_IS_BI128(num1Flags);
                     arg2 = NUMERIC_FLAG_IS_BI128(num2Flags);
                     ctl.store_pos = cell->m_val[idx].val;
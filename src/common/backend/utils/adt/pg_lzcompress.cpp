@@ -40,6 +40,14 @@
  *					The data is written to buff exactly as it was handed
  *					to pglz_compress(). No terminating zero byte is added.
  *
+ *			int32
+ *			pglz_decompress_prefix(const PGLZ_Header *source, char *dest,
+ *							int32 rawsize)
+ *
+ *				Like pglz_decompress(), but stops as soon as the first
+ *					rawsize bytes of the original data have been produced.
+ *					dest needs room for rawsize bytes only.
+ *
  *		The decompression algorithm and internal data format:
  *
  *			PGLZ_Header is defined as
@@ -577,12 +585,13 @@ bool pglz_compress(const char* source, int32 slen, PGLZ_Header* dest, const PGLZ
 }
 
 /* ----------
- * pglz_decompress -
+ * pglz_decompress_internal -
  *
- *		Decompresses source into dest.
+ *		Decompresses the first rawsize bytes of source into dest.  With
+ *		check_complete, the whole input must be consumed exactly.
  * ----------
  */
-int32 pglz_decompress(const PGLZ_Header* source, char* dest)
+static int32 pglz_decompress_internal(const PGLZ_Header* source, char* dest, int32 rawsize, bool check_complete)
 {
     const unsigned char* sp = NULL;
     const unsigned char* srcend = NULL;
@@ -592,7 +601,7 @@ int32 pglz_decompress(const PGLZ_Header* source, char* dest)
     sp = ((const unsigned char*)source) + sizeof(PGLZ_Header);
     srcend = ((const unsigned char*)source) + VARSIZE(source);
     dp = (unsigned char*)dest;
-    destend = dp + source->rawsize;
+    destend = dp + rawsize;
 
     while (sp < srcend && dp < destend) {
         /*
@@ -628,8 +637,12 @@ int32 pglz_decompress(const PGLZ_Header* source, char* dest)
                  * probably interfere with optimization.
                  */
                 if (dp + len > destend) {
-                    dp += len;
-                    break;
+                    if (check_complete) {
+                        dp += len;
+                        break;
+                    }
+                    /* only a prefix is wanted, the match crosses its end */
+                    len = (int32)(destend - dp);
                 }
 
                 /*
@@ -664,7 +677,7 @@ int32 pglz_decompress(const PGLZ_Header* source, char* dest)
     /*
      * Check we decompressed the right amount.
      */
-    if (dp != destend || sp != srcend) {
+    if (dp != destend || (check_complete && sp != srcend)) {
 #ifndef FRONTEND
         ereport(ERROR, (errcode(ERRCODE_DATA_CORRUPTED), errmsg("compressed data is corrupt")));
 #else
@@ -675,5 +688,28 @@ int32 pglz_decompress(const PGLZ_Header* source, char* dest)
     /*
      * That's it.
      */
-    return source->rawsize;
+    return rawsize;
+}
+
+/* ----------
+ * pglz_decompress -
+ *
+ *		Decompresses source into dest.
+ * ----------
+ */
+int32 pglz_decompress(const PGLZ_Header* source, char* dest)
+{
+    return pglz_decompress_internal(source, dest, source->rawsize, true);
+}
+
+/* ----------
+ * pglz_decompress_prefix -
+ *
+ *		Decompresses the first rawsize bytes of source into dest.
+ * ----------
+ */
+int32 pglz_decompress_prefix(const PGLZ_Header* source, char* dest, int32 rawsize)
+{
+    Assert(rawsize >= 0 && rawsize <= source->rawsize);
+    return pglz_decompress_internal(source, dest, rawsize, rawsize == source->rawsize);
 }
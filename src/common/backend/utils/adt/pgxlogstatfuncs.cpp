@@ -267,6 +267,14 @@ static void ClearWalwriterFlushStat(TupleDesc *tupleDesc, Tuplestorestate *tupst
     g_instance.wal_cxt.xlogFlushStats->avgWriteTime = 0;
     g_instance.wal_cxt.xlogFlushStats->avgSyncTime = 0;
     g_instance.wal_cxt.xlogFlushStats->currOpenXlogSegNo = 0;
+    errno_t rc = memset_s(g_instance.wal_cxt.xlogFlushStats->batchSizeHist,
+        sizeof(g_instance.wal_cxt.xlogFlushStats->batchSizeHist), 0,
+        sizeof(g_instance.wal_cxt.xlogFlushStats->batchSizeHist));
+    securec_check(rc, "\0", "\0");
+    rc = memset_s(g_instance.wal_cxt.xlogFlushStats->waitTimeHist,
+        sizeof(g_instance.wal_cxt.xlogFlushStats->waitTimeHist), 0,
+        sizeof(g_instance.wal_cxt.xlogFlushStats->waitTimeHist));
+    securec_check(rc, "\0", "\0");
     g_instance.wal_cxt.xlogFlushStats->lastRestTime = GetCurrentTimestamp();
 
     GetWalwriterFlushStat(tupleDesc, tupstore);
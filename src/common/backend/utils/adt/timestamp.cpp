@@ -2082,6 +2082,7 @@ Datum timestamp_cmp(PG_FUNCTION_ARGS)
     PG_RETURN_INT32(timestamp_cmp_internal(dt1, dt2));
 }
 
+#ifndef HAVE_INT64_TIMESTAMP
 /* note: this is used for timestamptz also */
 static int timestamp_fastcmp(Datum x, Datum y, SortSupport ssup)
 {
@@ -2090,12 +2091,18 @@ static int timestamp_fastcmp(Datum x, Datum y, SortSupport ssup)
 
     return timestamp_cmp_internal(a, b);
 }
+#endif
 
 Datum timestamp_sortsupport(PG_FUNCTION_ARGS)
 {
     SortSupport ssup = (SortSupport)PG_GETARG_POINTER(0);
 
+#ifdef HAVE_INT64_TIMESTAMP
+    /* integer timestamps order exactly like int8, for timestamptz too */
+    ssup->comparator = ssup_datum_int64_cmp;
+#else
     ssup->comparator = timestamp_fastcmp;
+#endif
     PG_RETURN_VOID();
 }
 
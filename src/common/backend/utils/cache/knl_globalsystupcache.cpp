@@ -130,6 +130,78 @@
 #include "utils/knl_globaltabdefcache.h"
 #include "utils/sec_rls_utils.h"
 
+/*
+ * Every lookup in every thread bumps tup_searches (and tup_hits) of the same
+ * GlobalSysCacheStat, which makes those two cache lines bounce between all
+ * cores.  Count them per thread and publish them every GSC_TUP_STAT_BATCH
+ * searches instead.  One slot serves the shared catalogs and one the current
+ * database, since lookups keep alternating between the two.
+ *
+ * The counters live in database entries this thread holds a reference on, so
+ * FlushGlobalSysTupCacheStat() must run before those references are released.
+ */
+#define GSC_TUP_STAT_BATCH 64
+#define GSC_TUP_STAT_SLOTS 2
+
+typedef struct GSCTupStatBatch {
+    volatile uint64 *searches;
+    volatile uint64 *hits;
+    uint64 nsearches;
+    uint64 nhits;
+} GSCTupStatBatch;
+
+static THR_LOCAL GSCTupStatBatch gsc_tup_stat[GSC_TUP_STAT_SLOTS];
+
+static void FlushGSCTupStatSlot(GSCTupStatBatch *slot)
+{
+    if (slot->nsearches > 0) {
+        pg_atomic_fetch_add_u64(slot->searches, slot->nsearches);
+    }
+    if (slot->nhits > 0) {
+        pg_atomic_fetch_add_u64(slot->hits, slot->nhits);
+    }
+    slot->searches = NULL;
+    slot->hits = NULL;
+    slot->nsearches = 0;
+    slot->nhits = 0;
+}
+
+void FlushGlobalSysTupCacheStat()
+{
+    for (int i = 0; i < GSC_TUP_STAT_SLOTS; i++) {
+        FlushGSCTupStatSlot(&gsc_tup_stat[i]);
+    }
+}
+
+static inline void CountGSCTupSearch(volatile uint64 *searches, volatile uint64 *hits, bool hit)
+{
+    GSCTupStatBatch *slot = &gsc_tup_stat[0];
+
+    if (unlikely(slot->searches != searches)) {
+        if (gsc_tup_stat[1].searches == searches) {
+            slot = &gsc_tup_stat[1];
+        } else {
+            if (slot->searches != NULL) {
+                slot = &gsc_tup_stat[1];
+                FlushGSCTupStatSlot(slot);
+            }
+            slot->searches = searches;
+            slot->hits = hits;
+        }
+    }
+
+    slot->nsearches++;
+    if (hit) {
+        slot->nhits++;
+    }
+    if (slot->nsearches >= GSC_TUP_STAT_BATCH) {
+        pg_atomic_fetch_add_u64(slot->searches, slot->nsearches);
+        pg_atomic_fetch_add_u64(slot->hits, slot->nhits);
+        slot->nsearches = 0;
+        slot->nhits = 0;
+    }
+}
+
 void GlobalCatCTup::Release()
 {
     /* Decrement the reference count of a GlobalCatCache tuple */
@@ -838,7 +910,6 @@ GlobalCatCTup *GlobalSysTupCache::SearchTupleMiss(InsertCatTupInfo *tup_info)
 GlobalCatCTup *GlobalSysTupCache::SearchTupleInternal(uint32 hash_value, Datum *arguments)
 {
     FreeDeadCts();
-    pg_atomic_fetch_add_u64(m_searches, 1);
     /*
      * scan the hash bucket until we find a match or exhaust our tuples
      */
@@ -855,10 +926,11 @@ GlobalCatCTup *GlobalSysTupCache::SearchTupleInternal(uint32 hash_value, Datum *
     PthreadRWlockUnlock(LOCAL_SYSDB_RESOWNER, bucket_lock);
 
     if (ct != NULL) {
-        pg_atomic_fetch_add_u64(m_hits, 1);
+        CountGSCTupSearch(m_searches, m_hits, true);
         TopnLruMoveToFront(&ct->cache_elem, GetBucket(hash_index), bucket_lock, location);
         return ct;
     }
+    CountGSCTupSearch(m_searches, m_hits, false);
 
     /* not match */
     tup_info.find_type = SCAN_TUPLE_SKIP;
@@ -1694,7 +1766,6 @@ List *GlobalSysTupCache::GetGlobalCatCTupStat()
 GlobalCatCTup *GlobalSysTupCache::SearchTupleWithArgModes(uint32 hash_value, Datum *arguments, oidvector* argModes)
 {
     FreeDeadCts();
-    pg_atomic_fetch_add_u64(m_searches, 1);
     /*
      * scan the hash bucket until we find a match or exhaust our tuples
      */
@@ -1740,10 +1811,11 @@ GlobalCatCTup *GlobalSysTupCache::SearchTupleWithArgModes(uint32 hash_value, Dat
     PthreadRWlockUnlock(LOCAL_SYSDB_RESOWNER, bucket_lock);
 
     if (ct != NULL) {
-        pg_atomic_fetch_add_u64(m_hits, 1);
+        CountGSCTupSearch(m_searches, m_hits, true);
         TopnLruMoveToFront(&ct->cache_elem, GetBucket(hash_index), bucket_lock, location);
         return ct;
     }
+    CountGSCTupSearch(m_searches, m_hits, false);
 
     /* not match */
     tup_info.find_type = SCAN_TUPLE_SKIP;
@@ -345,6 +345,7 @@ PartitionMap *CopyPartitionMap(PartitionMap *oldmap)
             errno_t rc = memcpy_s(dst_lpm->partitionKeyDataType, key_len, src_lpm->partitionKeyDataType, key_len);
             securec_check(rc, "", "");
             dst_lpm->listElements = CopyListElements(src_lpm->listElements, src_lpm->listElementsNum);
+            BuildListPartitionValueIndex(dst_lpm);
             return (PartitionMap *)dst_lpm;
         }
         case PART_TYPE_HASH: {
@@ -471,6 +471,8 @@ void LocalSysDBCache::LocalSysDBCacheReleaseCritialReSource(bool include_shared)
     LocalSysDBCacheReleaseGlobalReSource(false);
     ReleaseBadPtrList(false);
 
+    /* batched lookup counters point into the entries released below */
+    FlushGlobalSysTupCacheStat();
     systabcache.ReleaseGlobalRefcount(include_shared);
     if (m_global_db != NULL) {
         m_global_db->Release();
@@ -59,7 +59,7 @@ bool open_join_children = true;
 bool will_shutdown = false;
 
 /* hard-wired binary version number */
-const uint32 GRAND_VERSION_NUM = 92780;
+const uint32 GRAND_VERSION_NUM = 92781;
 
 const uint32 DOLPHIN_ENABLE_DROP_NUM = 92780;
 const uint32 SQL_PATCH_VERSION_NUM = 92625;
@@ -115,6 +115,7 @@ const uint32 SWITCH_ROLE_VERSION_NUM = 92618;
 const uint32 PLAN_SELECT_VERSION_NUM = 92776;
 const uint32 REPLACE_INTO_VERSION_NUM = 92778;
 const uint32 PG_AUTHID_PASSWORDEXT_VERSION_NUM = 92780;
+const uint32 AGG_UPPER_COMBINE_VERSION_NUM = 92781;
 
 
 /* Version number of the guc parameter backend_version added in V500R001C20 */
@@ -1278,6 +1278,17 @@ static void InitConfigureNamesBool()
             NULL,
             NULL,
             NULL},
+        {{"session_latency_critical",
+            PGC_USERSET,
+            NODE_ALL,
+            CLIENT_CONN_OTHER,
+            gettext_noop("Serves the session ahead of other sessions waiting for a thread pool worker."),
+            NULL},
+            &u_sess->attr.attr_common.session_latency_critical,
+            false,
+            NULL,
+            NULL,
+            NULL},
         {{"log_parser_stats",
             PGC_SUSET,
             NODE_ALL,
@@ -2555,6 +2566,36 @@ static void InitConfigureNamesInt()
             NULL,
             NULL,
             NULL},
+
+        {{"thread_pool_steal_threshold",
+            PGC_POSTMASTER,
+            NODE_ALL,
+            CLIENT_CONN,
+            gettext_noop("Sets how many sessions must wait in another thread pool group before "
+                         "an idle worker takes one of them. 0 disables it."),
+            NULL},
+            &g_instance.attr.attr_common.thread_pool_steal_threshold,
+            0,
+            0,
+            INT_MAX,
+            NULL,
+            NULL,
+            NULL},
+
+        {{"thread_pool_latency_weight",
+            PGC_POSTMASTER,
+            NODE_ALL,
+            CLIENT_CONN,
+            gettext_noop("Sets how many latency-critical sessions a thread pool group serves "
+                         "for each other waiting session."),
+            NULL},
+            &g_instance.attr.attr_common.thread_pool_latency_weight,
+            4,
+            1,
+            INT_MAX,
+            NULL,
+            NULL,
+            NULL},
         {{"datanode_heartbeat_interval",
             PGC_SIGHUP,
             NODE_ALL,
@@ -796,6 +796,17 @@ static void InitSqlConfigureNamesBool()
             NULL,
             NULL,
             NULL},
+        {{"enable_memoize",
+            PGC_USERSET,
+            NODE_ALL,
+            QUERY_TUNING_METHOD,
+            gettext_noop("Enables caching of parameterized inner index scan results in nested-loop joins."),
+            NULL},
+            &u_sess->attr.attr_sql.enable_memoize,
+            false,
+            NULL,
+            NULL,
+            NULL},
         {{"enable_nodegroup_debug",
             PGC_USERSET,
             NODE_DISTRIBUTE,
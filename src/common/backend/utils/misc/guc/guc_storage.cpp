@@ -262,6 +262,19 @@ static const struct config_enum_entry remote_read_options[] = {
     {NULL, 0, false}
 };
 
+static const struct config_enum_entry buffer_replacement_policy_options[] = {
+    {"clock", BUFFER_POLICY_CLOCK, false},
+    {"2q", BUFFER_POLICY_2Q, false},
+    {NULL, 0, false}
+};
+
+static const struct config_enum_entry wal_fpi_compression_options[] = {
+    {"off", WAL_FPI_COMPRESSION_OFF, false},
+    {"lz4", WAL_FPI_COMPRESSION_LZ4, false},
+    {"zstd", WAL_FPI_COMPRESSION_ZSTD, false},
+    {NULL, 0, false}
+};
+
 static const struct config_enum_entry repl_auth_mode_options[] = {
     {"default", REPL_AUTH_DEFAULT, false},
     {"off", REPL_AUTH_DEFAULT, false},
@@ -374,6 +387,18 @@ static void InitStorageConfigureNamesBool()
             NULL,
             NULL,
             NULL},
+        {{"enable_huge_pages",
+            PGC_POSTMASTER,
+            NODE_ALL,
+            RESOURCES_MEM,
+            gettext_noop("Tries to back the main shared memory segment with huge pages."),
+            NULL,
+            GUC_NOT_IN_SAMPLE},
+            &g_instance.attr.attr_storage.enable_huge_pages,
+            false,
+            NULL,
+            NULL,
+            NULL},
         {{"enable_incremental_catchup",
             PGC_SIGHUP,
             NODE_ALL,
@@ -615,6 +640,31 @@ static void InitStorageConfigureNamesBool()
             NULL,
             NULL},
 
+        {{"enable_redo_prefetch",
+            PGC_SIGHUP,
+            NODE_ALL,
+            RESOURCES_RECOVERY,
+            gettext_noop("Prefetches data blocks referenced by WAL records before they are redone."),
+            NULL,
+            GUC_NOT_IN_SAMPLE},
+            &g_instance.attr.attr_storage.enable_redo_prefetch,
+            true,
+            NULL,
+            NULL,
+            NULL},
+        {{"wal_flush_adaptive",
+            PGC_SIGHUP,
+            NODE_ALL,
+            WAL_SETTINGS,
+            gettext_noop("Lets the walwriter size its flush window from commit arrival rate and flush latency."),
+            NULL,
+            GUC_NOT_IN_SAMPLE},
+            &g_instance.attr.attr_storage.wal_flush_adaptive,
+            false,
+            NULL,
+            NULL,
+            NULL},
+
         {{"enable_wal_shipping_compression",
             PGC_SIGHUP,
             NODE_ALL,
@@ -4199,6 +4249,31 @@ static void InitStorageConfigureNamesEnum()
             NULL,
             NULL,
             NULL},
+        {{"buffer_replacement_policy",
+            PGC_POSTMASTER,
+            NODE_ALL,
+            RESOURCES_MEM,
+            gettext_noop("Sets the replacement policy of the shared buffer pool."),
+            gettext_noop("clock evicts any unpinned buffer, 2q keeps pages that are re-referenced "
+                         "resident and evicts pages touched only once first.")},
+            &g_instance.attr.attr_storage.buffer_replacement_policy,
+            BUFFER_POLICY_CLOCK,
+            buffer_replacement_policy_options,
+            NULL,
+            NULL,
+            NULL},
+        {{"wal_fpi_compression",
+            PGC_SIGHUP,
+            NODE_ALL,
+            WAL_SETTINGS,
+            gettext_noop("Compresses full-page images written to WAL with the given method."),
+            gettext_noop("Standbys and WAL tools must understand compressed images before this is enabled.")},
+            &g_instance.attr.attr_storage.wal_fpi_compression,
+            WAL_FPI_COMPRESSION_OFF,
+            wal_fpi_compression_options,
+            NULL,
+            NULL,
+            NULL},
         {{"repl_auth_mode",
             PGC_SIGHUP,
             NODE_ALL,
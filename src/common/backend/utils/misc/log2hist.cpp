@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * -------------------------------------------------------------------------
+ *
+ * log2hist.cpp
+ *	  Power-of-two bucketed histograms for background thread statistics.
+ *
+ * IDENTIFICATION
+ *	  src/common/backend/utils/misc/log2hist.cpp
+ *
+ * -------------------------------------------------------------------------
+ */
+#include "postgres.h"
+#include "knl/knl_variable.h"
+
+#include "utils/log2hist.h"
+
+/*
+ * Count value in the bucket of its bit length, so bucket i holds values
+ * below 2^i and the last bucket everything that doesn't fit below.
+ */
+void Log2HistAdd(uint64* hist, int nbuckets, uint64 value)
+{
+    int bucket = 0;
+    while (value > 0 && bucket < nbuckets - 1) {
+        value >>= 1;
+        bucket++;
+    }
+    hist[bucket]++;
+}
+
+/*
+ * Report the non-empty buckets of hist after prefix, each as " <2^i:count"
+ * and the last one as " >=2^(nbuckets-2):count".  Callers may run without a
+ * memory context of their own, so format on the stack.
+ */
+void Log2HistReport(int elevel, const uint64* hist, int nbuckets, const char* prefix)
+{
+    char buf[LOG2HIST_MAX_BUCKETS * 48] = {0};
+    int len = 0;
+
+    Assert(nbuckets > 1 && nbuckets <= LOG2HIST_MAX_BUCKETS);
+    for (int i = 0; i < nbuckets; i++) {
+        if (hist[i] == 0) {
+            continue;
+        }
+        int rc = snprintf_s(buf + len, sizeof(buf) - len, sizeof(buf) - len - 1, " %s%lu:%lu",
+            (i == nbuckets - 1) ? ">=" : "<", (i == nbuckets - 1) ? (1UL << (i - 1)) : (1UL << i), hist[i]);
+        securec_check_ss(rc, "\0", "\0");
+        len += rc;
+    }
+    ereport(elevel, (errmsg("%s:%s", prefix, len > 0 ? buf : " none")));
+}
@@ -33,6 +33,7 @@
 #include "utils/resowner.h"
 #include "nodes/execnodes.h"
 #include "opfusion/opfusion.h"
+#include "optimizer/gplanmgr.h"
 
 #ifdef PGXC
 #include "pgxc/pgxc.h"
@@ -338,6 +339,10 @@ void PortalDefineQuery(Portal portal, const char* prepStmtName, const char* sour
     portal->cplan = cplan;
     if (cplan) {
         pg_atomic_fetch_add_u32((volatile uint32*)&cplan->global_refcount, 1);
+        if (cplan == u_sess->pcache_cxt.matched_plan) {
+            portal->plan_region = u_sess->pcache_cxt.matched_region;
+            u_sess->pcache_cxt.matched_plan = NULL;
+        }
     }
     portal->status = PORTAL_DEFINED;
 }
@@ -349,6 +354,12 @@ void PortalDefineQuery(Portal portal, const char* prepStmtName, const char* sour
 static void PortalReleaseCachedPlan(Portal portal)
 {
     if (portal->cplan) {
+        /* let the adaptive plan selection learn how this candidate did */
+        if (portal->cplan->cpi != NULL && portal->status != PORTAL_FAILED &&
+            !(portal->cursorOptions & CURSOR_OPT_HOLD)) {
+            PMGR_RecordPlanExecution(portal->cplan, portal->plan_region, portal->exec_usecs);
+        }
+
         if (!portal->cplan->isShared()) {
             Assert(portal->cplan->global_refcount > 0);
             pg_atomic_fetch_sub_u32((volatile uint32*)&portal->cplan->global_refcount, 1);
@@ -43,6 +43,7 @@
 #include "utils/batchsort.h"
 #include "utils/numeric.h"
 #include "utils/numeric_gs.h"
+#include "utils/radixsort.h"
 #include "access/tuptoaster.h"
 
 typedef int (*LLVM_CMC_func)(const MultiColumns* a, const MultiColumns* b, Batchsortstate* state);
@@ -783,9 +784,97 @@ bool Batchsortstate::ConsiderAbortCommon()
     return false;
 }
 
+/*
+ * Key extraction and fallback sort used by Batchsortstate::RadixSortInMem.
+ */
+struct BatchsortRadixKey {
+    int colIdx;
+    int width;
+    bool reverse;
+
+    uint64 operator()(const MultiColumns& row) const
+    {
+        if (width == sizeof(int32)) {
+            return RadixSortNormalizeInt32(DatumGetInt32(row.m_values[colIdx]), reverse);
+        }
+        return RadixSortNormalizeInt64(DatumGetInt64(row.m_values[colIdx]), reverse);
+    }
+};
+
+struct BatchsortRadixFallback {
+    Batchsortstate* state;
+
+    void operator()(MultiColumns* rows, size_t n, bool keysEqual) const
+    {
+        /* a single-key sort has nothing to break ties on */
+        if (keysEqual && state->m_nKeys == 1) {
+            return;
+        }
+        qsort_arg(rows, n, sizeof(MultiColumns), (qsort_arg_comparator)state->compareMultiColumn, (void*)state);
+    }
+};
+
+/*
+ * Sort the in-memory rows with a radix sort on the first sort column when
+ * it is a plain fixed-width integer, see utils/radixsort.h.  Ties on that
+ * column, and NULLs, are ordered by compareMultiColumn.  Returns false if
+ * the fast path does not apply, leaving the rows untouched.
+ */
+bool Batchsortstate::RadixSortInMem()
+{
+    MultiColumns* rows = m_storeColumns.m_memValues;
+    size_t nrows = (size_t)m_storeColumns.m_memRowNum;
+    size_t nfront = 0;
+    BatchsortRadixKey keyFn;
+    BatchsortRadixFallback fallbackFn;
+
+    if (m_storeColumns.m_memRowNum < RADIX_SORT_MIN_ELEMS || sortKeys == NULL) {
+        return false;
+    }
+
+    keyFn.width = SortSupportRadixKeyWidth(sortKeys);
+    if (keyFn.width == 0) {
+        return false;
+    }
+    keyFn.colIdx = sortKeys->ssup_attno - 1;
+    keyFn.reverse = sortKeys->ssup_reverse;
+    fallbackFn.state = this;
+
+    /*
+     * Move the NULLs to the end they sort to: the first nfront rows become
+     * the NULLs when they sort first, and the non-NULLs otherwise.
+     */
+    bool nullsFirst = sortKeys->ssup_nulls_first;
+    for (size_t i = 0; i < nrows; i++) {
+        if (IS_NULL(rows[i].m_nulls[keyFn.colIdx]) == nullsFirst) {
+            MultiColumns tmp = rows[i];
+
+            rows[i] = rows[nfront];
+            rows[nfront++] = tmp;
+        }
+    }
+
+    MultiColumns* nonNulls = nullsFirst ? rows + nfront : rows;
+    size_t nonNullCount = nullsFirst ? nrows - nfront : nfront;
+    MultiColumns* nulls = nullsFirst ? rows : rows + nfront;
+    size_t nullCount = nrows - nonNullCount;
+
+    if (nonNullCount > 1) {
+        RadixSortElems(nonNulls, nonNullCount, 0, keyFn.width, keyFn, fallbackFn);
+    }
+    if (nullCount > 1) {
+        fallbackFn(nulls, nullCount, true);
+    }
+
+    return true;
+}
+
 void Batchsortstate::SortInMem()
 {
     if (m_storeColumns.m_memRowNum > 1) {
+        if (RadixSortInMem()) {
+            return;
+        }
         qsort_arg(m_storeColumns.m_memValues,
             m_storeColumns.m_memRowNum,
             sizeof(MultiColumns),
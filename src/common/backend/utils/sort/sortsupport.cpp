@@ -17,8 +17,11 @@
 #include "knl/knl_variable.h"
 
 #include "fmgr.h"
+#include "utils/builtins.h"
+#include "utils/date.h"
 #include "utils/lsyscache.h"
 #include "utils/sortsupport.h"
+#include "utils/timestamp.h"
 
 /* Info needed to use an old-style comparison function as a sort comparator */
 typedef struct SortShimExtra {
@@ -140,3 +143,75 @@ void PrepareSortSupportFromOrderingOp(Oid orderingOp, SortSupport ssup)
         PrepareSortSupportComparisonShim(sortFunction, ssup);
     }
 }
+
+/*
+ * Fast comparators shared by the fixed-width integer-like opclasses.  Sort
+ * code recognizes these by address to know that the leading key can be
+ * ordered by its integer value alone, see SortSupportRadixKeyWidth().
+ */
+int ssup_datum_int32_cmp(Datum x, Datum y, SortSupport ssup)
+{
+    int32 a = DatumGetInt32(x);
+    int32 b = DatumGetInt32(y);
+
+    if (a > b)
+        return 1;
+    else if (a == b)
+        return 0;
+    else
+        return -1;
+}
+
+int ssup_datum_int64_cmp(Datum x, Datum y, SortSupport ssup)
+{
+    int64 a = DatumGetInt64(x);
+    int64 b = DatumGetInt64(y);
+
+    if (a > b)
+        return 1;
+    else if (a == b)
+        return 0;
+    else
+        return -1;
+}
+
+/*
+ * Return the width in bytes (4 or 8) of the signed integer whose natural
+ * order matches the given old-style btree comparison function, or 0 if the
+ * function is not one we know to be a plain integer comparison.
+ */
+int BtreeCmpRadixKeyWidth(PGFunction cmpFunc)
+{
+    if (cmpFunc == btint4cmp || cmpFunc == date_cmp)
+        return sizeof(int32);
+    if (cmpFunc == btint8cmp)
+        return sizeof(int64);
+#ifdef HAVE_INT64_TIMESTAMP
+    /* timestamptz_ops shares timestamp_cmp */
+    if (cmpFunc == timestamp_cmp)
+        return sizeof(int64);
+#endif
+    return 0;
+}
+
+/*
+ * Same as BtreeCmpRadixKeyWidth(), for a prepared SortSupport.  Both the
+ * shared fast comparators and the shim around an old-style comparator are
+ * recognized.  Keys using abbreviation never qualify, since the comparator
+ * then works on the abbreviated representation.
+ */
+int SortSupportRadixKeyWidth(SortSupport ssup)
+{
+    if (ssup->abbrev_converter != NULL)
+        return 0;
+    if (ssup->comparator == ssup_datum_int32_cmp)
+        return sizeof(int32);
+    if (ssup->comparator == ssup_datum_int64_cmp)
+        return sizeof(int64);
+    if (ssup->comparator == comparison_shim) {
+        SortShimExtra* extra = (SortShimExtra*)ssup->ssup_extra;
+
+        return BtreeCmpRadixKeyWidth(extra->flinfo.fn_addr);
+    }
+    return 0;
+}
@@ -132,6 +132,7 @@
 #include "utils/lsyscache.h"
 #include "utils/memutils.h"
 #include "utils/pg_rusage.h"
+#include "utils/radixsort.h"
 #include "utils/rel.h"
 #include "utils/rel_gs.h"
 #include "utils/sortsupport.h"
@@ -3206,9 +3207,114 @@ static void tuplesort_heap_replace_top(Tuplesortstate *state, SortTuple *tuple)
     memtuples[i] = *tuple;
 }
 
+/*
+ * Key extraction and fallback sort used by tuplesort_radix_sort_memtuples.
+ * datum1 of every tuple handed to RadixSortElems is known to be non-null.
+ */
+struct TuplesortRadixKey {
+    int width;
+    bool reverse;
+
+    uint64 operator()(const SortTuple& stup) const
+    {
+        if (width == sizeof(int32)) {
+            return RadixSortNormalizeInt32(DatumGetInt32(stup.datum1), reverse);
+        }
+        return RadixSortNormalizeInt64(DatumGetInt64(stup.datum1), reverse);
+    }
+};
+
+struct TuplesortRadixFallback {
+    Tuplesortstate* state;
+
+    void operator()(SortTuple* tuples, size_t n, bool keysEqual) const
+    {
+        if (state->onlyKey != NULL) {
+            /* a single-key sort has nothing to break ties on */
+            if (!keysEqual) {
+                qsort_ssup(tuples, n, state->onlyKey);
+            }
+        } else {
+            /* comparetup also does the unique check of btree index builds */
+            qsort_tuple(tuples, n, state->comparetup, state);
+        }
+    }
+};
+
+/*
+ * Sort memtuples with a radix sort on datum1 when the leading key is a
+ * plain fixed-width integer, see utils/radixsort.h.  Ties on that key, and
+ * NULLs, are ordered by the regular comparison sort.  Returns false if the
+ * fast path does not apply, leaving memtuples untouched.
+ */
+static bool tuplesort_radix_sort_memtuples(Tuplesortstate* state)
+{
+    SortTuple* memtuples = state->memtuples;
+    size_t ntuples = (size_t)state->memtupcount;
+    size_t nfront = 0;
+    bool nullsFirst = false;
+    TuplesortRadixKey keyFn;
+    TuplesortRadixFallback fallbackFn;
+
+    if (state->memtupcount < RADIX_SORT_MIN_ELEMS) {
+        return false;
+    }
+
+    if (state->comparetup == comparetup_index_btree) {
+        ScanKey scanKey = state->indexScanKey;
+
+        keyFn.width = BtreeCmpRadixKeyWidth(scanKey->sk_func.fn_addr);
+        keyFn.reverse = (scanKey->sk_flags & SK_BT_DESC) != 0;
+        nullsFirst = (scanKey->sk_flags & SK_BT_NULLS_FIRST) != 0;
+    } else if (state->comparetup == comparetup_heap || state->comparetup == comparetup_datum) {
+        SortSupport sortKey = (state->sortKeys != NULL) ? state->sortKeys : state->onlyKey;
+
+        keyFn.width = SortSupportRadixKeyWidth(sortKey);
+        keyFn.reverse = sortKey->ssup_reverse;
+        nullsFirst = sortKey->ssup_nulls_first;
+    } else {
+        return false;
+    }
+
+    if (keyFn.width == 0) {
+        return false;
+    }
+    fallbackFn.state = state;
+
+    /*
+     * Move the NULLs to the end they sort to: the first nfront tuples become
+     * the NULLs when they sort first, and the non-NULLs otherwise.
+     */
+    for (size_t i = 0; i < ntuples; i++) {
+        if (memtuples[i].isnull1 == nullsFirst) {
+            SortTuple tmp = memtuples[i];
+
+            memtuples[i] = memtuples[nfront];
+            memtuples[nfront++] = tmp;
+        }
+    }
+
+    SortTuple* nonNulls = nullsFirst ? memtuples + nfront : memtuples;
+    size_t nonNullCount = nullsFirst ? ntuples - nfront : nfront;
+    SortTuple* nulls = nullsFirst ? memtuples : memtuples + nfront;
+    size_t nullCount = ntuples - nonNullCount;
+
+    if (nonNullCount > 1) {
+        RadixSortElems(nonNulls, nonNullCount, 0, keyFn.width, keyFn, fallbackFn);
+    }
+    if (nullCount > 1) {
+        fallbackFn(nulls, nullCount, true);
+    }
+
+    return true;
+}
+
 static void tuplesort_sort_memtuples(Tuplesortstate *state)
 {
     if (state->memtupcount > 1) {
+        if (tuplesort_radix_sort_memtuples(state)) {
+            return;
+        }
         if (state->onlyKey != NULL) {
             qsort_ssup(state->memtuples, state->memtupcount, state->onlyKey);
         } else {
@@ -758,6 +758,25 @@ static void CleanStatementTable()
     PG_END_TRY();
 }
 
+/*
+ * On the primary, write the tuples of one suspend list to statement_history
+ * with a single heap_multi_insert call, and open the indexes once for all of
+ * them instead of once per tuple.
+ */
+static void InsertStatementTuples(Relation rel, HeapTuple* tuples, int ntuples)
+{
+    HeapMultiInsertExtraArgs args = {NULL, 0, false};
+    CatalogIndexState indstate;
+
+    (void)heap_multi_insert(rel, rel, tuples, ntuples, GetCurrentCommandId(true), 0, NULL, &args);
+
+    indstate = CatalogOpenIndexes(rel);
+    for (int i = 0; i < ntuples; i++) {
+        CatalogIndexInsert(indstate, tuples[i]);
+    }
+    CatalogCloseIndexes(indstate);
+}
+
 /* flush statement list info to statement_history table or mem-file chain */
 static void FlushStatementToTableOrMFChain(StatementStatContext* suspendList, const knl_u_statement_context* statementCxt)
 {
@@ -775,6 +794,17 @@ static void FlushStatementToTableOrMFChain(StatementStatContext* suspendList, co
         Relation rel = heap_openrv(relrv, RowExclusiveLock);
         bool isSlow = false;
         MemFileChain* target = NULL;
+        HeapTuple* tuples = NULL;
+        int ntuples = 0;
+
+        if (pmState != PM_HOT_STANDBY) {
+            int nitems = 0;
+            for (StatementStatContext *item = suspendList; item != NULL; item = (StatementStatContext *)item->next) {
+                nitems++;
+            }
+            tuples = (HeapTuple*)palloc(nitems * sizeof(HeapTuple));
+        }
+
         while (flushItem != NULL) {
             tuple = GetStatementTuple(rel, flushItem, statementCxt, &isSlow);
             if (pmState == PM_HOT_STANDBY) {
@@ -784,16 +814,25 @@ static void FlushStatementToTableOrMFChain(StatementStatContext* suspendList, co
                  */
                 target = isSlow ? g_instance.stat_cxt.stbyStmtHistSlow : g_instance.stat_cxt.stbyStmtHistFast;
                 (void)MemFileChainInsert(target, tuple, rel);
+                heap_freetuple_ext(tuple);
             } else {
                 /*
-                 * in primary node. it is a common write transaction.
+                 * in primary node. it is a common write transaction, the tuples are inserted together below.
                  */
-                (void)simple_heap_insert(rel, tuple);
-                CatalogUpdateIndexes(rel, tuple);
+                tuples[ntuples++] = tuple;
             }
-            heap_freetuple_ext(tuple);
             flushItem = (StatementStatContext *)flushItem->next;
         }
+
+        if (ntuples > 0) {
+            InsertStatementTuples(rel, tuples, ntuples);
+            for (int i = 0; i < ntuples; i++) {
+                heap_freetuple_ext(tuples[i]);
+            }
+        }
+        if (tuples != NULL) {
+            pfree(tuples);
+        }
         heap_close(rel, RowExclusiveLock);
         PopActiveSnapshot();
         CommitTransactionCommand();
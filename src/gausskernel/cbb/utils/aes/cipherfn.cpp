@@ -1385,7 +1385,7 @@ void encryptBlockOrCUData(const char* plainText, const size_t plainLength,
 #endif
 
     do {
-        if (encrypt_partial_mode(plainText, plainLength, cipherText, cipherLength, key, iv, algo)) {
+        if (encrypt_page_partial_mode(plainText, plainLength, cipherText, cipherLength, key, iv, algo)) {
             break;
         }
         retryCnt--;
@@ -1442,7 +1442,7 @@ void decryptBlockOrCUData(const char* cipherText, const size_t cipherLength,
 #endif
 
     do {
-        if (decrypt_partial_mode(cipherText, cipherLength, plainText, plainLength, key, iv, algo)) {
+        if (decrypt_page_partial_mode(cipherText, cipherLength, plainText, plainLength, key, iv, algo)) {
             break;
         }
         retryCnt--;
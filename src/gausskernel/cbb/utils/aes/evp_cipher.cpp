@@ -28,6 +28,7 @@
 #include <openssl/engine.h>
 #include "postgres.h"
 #include "knl/knl_variable.h"
+#include "storage/ipc.h"
 #include "utils/evp_cipher.h"
 
 #define SM4_ENGINE_ID "kae";
@@ -52,30 +53,133 @@ ENGINE* init_cipher_engine()
     return g_engine;
 }
 
-bool ctr_dec_partial_mode(const char* decalgoText, ENGINE* engine, const EVP_CIPHER* cipher,
-    const char* cipherText, const size_t cipherLength, char* plainText, size_t* plainLength,
+/*
+ * Every TDE page is encrypted on its own, but almost always with the same key,
+ * so each thread keeps one cipher context per direction for the page path.
+ * When cipher, engine and key are those of the previous call, only the IV is
+ * reset and the expanded key schedule is reused.  The cache keeps the key until
+ * the thread exits, so only the TDE data keys go through it; keys supplied by
+ * SQL callers would otherwise outlive their session on a pooled thread.
+ */
+typedef struct CipherCtxCache {
+    EVP_CIPHER_CTX* ctx;
+    const EVP_CIPHER* cipher;
+    ENGINE* engine;
+    unsigned char key[EVP_MAX_KEY_LENGTH];
+} CipherCtxCache;
+
+THR_LOCAL CipherCtxCache g_enc_ctx_cache = {NULL, NULL, NULL, {0}};
+THR_LOCAL CipherCtxCache g_dec_ctx_cache = {NULL, NULL, NULL, {0}};
+
+static void drop_cipher_ctx_cache(CipherCtxCache* cache)
+{
+    if (cache->ctx != NULL) {
+        EVP_CIPHER_CTX_free(cache->ctx);
+        cache->ctx = NULL;
+    }
+    cache->cipher = NULL;
+    cache->engine = NULL;
+    errno_t rc = memset_s(cache->key, sizeof(cache->key), 0, sizeof(cache->key));
+    securec_check(rc, "\0", "\0");
+}
+
+THR_LOCAL bool g_ctx_cache_exit_registered = false;
+
+/* on_proc_exit callback: the contexts live outside any memory context. */
+static void release_cipher_ctx_caches(int code, Datum arg)
+{
+    drop_cipher_ctx_cache(&g_enc_ctx_cache);
+    drop_cipher_ctx_cache(&g_dec_ctx_cache);
+}
+
+/*
+ * Set up a cipher context for one call.  Without a cache the context is new and
+ * must be handed back to put_cipher_ctx().
+ */
+static EVP_CIPHER_CTX* get_cipher_ctx(CipherCtxCache* cache, ENGINE* engine, const EVP_CIPHER* cipher,
+    unsigned char* key, unsigned char* iv, int enc)
+{
+    int keyLength = EVP_CIPHER_key_length(cipher);
+    bool sameKey = false;
+    int ret;
+
+    if (keyLength <= 0 || keyLength > EVP_MAX_KEY_LENGTH) {
+        return NULL;
+    }
+
+    if (cache == NULL) {
+        EVP_CIPHER_CTX* ctx = EVP_CIPHER_CTX_new();
+        if (ctx == NULL) {
+            return NULL;
+        }
+        /* EVP_CipherInit_ex() returns 1 for success and 0 for failure. */
+        if (EVP_CipherInit_ex(ctx, cipher, engine, key, iv, enc) == 0) {
+            EVP_CIPHER_CTX_free(ctx);
+            return NULL;
+        }
+        return ctx;
+    }
+
+    if (cache->ctx == NULL) {
+        if (!g_ctx_cache_exit_registered) {
+            on_proc_exit(release_cipher_ctx_caches, 0);
+            g_ctx_cache_exit_registered = true;
+        }
+        cache->ctx = EVP_CIPHER_CTX_new();
+        if (cache->ctx == NULL) {
+            return NULL;
+        }
+    } else {
+        sameKey = (cache->cipher == cipher && cache->engine == engine && memcmp(cache->key, key, keyLength) == 0);
+    }
+
+    /* EVP_CipherInit_ex() returns 1 for success and 0 for failure. */
+    if (sameKey) {
+        ret = EVP_CipherInit_ex(cache->ctx, NULL, NULL, NULL, iv, enc);
+    } else {
+        ret = EVP_CipherInit_ex(cache->ctx, cipher, engine, key, iv, enc);
+    }
+    if (ret == 0) {
+        drop_cipher_ctx_cache(cache);
+        return NULL;
+    }
+
+    if (!sameKey) {
+        errno_t rc = memcpy_s(cache->key, sizeof(cache->key), key, keyLength);
+        securec_check(rc, "\0", "\0");
+        cache->cipher = cipher;
+        cache->engine = engine;
+    }
+    return cache->ctx;
+}
+
+/* Done with ctx; on failure a cached one is dropped so the next call starts fresh. */
+static void put_cipher_ctx(CipherCtxCache* cache, EVP_CIPHER_CTX* ctx, bool failed)
+{
+    if (cache == NULL) {
+        EVP_CIPHER_CTX_free(ctx);
+    } else if (failed) {
+        drop_cipher_ctx_cache(cache);
+    }
+}
+
+static bool ctr_dec_partial_mode(CipherCtxCache* cache, const char* decalgoText, ENGINE* engine,
+    const EVP_CIPHER* cipher, const char* cipherText, const size_t cipherLength, char* plainText, size_t* plainLength,
     unsigned char* key, unsigned char* iv)
 {
     int segPlainLength = 0;
     int lastSegPlainLength = 0;
     int ret = 0;
-    EVP_CIPHER_CTX* ctx = EVP_CIPHER_CTX_new();
+    EVP_CIPHER_CTX* ctx = get_cipher_ctx(cache, engine, cipher, key, iv, 0);
     if (ctx == NULL) {
-        ereport(LOG, (errmsg("EVP_CIPHER_CTX_new failed when decrypt with %s", decalgoText)));
-        return false;
-    }
-
-    /* EVP_DecryptInit_ex() and EVP_DecryptUpdate() return 1 for success and 0 for failure. */
-    ret = EVP_DecryptInit_ex(ctx, cipher, engine, key, iv);
-    if (ret == 0) {
-        EVP_CIPHER_CTX_free(ctx);
         ereport(LOG, (errmsg("EVP_DecryptInit_ex failed when decrypt with %s", decalgoText)));
         return false;
     }
 
+    /* EVP_DecryptUpdate() returns 1 for success and 0 for failure. */
     ret = EVP_DecryptUpdate(ctx, (unsigned char*)plainText, &segPlainLength, (unsigned char*)cipherText, cipherLength);
     if (ret == 0) {
-        EVP_CIPHER_CTX_free(ctx);
+        put_cipher_ctx(cache, ctx, true);
         ereport(LOG, (errmsg("EVP_DecryptUpdate failed when decrypt with %s", decalgoText)));
         return false;
     }
@@ -83,54 +187,46 @@ bool ctr_dec_partial_mode(const char* decalgoText, ENGINE* engine, const EVP_CIP
     /* EVP_DecryptFinal_ex() returns 0 if the decrypt failed or 1 for success. */
     ret = EVP_DecryptFinal_ex(ctx, (unsigned char*)plainText + segPlainLength, &lastSegPlainLength);
     if (ret == 0) {
-        EVP_CIPHER_CTX_free(ctx);
+        put_cipher_ctx(cache, ctx, true);
         ereport(LOG, (errmsg("EVP_DecryptFinal_ex failed when decrypt with %s", decalgoText)));
         return false;
     }
     
     *plainLength = segPlainLength + lastSegPlainLength;
-    EVP_CIPHER_CTX_free(ctx);
+    put_cipher_ctx(cache, ctx, false);
     return true;
 }
 
-bool ctr_enc_partial_mode(const char* encalgoText, ENGINE* engine, const EVP_CIPHER* cipher,
-    const char* plainText, const size_t plainLength, char* cipherText, size_t* cipherLength,
+static bool ctr_enc_partial_mode(CipherCtxCache* cache, const char* encalgoText, ENGINE* engine,
+    const EVP_CIPHER* cipher, const char* plainText, const size_t plainLength, char* cipherText, size_t* cipherLength,
     unsigned char* key, unsigned char* iv)
 {
     int SegCipherLength = 0;
     int LastSegCipherLength = 0;
     int ret = 0;
-    EVP_CIPHER_CTX* ctx = NULL;
-    ctx = EVP_CIPHER_CTX_new();
+    EVP_CIPHER_CTX* ctx = get_cipher_ctx(cache, engine, cipher, key, iv, 1);
     if (ctx == NULL) {
-        ereport(LOG, (errmsg("EVP_CIPHER_CTX_new failed when encrypt with %s", encalgoText)));
-        return false;
-    }
-
-    /* EVP_EncryptInit_ex(), EVP_EncryptUpdate() and EVP_EncryptFinal_ex() return 1 for success and 0 for failure. */
-    ret = EVP_EncryptInit_ex(ctx, cipher, engine, key, iv);
-    if (ret == 0) {
-        EVP_CIPHER_CTX_free(ctx);
         ereport(LOG, (errmsg("EVP_EncryptInit_ex failed when encrypt with %s", encalgoText)));
         return false;
     }
 
+    /* EVP_EncryptUpdate() and EVP_EncryptFinal_ex() return 1 for success and 0 for failure. */
     ret = EVP_EncryptUpdate(ctx, (unsigned char*)cipherText, &SegCipherLength, (unsigned char*)plainText, plainLength);
     if (ret == 0) {
-        EVP_CIPHER_CTX_free(ctx);
+        put_cipher_ctx(cache, ctx, true);
         ereport(LOG, (errmsg("EVP_EncryptUpdate failed when encrypt with %s", encalgoText)));
         return false;
     }
 
     ret = EVP_EncryptFinal_ex(ctx, (unsigned char*)cipherText + SegCipherLength, &LastSegCipherLength);
     if (ret == 0) {
-        EVP_CIPHER_CTX_free(ctx);
+        put_cipher_ctx(cache, ctx, true);
         ereport(LOG, (errmsg("EVP_EncryptFinal_ex failed when encrypt with %s", encalgoText)));
         return false;
     }
     
     *cipherLength = SegCipherLength + LastSegCipherLength;
-    EVP_CIPHER_CTX_free(ctx);
+    put_cipher_ctx(cache, ctx, false);
     return true;
 }
 
@@ -139,6 +235,7 @@ bool ctr_enc_partial_mode(const char* encalgoText, ENGINE* engine, const EVP_CIP
  *      Encrypt with standard AES/SM4 algorthm using openssl functions.
  *      For SM4, engine is set for hardware instruction acceleration on ARM platform.
  * Input:
+ *      cache: per-thread context cache to use, NULL for a one-shot context
  *      plainText: plain text need to be encrypted
  *      plainLength: plain text length
  *      key: encryption key
@@ -151,8 +248,8 @@ bool ctr_enc_partial_mode(const char* encalgoText, ENGINE* engine, const EVP_CIP
  *      true: success
  *      false: failure
  */
-bool encrypt_partial_mode(const char* plainText, const size_t plainLength, char* cipherText,
-    size_t* cipherLength, unsigned char* key, unsigned char* iv, TdeAlgo algo)
+static bool encrypt_partial_mode_internal(CipherCtxCache* cache, const char* plainText, const size_t plainLength,
+    char* cipherText, size_t* cipherLength, unsigned char* key, unsigned char* iv, TdeAlgo algo)
 {
     const char* algoText = NULL;
     ENGINE* engine = NULL; /* if engine is NULL then the default implementation is used */
@@ -183,7 +280,7 @@ bool encrypt_partial_mode(const char* plainText, const size_t plainLength, char*
     }
     
     /* begin to encrypt now */
-    bool result = ctr_enc_partial_mode(algoText, engine, cipher, plainText, plainLength, cipherText, 
+    bool result = ctr_enc_partial_mode(cache, algoText, engine, cipher, plainText, plainLength, cipherText,
         cipherLength, key, iv);
     return result;
 }
@@ -193,6 +290,7 @@ bool encrypt_partial_mode(const char* plainText, const size_t plainLength, char*
  *      Encrypt with standard AES/SM4 algorthm using openssl functions.
  *      For SM4, engine is set for hardware instruction acceleration on ARM platform.
  * Input:
+ *      cache: per-thread context cache to use, NULL for a one-shot context
  *      cipherText: ciphertext text to be decrypted
  *      cipherLength: cipher text length
  *      key: decryption key
@@ -205,8 +303,8 @@ bool encrypt_partial_mode(const char* plainText, const size_t plainLength, char*
  *      true: success
  *      false: failure
  */
-bool decrypt_partial_mode(const char* cipherText, const size_t cipherLength, char* plainText,
-    size_t* plainLength, unsigned char* key, unsigned char* iv, TdeAlgo algo)
+static bool decrypt_partial_mode_internal(CipherCtxCache* cache, const char* cipherText, const size_t cipherLength,
+    char* plainText, size_t* plainLength, unsigned char* key, unsigned char* iv, TdeAlgo algo)
 {
     const char* algoText = NULL;
     ENGINE* engine = NULL;
@@ -237,8 +335,38 @@ bool decrypt_partial_mode(const char* cipherText, const size_t cipherLength, cha
     }
 
     /* begin to decrypt now */
-    bool result = ctr_dec_partial_mode(algoText, engine, cipher, cipherText, cipherLength, plainText, 
+    bool result = ctr_dec_partial_mode(cache, algoText, engine, cipher, cipherText, cipherLength, plainText,
         plainLength, key, iv);
     return result;
 }
 
+bool encrypt_partial_mode(const char* plainText, const size_t plainLength, char* cipherText,
+    size_t* cipherLength, unsigned char* key, unsigned char* iv, TdeAlgo algo)
+{
+    return encrypt_partial_mode_internal(NULL, plainText, plainLength, cipherText, cipherLength, key, iv, algo);
+}
+
+bool decrypt_partial_mode(const char* cipherText, const size_t cipherLength, char* plainText,
+    size_t* plainLength, unsigned char* key, unsigned char* iv, TdeAlgo algo)
+{
+    return decrypt_partial_mode_internal(NULL, cipherText, cipherLength, plainText, plainLength, key, iv, algo);
+}
+
+/*
+ * Same as encrypt_partial_mode/decrypt_partial_mode, for TDE data pages only:
+ * the context and a copy of the key stay cached in the thread, see
+ * CipherCtxCache.
+ */
+bool encrypt_page_partial_mode(const char* plainText, const size_t plainLength, char* cipherText,
+    size_t* cipherLength, unsigned char* key, unsigned char* iv, TdeAlgo algo)
+{
+    return encrypt_partial_mode_internal(&g_enc_ctx_cache, plainText, plainLength, cipherText, cipherLength, key, iv,
+        algo);
+}
+
+bool decrypt_page_partial_mode(const char* cipherText, const size_t cipherLength, char* plainText,
+    size_t* plainLength, unsigned char* key, unsigned char* iv, TdeAlgo algo)
+{
+    return decrypt_partial_mode_internal(&g_dec_ctx_cache, cipherText, cipherLength, plainText, plainLength, key, iv,
+        algo);
+}
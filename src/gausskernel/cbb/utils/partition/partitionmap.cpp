@@ -1218,6 +1218,97 @@ ListPartElement* CopyListElements(ListPartElement* src, int elementNum)
     return ret;
 }
 
+static int ListPartValueCmp(const void* a, const void* b)
+{
+    const ListPartValue* left = (const ListPartValue*)a;
+    const ListPartValue* right = (const ListPartValue*)b;
+    int compare = 0;
+
+    partitonKeyCompareForRouting(&left->value, &right->value, 1, compare);
+    if (compare != 0) {
+        return compare;
+    }
+    return (left->partSeq < right->partSeq) ? -1 : ((left->partSeq > right->partSeq) ? 1 : 0);
+}
+
+/*
+ * Sort the values of all list partitions, so that getListPartitionOid can
+ * route a key value with a binary search instead of comparing it to every
+ * value of every partition.  Only single-column keys are indexed, and a
+ * NULL list value leaves the map without an index, since NULLs can not be
+ * ordered against each other.  The index is built in the current memory
+ * context, the one the list elements were just copied into.
+ */
+void BuildListPartitionValueIndex(ListPartitionMap* listMap)
+{
+    int nvalues = 0;
+    int i;
+    int j;
+
+    listMap->sortedValuesNum = 0;
+    listMap->sortedValues = NULL;
+    listMap->defaultPartSeq = -1;
+
+    if (listMap->partitionKey->dim1 != 1) {
+        return;
+    }
+
+    for (i = 0; i < listMap->listElementsNum; i++) {
+        ListPartElement* elem = &listMap->listElements[i];
+        if (elem->len == 1 && elem->boundary[0]->ismaxvalue) {
+            listMap->defaultPartSeq = i;
+            continue;
+        }
+        for (j = 0; j < elem->len; j++) {
+            if (!PointerIsValid(elem->boundary[j]) || elem->boundary[j]->constisnull) {
+                listMap->defaultPartSeq = -1;
+                return;
+            }
+        }
+        nvalues += elem->len;
+    }
+
+    listMap->sortedValues = (ListPartValue*)palloc(sizeof(ListPartValue) * Max(nvalues, 1));
+    for (i = 0; i < listMap->listElementsNum; i++) {
+        ListPartElement* elem = &listMap->listElements[i];
+        if (i == listMap->defaultPartSeq) {
+            continue;
+        }
+        for (j = 0; j < elem->len; j++) {
+            listMap->sortedValues[listMap->sortedValuesNum].value = elem->boundary[j];
+            listMap->sortedValues[listMap->sortedValuesNum].partSeq = i;
+            listMap->sortedValuesNum++;
+        }
+    }
+    qsort(listMap->sortedValues, listMap->sortedValuesNum, sizeof(ListPartValue), ListPartValueCmp);
+}
+
+/* Return the index of the list element holding the key value, or -1 */
+static int SearchListPartitionValueIndex(const ListPartitionMap* listMap, Const** partKeyValue)
+{
+    int low = 0;
+    int high = listMap->sortedValuesNum;
+    int compare = 0;
+
+    /* find the first value not less than the key */
+    while (low < high) {
+        int mid = (int)((uint32)(low + high) >> 1);
+        partitonKeyCompareForRouting(partKeyValue, &listMap->sortedValues[mid].value, 1, compare);
+        if (compare > 0) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    if (low < listMap->sortedValuesNum) {
+        partitonKeyCompareForRouting(partKeyValue, &listMap->sortedValues[low].value, 1, compare);
+        if (compare == 0) {
+            return listMap->sortedValues[low].partSeq;
+        }
+    }
+    return listMap->defaultPartSeq;
+}
+
 void DestroyListElements(ListPartElement* src, int elementNum)
 {
     int i = 0;
@@ -1348,6 +1439,7 @@ void DestroyPartitionMap(PartitionMap* partMap)
             DestroyListElements(list_map->listElements, list_map->listElementsNum);
             list_map->listElements = NULL;
         }
+        pfree_ext(list_map->sortedValues);
     } else if (partMap->type == PART_TYPE_HASH) {
         HashPartitionMap* hash_map = (HashPartitionMap*)(partMap);
         if (hash_map->partitionKey) {
@@ -1573,6 +1665,7 @@ static void BuildListPartitionMap(Relation relation, Form_pg_partition partition
     old_context = MemoryContextSwitchTo(LocalMyDBCacheMemCxt());
 
     list_map->listElements = CopyListElements(list_eles, list_map->listElementsNum);
+    BuildListPartitionValueIndex(list_map);
     relation->partMap = (PartitionMap*)palloc(sizeof(ListPartitionMap));
     rc = memcpy_s(relation->partMap, sizeof(ListPartitionMap), list_map, sizeof(ListPartitionMap));
     securec_check(rc, "\0", "\0");
@@ -2054,7 +2147,19 @@ Oid getListPartitionOid(PartitionMap* partMap, Const** partKeyValue, int32* part
     incre_partmap_refcount(partMap);
     listPartMap = (ListPartitionMap*)(partMap);
     keyNums = listPartMap->partitionKey->dim1;
-    
+
+    if (listPartMap->sortedValues != NULL) {
+        hit = SearchListPartitionValueIndex(listPartMap, partKeyValue);
+        if (PointerIsValid(partSeq)) {
+            *partSeq = hit;
+        }
+        if (hit >= 0) {
+            result = listPartMap->listElements[hit].partitionOid;
+        }
+        decre_partmap_refcount(partMap);
+        return result;
+    }
+
     int i = 0;
     while (i < listPartMap->listElementsNum && hit < 0) {
         boundary = listPartMap->listElements[i].boundary;
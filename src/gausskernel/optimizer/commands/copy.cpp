@@ -109,6 +109,7 @@
 #include "parser/parse_coerce.h"
 #include "parser/parse_expr.h"
 #include "parser/parse_type.h"
+#include "utils/bytescan.h"
 #ifdef ENABLE_MULTIPLE_NODES
 #include "tsdb/storage/ts_store_insert.h"
 #endif   /* ENABLE_MULTIPLE_NODES */
@@ -2782,22 +2783,19 @@ void EndCopyTo(CopyState cstate)
     cstate = NULL;
 }
 
-static void DeformCopyTuple(
-    MemoryContext perBatchMcxt, CopyState cstate, VectorBatch* batch, TupleDesc tupDesc, Datum* values, bool* nulls)
+/*
+ * Send the rows of a batch.  Only the colNum columns in colIdx were scanned,
+ * the rest of values/nulls is never looked at by CopyOneRowTo.
+ */
+static void DeformCopyTuple(MemoryContext perBatchMcxt, CopyState cstate, VectorBatch* batch, TupleDesc tupDesc,
+    const int16* colIdx, int colNum, Datum* values, bool* nulls)
 {
-    errno_t rc = EOK;
     Form_pg_attribute* attrs = tupDesc->attrs;
 
     // deform values from vectorbatch.
     for (int nrow = 0; nrow < batch->m_rows; nrow++) {
-        rc = memset_s(nulls, sizeof(bool) * tupDesc->natts, 0, sizeof(bool) * tupDesc->natts);
-        securec_check(rc, "\0", "\0");
-
-        for (int ncol = 0; ncol < batch->m_cols; ncol++) {
-            /* If the column is dropped, skip deform values from vectorbatch */
-            if (attrs[ncol]->attisdropped) {
-                continue;
-            }
+        for (int i = 0; i < colNum; i++) {
+            int ncol = colIdx[i] - 1;
             ScalarVector* pVec = &(batch->m_arr[ncol]);
             ScalarValue* pVal = pVec->m_vals;
 
@@ -2805,19 +2803,24 @@ static void DeformCopyTuple(
                 nulls[ncol] = true;
                 continue;
             }
+            nulls[ncol] = false;
 
             if (pVec->m_desc.encoded) {
                 Datum val = ScalarVector::Decode(pVal[nrow]);
-                MemoryContext oldmcxt = MemoryContextSwitchTo(perBatchMcxt);
 
+                /*
+                 * Varlena values can be sent straight from the batch.  Wider
+                 * fixed-length types are stored behind a short header, copy
+                 * them out so the output function sees them aligned.
+                 */
                 if (attrs[ncol]->attlen > 8) {
+                    MemoryContext oldmcxt = MemoryContextSwitchTo(perBatchMcxt);
                     char* result = NULL;
                     result = (char*)val + VARHDRSZ_SHORT;
                     values[ncol] = datumCopy(PointerGetDatum(result), attrs[ncol]->attbyval, attrs[ncol]->attlen);
+                    MemoryContextSwitchTo(oldmcxt);
                 } else
-                    values[ncol] = datumCopy(val, attrs[ncol]->attbyval, attrs[ncol]->attlen);
-
-                MemoryContextSwitchTo(oldmcxt);
+                    values[ncol] = val;
             } else
                 values[ncol] = pVal[nrow];
         }
@@ -2847,6 +2850,7 @@ static uint64 CStoreCopyTo(CopyState cstate, TupleDesc tupDesc, Datum* values, b
     CStoreScanDesc scandesc;
     VectorBatch* batch = NULL;
     int16* colIdx = (int16*)palloc0(sizeof(int16) * tupDesc->natts);
+    bool* needed = (bool*)palloc0(sizeof(bool) * tupDesc->natts);
     Form_pg_attribute* attrs = tupDesc->attrs;
     MemoryContext perBatchMcxt = AllocSetContextCreate(CurrentMemoryContext,
         "COPY TO PER BATCH",
@@ -2854,15 +2858,30 @@ static uint64 CStoreCopyTo(CopyState cstate, TupleDesc tupDesc, Datum* values, b
         ALLOCSET_DEFAULT_INITSIZE,
         ALLOCSET_DEFAULT_MAXSIZE);
     uint64 processed = 0;
+    int colNum = 0;
+    ListCell* cur = NULL;
 
-    for (int i = 0; i < tupDesc->natts; i++)
-        colIdx[i] = attrs[i]->attnum;
+    /* Only read the CUs of the columns being copied out */
+    foreach (cur, cstate->attnumlist) {
+        needed[lfirst_int(cur) - 1] = true;
+    }
+    if (IS_FIXED(cstate)) {
+        FixFormatter* formatter = (FixFormatter*)cstate->formatter;
+        for (int i = 0; i < formatter->nfield; i++)
+            needed[formatter->fieldDesc[i].attnum - 1] = true;
+    }
+    for (int i = 0; i < tupDesc->natts; i++) {
+        if (needed[i] && !attrs[i]->attisdropped)
+            colIdx[colNum++] = attrs[i]->attnum;
+        nulls[i] = true;
+    }
+    pfree_ext(needed);
 
-    scandesc = CStoreBeginScan(cstate->curPartionRel, tupDesc->natts, colIdx, GetActiveSnapshot(), true);
+    scandesc = CStoreBeginScan(cstate->curPartionRel, colNum, colIdx, GetActiveSnapshot(), true);
 
     do {
         batch = CStoreGetNextBatch(scandesc);
-        DeformCopyTuple(perBatchMcxt, cstate, batch, tupDesc, values, nulls);
+        DeformCopyTuple(perBatchMcxt, cstate, batch, tupDesc, colIdx, colNum, values, nulls);
         processed += batch->m_rows;
     } while (!CStoreIsEndScan(scandesc));
 
@@ -6656,6 +6675,28 @@ static bool CopyReadLineTextTemplate(CopyState cstate)
 
     mblen_str[1] = '\0';
 
+    /*
+     * Bytes the loop below has to look at one by one; everything else is
+     * just part of the line and is skipped over in bulk.
+     */
+    ByteScanSet plainSet;
+    char stopChars[BYTESCAN_MAX_CHARS];
+    int nStopChars = 0;
+
+    stopChars[nStopChars++] = '\r';
+    stopChars[nStopChars++] = '\n';
+    stopChars[nStopChars++] = '\\';
+    if (csv_mode) {
+        stopChars[nStopChars++] = quotec;
+        if (escapec != '\0') {
+            stopChars[nStopChars++] = escapec;
+        }
+    }
+    if (cstate->eol_type == EOL_UD) {
+        stopChars[nStopChars++] = cstate->eol[0];
+    }
+    ByteScanSetInit(&plainSet, stopChars, nStopChars, cstate->encoding_embeds_ascii);
+
     /*
      * The objective of this loop is to transfer the entire next input line
      * into line_buf.  Hence, we only care for detecting newlines (\r and/or
@@ -6718,6 +6759,19 @@ static bool CopyReadLineTextTemplate(CopyState cstate)
             need_data = false;
         }
 
+        /*
+         * Jump over the run of ordinary bytes ahead.  None of them changes
+         * the quoting state, except that they end an escape sequence and
+         * are not the first character of the line any more.
+         */
+        int plainLen = ByteScanPlain(&plainSet, copy_raw_buf + raw_buf_ptr, copy_buf_len - raw_buf_ptr);
+        if (plainLen > 0) {
+            raw_buf_ptr += plainLen;
+            first_char_in_line = false;
+            last_was_esc = false;
+            continue;
+        }
+
         /* OK to fetch a character */
         prev_raw_ptr = raw_buf_ptr;
         c = copy_raw_buf[raw_buf_ptr++];
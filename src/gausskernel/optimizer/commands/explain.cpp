@@ -2672,6 +2672,10 @@ static void ExplainNode(
             if (plan->qual)
                 show_instrumentation_count("Rows Removed by Filter", 1, planstate, es);
             show_llvm_info(planstate, es);
+
+            if (IsA(plan, CStoreScan)) {
+                show_bloomfilter<false>(plan, planstate, ancestors, es);
+            }
             break;
         /* FALL THRU */
         case T_Stream:
@@ -3867,6 +3871,10 @@ static void show_sort_keys(SortState* sortstate, List* ancestors, ExplainState*
         plan->nullsFirst,
         ancestors,
         es);
+    if (plan->numPresorted > 0) {
+        show_sort_group_keys(
+            (PlanState*)sortstate, "Presorted Key", plan->numPresorted, plan->sortColIdx, NULL, NULL, NULL, ancestors, es);
+    }
 }
 
 /*
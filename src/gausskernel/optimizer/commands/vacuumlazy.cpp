@@ -251,7 +251,17 @@ void lazy_vacuum_rel(Relation onerel, VacuumStmt* vacstmt, BufferAccessStrategy
             TupleDesc tupDesc = onerel->rd_att;
             Datum* val = (Datum*)palloc(sizeof(Datum) * tupDesc->natts);
             bool* null = (bool*)palloc(sizeof(bool) * tupDesc->natts);
-            bulkload_rows batchRow(tupDesc, RelationGetMaxBatchRows(onerel), true);
+            int maxBatchRows = RelationGetMaxBatchRows(onerel);
+            bulkload_rows batchRow(tupDesc, maxBatchRows, true);
+
+            /*
+             * Delta tuples are deleted only once their batch really goes to a CU.
+             * A tail smaller than deltarow_threshold would be routed straight back
+             * into the delta table by CStoreInsert, so it is left where it is to
+             * avoid churning dead tuples into delta on every vacuum.
+             */
+            ItemPointerData* batchTids = (ItemPointerData*)palloc(sizeof(ItemPointerData) * maxBatchRows);
+            int nBatchTids = 0;
 
             while ((deltaTup = (HeapTuple) tableam_scan_getnexttuple(deltaScanDesc, ForwardScanDirection)) != NULL) {
                 /* need to flatten toast attributes before append into cu */
@@ -264,24 +274,34 @@ void lazy_vacuum_rel(Relation onerel, VacuumStmt* vacstmt, BufferAccessStrategy
 
                 /* ignore returned value because only one tuple is appended into */
                 (void)batchRow.append_one_tuple(val, null, tupDesc);
-
-                /* delete the current tuple from delta table */
-                simple_heap_delete(deltaRel, &deltaTup->t_self);
+                batchTids[nBatchTids++] = deltaTup->t_self;
 
                 /* free possibly flattened delta tuple */
                 heap_freetuple_ext(deltaTupFlattened);
 
                 if (batchRow.full_rownum()) {
-                    /*  insert into main table */
+                    /*  insert into main table, then delete the moved tuples from delta table */
                     cstoreInsert.BatchInsert(&batchRow, 0);
                     batchRow.reset(true);
+                    for (int i = 0; i < nBatchTids; i++)
+                        simple_heap_delete(deltaRel, &batchTids[i]);
+                    nBatchTids = 0;
                 }
             }
             cstoreInsert.SetEndFlag();
-            cstoreInsert.BatchInsert(&batchRow, 0);
+            if (!g_instance.attr.attr_storage.enable_delta_store ||
+                batchRow.m_rows_curnum >= RelationGetDeltaRowsThreshold(onerel)) {
+                cstoreInsert.BatchInsert(&batchRow, 0);
+                for (int i = 0; i < nBatchTids; i++)
+                    simple_heap_delete(deltaRel, &batchTids[i]);
+            } else {
+                /* only flush what is buffered for partial sort, the tail stays in delta table */
+                cstoreInsert.BatchInsert((bulkload_rows*)NULL, 0);
+            }
             tableam_scan_end(deltaScanDesc);
 
             /* clean cstore insert */
+            pfree(batchTids);
             pfree(val);
             pfree(null);
             CStoreInsert::DeInitInsertArg(args);
@@ -2252,6 +2272,13 @@ static bool cbi_lazy_tid_reaped(ItemPointer itemptr, void* state, Oid partOid, i
         return false;
     }
 
+    /* Most index entries point outside the dead tuple range, don't bsearch for those */
+    if (vacrelstats->num_dead_tuples <= 0 ||
+        cbi_vac_cmp_itemptr(&vacItemPointerData, &vacrelstats->dead_tuples[0]) < 0 ||
+        cbi_vac_cmp_itemptr(&vacItemPointerData, &vacrelstats->dead_tuples[vacrelstats->num_dead_tuples - 1]) > 0) {
+        return false;
+    }
+
     res = (VacItemPointer)bsearch((void*)&vacItemPointerData,
         (void*)vacrelstats->dead_tuples,
         vacrelstats->num_dead_tuples,
@@ -2265,6 +2292,8 @@ static bool lazy_tid_reaped(ItemPointer itemptr, void* state, Oid partOid, int2
 {
     LVRelStats* vacrelstats = (LVRelStats*)state;
     VacItemPointer res;
+    VacItemPointer first;
+    int ndead = vacrelstats->num_dead_tuples - vacrelstats->curr_heap_start;
 
     VacItemPointerData vacItemPointerData;
     vacItemPointerData.itemPointerData = *itemptr;
@@ -2275,6 +2304,20 @@ static bool lazy_tid_reaped(ItemPointer itemptr, void* state, Oid partOid, int2
         return false;
     }
 
+    /*
+     * The dead tuples are in TID order, so an index entry pointing before
+     * the first or after the last one can't be dead.  On a big table most of
+     * the index entries are such, and this saves their bsearch.
+     */
+    if (ndead <= 0) {
+        return false;
+    }
+    first = &vacrelstats->dead_tuples[vacrelstats->curr_heap_start];
+    if (vac_cmp_itemptr(&vacItemPointerData, first) < 0 ||
+        vac_cmp_itemptr(&vacItemPointerData, first + ndead - 1) > 0) {
+        return false;
+    }
+
     res = (VacItemPointer)bsearch((void*)&vacItemPointerData,
         (void*)&(vacrelstats->dead_tuples[vacrelstats->curr_heap_start]),
         vacrelstats->num_dead_tuples - vacrelstats->curr_heap_start,
@@ -52,6 +52,12 @@ const float LREANINGRATE = 0.001;
 const int8 MIN_EXPL_TIMES = 5;
 const int8 MIN_EVAL_TIMES = 3;
 
+/* executions a candidate needs in a region before its average time is trusted */
+const int8 MIN_EXEC_SAMPLES = 3;
+
+/* log2 buckets a base-rel selectivity is split into to form a region */
+const int8 REGION_SELEC_BUCKETS = 16;
+
 #define Max(x, y) ((x) > (y) ? (x) : (y))
 #define Min(x, y) ((x) < (y) ? (x) : (y))
 
@@ -626,6 +632,50 @@ IsMatchedPlan(PlannerInfo *queryRoot, List *query_rel_sels,
     return true;
 }
 
+/*
+ * SelectivityRegion: key of the region the query's base-rel selectivities
+ * fall into.  Each selectivity is put into a log2 bucket, so queries in one
+ * region differ by less than a factor of two per relation.  Never 0.
+ */
+static uint32
+SelectivityRegion(List *query_rel_sels)
+{
+    uint32 key = 0;
+    ListCell *cell;
+
+    foreach (cell, query_rel_sels) {
+        double selec = ((RelSelec *)lfirst(cell))->selectivity;
+        uint32 bucket = 0;
+
+        while (selec < 0.5 && bucket < (uint32)REGION_SELEC_BUCKETS - 1) {
+            selec *= 2;
+            bucket++;
+        }
+        key = (key << 4 | key >> 28) ^ (bucket + 1);
+    }
+    return (key == 0) ? 1 : key;
+}
+
+static inline PlanRegionStats *
+GetRegionStats(CachedPlanInfo *cpi, uint32 region)
+{
+    return &cpi->regionStats[region % PMGR_REGION_SLOTS];
+}
+
+/* executions of the plan seen in this region, and their total time */
+static uint32
+GetPlanRegionSamples(CachedPlanInfo *cpi, uint32 region, uint64 *exec_costs)
+{
+    PlanRegionStats *stats = GetRegionStats(cpi, region);
+
+    if (stats->region != region) {
+        *exec_costs = 0;
+        return 0;
+    }
+    *exec_costs = stats->exec_costs;
+    return stats->times;
+}
+
 static CachedPlan*
 FindMatchedPlan(PlanManager *manager, PlannerInfo *queryRoot)
 {
@@ -642,12 +692,40 @@ FindMatchedPlan(PlanManager *manager, PlannerInfo *queryRoot)
     set_base_rel_sizes(queryRoot, true);
     List *query_rel_sels = GetBaseRelSelectivity(queryRoot);
     usePartIdx = MatchPartIdxQuery(queryRoot);
+    uint32 region = SelectivityRegion(query_rel_sels);
+
+    /*
+     * A plan is matched if both types of CIs can dominate. The CIs of the
+     * candidates may overlap; among the matched ones prefer the plan that has
+     * run fastest for queries of this selectivity region.  Plans are only
+     * compared on samples from the same region.  A matched plan with fewer
+     * than MIN_EXEC_SAMPLES runs here is tried first, so every candidate
+     * covering the region gets measured; that exploration is bounded by
+     * MIN_EXEC_SAMPLES runs per candidate and region.
+     */
+    CachedPlan *unexplored = NULL;
+    CachedPlan *fastest = NULL;
+    double fastest_avg = 0;
 
-    /* A plan is matched if both types of CIs can dominate */
     foreach (cl,  manager->candidatePlans) {
         CachedPlan *plan = (CachedPlan *)lfirst(cl);
-        if (IsMatchedPlan(queryRoot, query_rel_sels, plan->cpi, usePartIdx)) {
-            return plan;
+        if (!IsMatchedPlan(queryRoot, query_rel_sels, plan->cpi, usePartIdx)) {
+            continue;
+        }
+
+        uint64 costs = 0;
+        uint32 samples = GetPlanRegionSamples(plan->cpi, region, &costs);
+        if (samples < (uint32)MIN_EXEC_SAMPLES) {
+            if (unexplored == NULL) {
+                unexplored = plan;
+            }
+            continue;
+        }
+
+        double avg = (double)costs / samples;
+        if (fastest == NULL || avg < fastest_avg) {
+            fastest = plan;
+            fastest_avg = avg;
         }
     }
 
@@ -655,7 +733,49 @@ FindMatchedPlan(PlanManager *manager, PlannerInfo *queryRoot)
      * If all candidates are mis-matched, trigger a new plan exploration by
      * returning NULL.
      */
-    return NULL;
+    CachedPlan *chosen = (unexplored != NULL) ? unexplored : fastest;
+    u_sess->pcache_cxt.matched_plan = chosen;
+    u_sess->pcache_cxt.matched_region = region;
+    return chosen;
+}
+
+/*
+ * PMGR_RecordPlanExecution: feed the executor time of one portal run with a
+ * candidate plan back into its statistics, for FindMatchedPlan to use.
+ * exec_usecs only adds up the time spent inside PortalRun, so client think
+ * time between fetches does not count.  Portals that never ran add nothing.
+ * region is the selectivity region the plan was matched for, 0 when the
+ * plan did not come from FindMatchedPlan.
+ *
+ * The counters are updated without a lock; a run that races with another
+ * region taking over the slot may be lost or land in the new region, which
+ * only perturbs an average.
+ */
+void
+PMGR_RecordPlanExecution(CachedPlan *plan, uint32 region, uint64 exec_usecs)
+{
+    if (plan->cpi == NULL || !plan->is_candidate || exec_usecs == 0) {
+        return;
+    }
+
+    (void)pg_atomic_fetch_add_u64(&plan->cpi->sample_exec_costs, exec_usecs);
+    (void)pg_atomic_fetch_add_u32(&plan->cpi->sample_times, 1);
+
+    if (region == 0) {
+        return;
+    }
+
+    PlanRegionStats *stats = GetRegionStats(plan->cpi, region);
+    uint32 old_region = stats->region;
+    if (old_region != region) {
+        if (!pg_atomic_compare_exchange_u32(&stats->region, &old_region, region)) {
+            return;
+        }
+        stats->exec_costs = 0;
+        stats->times = 0;
+    }
+    (void)pg_atomic_fetch_add_u64(&stats->exec_costs, exec_usecs);
+    (void)pg_atomic_fetch_add_u32(&stats->times, 1);
 }
 
 void
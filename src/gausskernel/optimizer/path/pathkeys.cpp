@@ -440,6 +440,26 @@ bool pathkeys_contained_in(List* keys1, List* keys2)
     return false;
 }
 
+/*
+ * pathkeys_common_prefix
+ *	  Return the number of leading pathkeys keys1 and keys2 have in common.
+ *	  Both lists must be canonical, so pointer comparison suffices.
+ */
+int pathkeys_common_prefix(List* keys1, List* keys2)
+{
+    ListCell* key1 = NULL;
+    ListCell* key2 = NULL;
+    int n = 0;
+
+    forboth(key1, keys1, key2, keys2)
+    {
+        if (lfirst(key1) != lfirst(key2))
+            break;
+        n++;
+    }
+    return n;
+}
+
 /*
  * get_cheapest_path_for_pathkeys
  *	  Find the cheapest path (according to the specified criterion) that
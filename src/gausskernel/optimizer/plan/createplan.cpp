@@ -4273,6 +4273,7 @@ static void search_var_and_mark_bloomfilter(PlannerInfo* root, Expr* expr, Plan*
     }
 
     switch (nodeTag(plan)) {
+        case T_CStoreScan:
         case T_ForeignScan: {
             if (IsA(plan, ForeignScan)) {
                 ForeignScan* splan = (VecForeignScan*)plan;
@@ -4217,6 +4217,17 @@ static Plan* grouping_planner(PlannerInfo* root, double tuple_fraction)
         if (!pathkeys_contained_in(root->sort_pathkeys, current_pathkeys) ||
             (result_plan->dop > 1 && root->sort_pathkeys)) {
             result_plan = (Plan*)make_sort_from_pathkeys(root, result_plan, root->sort_pathkeys, limit_tuples);
+
+            /*
+             * If the input already comes out ordered on a prefix of the sort
+             * keys, a bounded sort can stop reading once the top-N are known,
+             * see ExecSort.  Sort columns map one to one onto pathkeys unless
+             * duplicates were folded, in which case don't bother.
+             */
+            if (limit_tuples > 0 && result_plan->lefttree->dop <= 1 &&
+                ((Sort*)result_plan)->numCols == list_length(root->sort_pathkeys)) {
+                ((Sort*)result_plan)->numPresorted = pathkeys_common_prefix(root->sort_pathkeys, current_pathkeys);
+            }
 #ifdef PGXC
 #ifdef STREAMPLAN
             if (IS_STREAM_PLAN && check_sort_for_upsert(root))
@@ -7715,6 +7726,15 @@ static Plan* mark_top_agg(
     /* remove the skew opt from low layer agg, we only display the flag on top agg. */
     ((Agg*)agg_plan)->skew_optimize = SKEW_RES_NONE;
 
+    /*
+     * top_node groups the output of agg_plan again on the same keys, so the
+     * lower agg may return a group more than once (see SonicHashAgg).
+     */
+    if (IsA(top_node, Agg)) {
+        ((Agg*)agg_plan)->upper_combine = true;
+        ((Agg*)top_node)->upper_combine = false;
+    }
+
     // restore the lefttree pointer of original plan
     /* The having qual of second agg node is copied from first agg and has been processed to second agg expression.
      *  Remove having qual for the first aggregation.
@@ -9847,6 +9867,8 @@ static Plan* build_vector_plan(Plan* plan)
             break;
         case T_Sort:
             plan->type = T_VecSort;
+            /* the early stop on presorted input is a row engine feature */
+            ((Sort*)plan)->numPresorted = 0;
             break;
         case T_Material:
             plan->type = T_VecMaterial;
@@ -11784,6 +11806,8 @@ static Plan* get_count_distinct_partial_plan(PlannerInfo* root, Plan* result_pla
     }
     ((Agg*)result_plan)->is_final = false;
     ((Agg*)result_plan)->single_node = false;
+    /* this agg removes duplicates for count(distinct), its groups must be unique */
+    ((Agg*)result_plan)->upper_combine = false;
 
     /*
      * Make proper change of some property to final target list and having qual, actually referred by orig_tlist and
@@ -317,6 +317,7 @@ static Plan* set_plan_refs(PlannerInfo* root, Plan* plan, int rtoffset)
             if (splan->plan.distributed_keys != NIL) {
                 splan->plan.distributed_keys = fix_scan_list(root, splan->plan.distributed_keys, rtoffset);
             }
+            splan->plan.var_list = fix_scan_list(root, splan->plan.var_list, rtoffset);
             if (splan->tablesample) {
                 splan->tablesample = (TableSampleClause*)fix_scan_expr(root, (Node*)splan->tablesample, rtoffset);
             }
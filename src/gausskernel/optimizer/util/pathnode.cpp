@@ -6546,6 +6546,25 @@ static void set_replicate_parallel_info(bool is_replicate, Path* path, ParallelD
     }
 }
 
+/*
+ * @Description: Check whether a local broadcast of the hash join build side
+ *    would replicate a hash table that does not fit work memory. Every
+ *    consumer thread builds its own copy, so query_dop copies are kept at once.
+ * @param[IN] root: the plannerInfo for this join.
+ * @param[IN] inner_path: the inner subpath for join.
+ * @return bool: true if the replicated build side exceeds work memory.
+ */
+static bool local_broadcast_build_too_large(PlannerInfo* root, Path* inner_path)
+{
+    if (u_sess->opt_cxt.query_dop <= 1)
+        return false;
+
+    double inner_width = get_path_actual_total_width(inner_path, root->glob->vectorized, OP_HASHJOIN);
+    double copy_kb = PATH_LOCAL_ROWS(inner_path) * inner_width / 1024.0;
+
+    return copy_kb * u_sess->opt_cxt.query_dop > (double)u_sess->opt_cxt.op_work_mem;
+}
+
 /*
  * @Description:
  *    Create a parallel and unparallel join path when enable smp.
@@ -6681,9 +6700,18 @@ static List* add_join_parallel_path(StreamType inner_stream, StreamType outer_st
                     NIL);
                 joinpath_list = lappend(joinpath_list, (void*)joinpath);
             } else {
+                /*
+                 * A hash join whose build side can be local redistributed
+                 * should not replicate a large hash table into every thread,
+                 * the partitioned build of case 3 uses 1/dop of the memory.
+                 */
+                bool skip_broadcast_inner = nodetag == T_HashJoin && inner_can_local_distribute &&
+                                            outer_can_local_distribute &&
+                                            local_broadcast_build_too_large(root, inner_path);
+
                 /* There is 3 possible parallel path. */
                 /* case 1:local broadcast inner */
-                if (outer_path->pathtype != T_Unique && inner_path->pathtype != T_Unique &&
+                if (outer_path->pathtype != T_Unique && inner_path->pathtype != T_Unique && !skip_broadcast_inner &&
                     can_broadcast_inner(jointype, save_jointype, replicate_outer, NIL, NIL)) {
                     inner_smpDesc->distriType = LOCAL_BROADCAST;
                     if (outer_smpDesc->producerDop <= 1)
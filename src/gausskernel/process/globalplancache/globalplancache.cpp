@@ -433,8 +433,32 @@ void GlobalPlanCache::AddInvalidList(CachedPlanSource* plansource)
     LWLockRelease(GPCClearLock);
 }
 
+/*
+ * Free a shared plansource that is no longer reachable from the GPC hash
+ * tables or the invalid list and that nobody holds a reference on.
+ */
+static void GPCFreePlanSource(CachedPlanSource *plansource)
+{
+    DropCachedPlanInternal(plansource);
+    plansource->magic = 0;
+    MemoryContextUnSeal(plansource->context);
+    MemoryContextUnSeal(plansource->query_context);
+    if (plansource->opFusionObj) {
+        OpFusion::DropGlobalOpfusion((OpFusion*)(plansource->opFusionObj));
+    }
+    MemoryContextDelete(plansource->context);
+}
+
 void GlobalPlanCache::DropInvalid()
 {
+    List *dropped = NIL;
+    ListCell *lc = NULL;
+
+    /*
+     * Only unlink the unreferenced plansources while holding GPCClearLock, and
+     * free them after releasing it: deleting plan contexts takes a while, and
+     * every backend invalidating a plan has to wait for GPCClearLock.
+     */
     (void)LWLockAcquire(GPCClearLock, LW_EXCLUSIVE);
     if (m_invalid_list != NULL) {
         DListCell *cell = m_invalid_list->head;
@@ -445,14 +469,7 @@ void GlobalPlanCache::DropInvalid()
                 DListCell *next = cell->next;
                 GPC_LOG("drop invalid shared plancache", curr, curr->stmt_name);
                 m_invalid_list = dlist_delete_cell(m_invalid_list, cell, false);
-                DropCachedPlanInternal(curr);
-                curr->magic = 0;
-                MemoryContextUnSeal(curr->context);
-                MemoryContextUnSeal(curr->query_context);
-                if (curr->opFusionObj) {
-                    OpFusion::DropGlobalOpfusion((OpFusion*)(curr->opFusionObj));
-                }
-                MemoryContextDelete(curr->context);
+                dropped = lappend(dropped, curr);
 
                 cell = next;
             } else {
@@ -461,6 +478,11 @@ void GlobalPlanCache::DropInvalid()
         }
     }
     LWLockRelease(GPCClearLock);
+
+    foreach (lc, dropped) {
+        GPCFreePlanSource((CachedPlanSource *)lfirst(lc));
+    }
+    list_free_ext(dropped);
 }
 
 template<PlansourceInvalidAction action_type>
@@ -485,8 +507,8 @@ void GlobalPlanCache::RemovePlanSource(CachedPlanSource* plansource, const char*
         /* Has hold refcount for ACTION_RECREATE */
         if (action_type == ACTION_RECREATE)
             plansource->gpc.status.SubRefCount();
-        DropInvalid();
         LWLockRelease(GetMainLWLockByIndex(lock_id));
+        DropInvalid();
 
         if (ENABLE_DN_GPC) {
             u_sess->pcache_cxt.private_refcount--;
@@ -543,8 +565,8 @@ void GlobalPlanCache::RemoveEntry(uint32 htblIdx, GPCEntry *entry)
     hash_search(m_array[htblIdx].hash_tbl, (void *) &(entry->key), HASH_REMOVE, &found);
     Assert(found == true);
     m_array[htblIdx].count--;
+    /* the caller holds the bucket lock, it runs DropInvalid() once done */
     AddInvalidList(plansource);
-    DropInvalid();
 }
 
 
@@ -1024,8 +1046,8 @@ void GlobalPlanCache::RemovePlanCacheInSPIPlan(SPIPlanPtr plan)
                         AddInvalidList(plansource);
                     }
                     plansource->gpc.status.SubRefCount();
-                    DropInvalid();
                     LWLockRelease(GetMainLWLockByIndex(lock_id));
+                    DropInvalid();
                 } else {
                     plansource->gpc.status.SubRefCount();
                 }
@@ -1085,6 +1107,7 @@ void GlobalPlanCache::CleanUpByTime()
 
         /* Step 2: Try to remove plan cache */
         if (gpckey_list && list_length(gpckey_list) > 0) {
+            List *dropped = NIL;
             LWLockAcquire(GetMainLWLockByIndex(lock_id), LW_EXCLUSIVE);
             ListCell* l = NULL;
             foreach(l, gpckey_list) {
@@ -1098,16 +1121,10 @@ void GlobalPlanCache::CleanUpByTime()
                         INSTR_TIME_GET_DOUBLE(curTime) - INSTR_TIME_GET_DOUBLE(entry->val.last_use_time) >
                         u_sess->attr.attr_common.gpc_clean_timeout) {
                         GPC_LOG("drop shared plancache by time", cur_plansource, cur_plansource->stmt_name);
-                        DropCachedPlanInternal(cur_plansource);
                         hash_search(m_array[bucket_id].hash_tbl, (void *) key, HASH_REMOVE, &found);
-                        cur_plansource->magic = 0;
-                        MemoryContextUnSeal(cur_plansource->context);
-                        MemoryContextUnSeal(cur_plansource->query_context);
-                        if (cur_plansource->opFusionObj) {
-                            OpFusion::DropGlobalOpfusion((OpFusion*)(cur_plansource->opFusionObj));
-                        }
-                        MemoryContextDelete(cur_plansource->context);
                         m_array[bucket_id].count--;
+                        /* unreachable now, free it once the bucket lock is released */
+                        dropped = lappend(dropped, cur_plansource);
                     }
                 }
                 pfree((void *)key->query_string);
@@ -1118,6 +1135,10 @@ void GlobalPlanCache::CleanUpByTime()
             }
             LWLockRelease(GetMainLWLockByIndex(lock_id));
 
+            foreach(l, dropped) {
+                GPCFreePlanSource((CachedPlanSource *)lfirst(l));
+            }
+            list_free_ext(dropped);
             list_free_ext(gpckey_list);
         }
     }
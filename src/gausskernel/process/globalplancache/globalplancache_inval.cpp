@@ -108,6 +108,8 @@ void GlobalPlanCache::InvalMsg(const SharedInvalidationMessage *msgs, int n)
         return ;
     }
 
+    bool removed = false;
+
     /* Go through each bucket in the GPC HTAB and do some invalidation depending on the GPCInvalInfo we got.*/
     for (uint32 bucket_id = 0; bucket_id < GPC_NUM_OF_BUCKETS; bucket_id ++) {
         /* Ok so bucket is not empty. Get the bucket S-lock so we can iterate through it. */
@@ -140,6 +142,7 @@ void GlobalPlanCache::InvalMsg(const SharedInvalidationMessage *msgs, int n)
             /* Atomic read the number of CachedEnvironment in this entry */
             if(NeedDropEntryByLocalMsg(entry->val.plansource, tot, idx, msgs)) {
                 RemoveEntry(bucket_id, entry);
+                removed = true;
             }
         }
 
@@ -147,5 +150,10 @@ void GlobalPlanCache::InvalMsg(const SharedInvalidationMessage *msgs, int n)
         LWLockRelease(GetMainLWLockByIndex(lock_id));
     }
 
+    /* free what the invalidation dropped, outside of the bucket locks */
+    if (removed) {
+        DropInvalid();
+    }
+
     pfree_ext(idx);
 }
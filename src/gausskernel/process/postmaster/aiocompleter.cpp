@@ -49,6 +49,7 @@
 #include "storage/ipc.h"
 #include "storage/pmsignal.h"
 #include "utils/guc.h"
+#include "utils/log2hist.h"
 #include "utils/memutils.h"
 #include <pthread.h>
 
@@ -109,13 +110,24 @@ typedef struct AioCompltrDesc {
 
 } AioCompltrDesc_t;
 
+/*
+ * Request latency histogram of a completer: bucket i counts the requests that
+ * completed in [2^(i-1), 2^i) microseconds after io_submit(), the last bucket
+ * is open ended. Only the owning completer thread updates it.
+ */
+#define AIOCOMPLTR_LATENCY_BUCKETS 20
+
 typedef struct {
     io_context_t context;           /* AIO context */
     struct io_event* eventsp;       /* AIO events to process */
     ThreadId tid;                   /* AIO thread tid */
     AioCompltrDesc_t* compltrDescp; /* Completer descriptor */
+    uint64 latencyHist[AIOCOMPLTR_LATENCY_BUCKETS]; /* request latency histogram */
 } AioCompltrThread_t;
 
+static const char* const compltrTypeNames[NUM_AIOCOMPLTR_TYPES] = {
+    "CompltrReadReq", "CompltrWriteReq", "CompltrReadCUReq", "CompltrWriteCUReq"};
+
 /*
  * The compltrDescArray contains the description of the different types
  * of completer threads. These are used to setup the context for each
@@ -233,6 +245,38 @@ io_context_t CompltrContext(AioCompltrType reqType, int h)
     return compltrArray[AIOCOMPLTR_THREAD_IDX(reqType, h)].context;
 }
 
+/*
+ * @Description: Account the latency of one completed request in the completer histogram
+ * @Param[IN] compltr: the completer thread descriptor
+ * @Param[IN] submitTime: submit time carried in io_event.data, 0 if not stamped
+ * @Param[IN] now: current time in microseconds
+ * @See also: AioStampSubmitTime
+ */
+static inline void CompltrAccountLatency(AioCompltrThread_t* compltr, uint64 submitTime, uint64 now)
+{
+    if (submitTime == 0 || now < submitTime) {
+        return;
+    }
+    Log2HistAdd(compltr->latencyHist, AIOCOMPLTR_LATENCY_BUCKETS, now - submitTime);
+}
+
+/*
+ * @Description: Report the request latency histogram of a completer
+ * @Param[IN] compltrIdx: completer index
+ * @Param[IN] elevel: report level
+ * @See also:
+ */
+static void CompltrReportLatency(int compltrIdx, int elevel)
+{
+    AioCompltrThread_t* compltr = &compltrArray[compltrIdx];
+    char prefix[NAMEDATALEN * 2] = {0};
+
+    int rc = snprintf_s(prefix, sizeof(prefix), sizeof(prefix) - 1, "AIO Completer %d %s latency histogram(us)",
+        compltrIdx, compltrTypeNames[compltr->compltrDescp->reqtype]);
+    securec_check_ss(rc, "\0", "\0");
+    Log2HistReport(elevel, compltr->latencyHist, AIOCOMPLTR_LATENCY_BUCKETS, prefix);
+}
+
 /* Prototypes for private functions */
 /*
  * Signal handlers
@@ -552,6 +596,7 @@ void AioCompltrMain(int ac, char** av)
         if (t_thrd.aio_cxt.shutdown_requested) {
             timeout = shutdown_timeout;
 
+            CompltrReportLatency(compltrIdx, LOG);
             ereport(LOG, (errmsg("AIO Completer %d EXITED.", compltrIdx)));
             proc_exit(0);
         }
@@ -581,12 +626,23 @@ void AioCompltrMain(int ac, char** av)
 
         Assert(eventsReceived <= max_nr);
 
+        /* Nothing completed within the timeout, a good time to report latencies */
+        if (eventsReceived == 0) {
+            if (log_min_messages <= DEBUG1) {
+                CompltrReportLatency(compltrIdx, DEBUG1);
+            }
+            continue;
+        }
+
         /*
          * Call the callback for each event returned
          * We expect 0 to max_nr requests. The obj here is
-         * the I/O request and the db context.
+         * the I/O request and the db context. The latency is accounted
+         * first since the callback releases the request.
          */
+        uint64 now = AioRequestClock();
         for (struct io_event* eventp = eventsp; eventsReceived--; eventp++) {
+            CompltrAccountLatency(&compltrArray[compltrIdx], (uint64)(uintptr_t)eventp->data, now);
             callback((void*)eventp->obj, eventp->res);
         }
     }
@@ -922,6 +922,7 @@ static uint32 calculate_pagewriter_flush_num()
     static int64 total_flush_num = 0;
     static uint32 avg_flush_num = 0;
     static uint32 prev_lsn_num = 0;
+    static uint32 prev_flush_num = 0;
     static int counter = 0;
     XLogRecPtr target_lsn;
     XLogRecPtr cur_lsn;
@@ -1030,6 +1031,23 @@ static uint32 calculate_pagewriter_flush_num()
 
     flush_num = (avg_flush_num + num_for_dirty + num_for_lsn) / 3;
 
+    /*
+     * While neither the dirty page limit nor max_redo_log_size is reached,
+     * only go half way from the last decision, so that a burst of xlog does
+     * not turn into a flush storm followed by an idle period.  Past either
+     * limit, flush what was asked for at once.
+     */
+    if (dirty_percent <= 1 && lsn_target_percent < 1 && prev_flush_num != 0) {
+        flush_num = (flush_num + prev_flush_num) / 2;
+    }
+
+    if (u_sess->attr.attr_storage.log_pagewriter) {
+        ereport(LOG, (errmodule(MOD_INCRE_CKPT),
+            errmsg("calculate flush num, dirty_percent is %f, lsn_target_percent is %f, avg flush num is %u, "
+                   "num for dirty is %u, num for lsn is %u, flush num is %u",
+                   dirty_percent, lsn_target_percent, avg_flush_num, num_for_dirty, num_for_lsn, flush_num)));
+    }
+
 DEFAULT:
 
     if (flush_num > max_io) {
@@ -1037,6 +1055,7 @@ DEFAULT:
     } else if (flush_num < min_io) {
         flush_num  = min_io;
     }
+    prev_flush_num = flush_num;
 
     return flush_num;
 }
@@ -2305,7 +2324,7 @@ static uint32 get_candidate_buf_and_flush_list(uint32 start, uint32 end, uint32
             goto UNLOCK;
         }
 
-        check_usecount = NEED_CONSIDER_USECOUNT && BUF_STATE_GET_USAGECOUNT(local_buf_state) != 0;
+        check_usecount = CANDIDATE_CONSIDER_USECOUNT && BUF_STATE_GET_USAGECOUNT(local_buf_state) != 0;
         if (check_usecount) {
             local_buf_state -= BUF_USAGECOUNT_ONE;
             goto UNLOCK;
@@ -2354,6 +2373,14 @@ UNLOCK:
         ereport(LOG,
             (errmodule(MOD_INCRE_CKPT),
                 errmsg("get candidate buf %d, thread id is %d", candidates, thread_id)));
+        if (ENABLE_BUFFER_POLICY_2Q) {
+            ereport(LOG,
+                (errmodule(MOD_INCRE_CKPT),
+                    errmsg("2q replacement: get buf from list %lu, from clock sweep %lu, referenced buf spared %lu",
+                        g_instance.ckpt_cxt_ctl->get_buf_num_candidate_list,
+                        g_instance.ckpt_cxt_ctl->get_buf_num_clock_sweep,
+                        g_instance.ckpt_cxt_ctl->get_buf_num_usage_spared)));
+        }
     }
     return need_flush_num;
 }
@@ -2364,7 +2391,7 @@ static void push_to_candidate_list(BufferDesc *buf_desc)
     PageWriterProc *pgwr = &g_instance.ckpt_cxt_ctl->pgwr_procs.writer_proc[thread_id];
     int buf_id = buf_desc->buf_id;
     uint32 buf_state = pg_atomic_read_u32(&buf_desc->state);
-    bool emptyUsageCount = (!NEED_CONSIDER_USECOUNT || BUF_STATE_GET_USAGECOUNT(buf_state) == 0);
+    bool emptyUsageCount = (!CANDIDATE_CONSIDER_USECOUNT || BUF_STATE_GET_USAGECOUNT(buf_state) == 0);
 
     if (BUF_STATE_GET_REFCOUNT(buf_state) > 0 || !emptyUsageCount) {
         return;
@@ -2373,7 +2400,7 @@ static void push_to_candidate_list(BufferDesc *buf_desc)
     if (g_instance.ckpt_cxt_ctl->candidate_free_map[buf_id] == false) {
         buf_state = LockBufHdr(buf_desc);
         if (g_instance.ckpt_cxt_ctl->candidate_free_map[buf_id] == false) {
-            emptyUsageCount = (!NEED_CONSIDER_USECOUNT || BUF_STATE_GET_USAGECOUNT(buf_state) == 0);
+            emptyUsageCount = (!CANDIDATE_CONSIDER_USECOUNT || BUF_STATE_GET_USAGECOUNT(buf_state) == 0);
             if (BUF_STATE_GET_REFCOUNT(buf_state) == 0 && emptyUsageCount && !(buf_state & BM_DIRTY)) {
                 if (buf_id < NvmBufferStartID) {
                     candidate_buf_push(&pgwr->normal_list, buf_id);
@@ -999,6 +999,25 @@ void PotalSetIoState(Portal portal)
 
 }
 
+/*
+ * Adaptive plan selection learns from the time a candidate plan spends
+ * running.  Only time inside PortalRun/PortalRunFetch counts, not the gaps
+ * between fetches or the rest of the portal's lifetime.
+ */
+static inline bool PortalTracksRunTime(Portal portal)
+{
+    return portal->cplan != NULL && portal->cplan->cpi != NULL;
+}
+
+static inline void PortalAddRunTime(Portal portal, const instr_time* start)
+{
+    instr_time runTime;
+
+    INSTR_TIME_SET_CURRENT(runTime);
+    INSTR_TIME_SUBTRACT(runTime, *start);
+    portal->exec_usecs += INSTR_TIME_GET_MICROSEC(runTime);
+}
+
 /*
  * PortalRun
  *		Run a portal's query or queries.
@@ -1037,7 +1056,9 @@ bool PortalRun(
     MemoryContext savePortalContext;
     MemoryContext saveMemoryContext;
     errno_t errorno = EOK;
+    instr_time runStart;
 
+    INSTR_TIME_SET_ZERO(runStart);
     AssertArg(PortalIsValid(portal));
     AssertArg(PointerIsValid(portal->commandTag));
 
@@ -1079,6 +1100,11 @@ bool PortalRun(
      */
     MarkPortalActive(portal);
 
+    bool trackPlanTime = PortalTracksRunTime(portal);
+    if (trackPlanTime) {
+        INSTR_TIME_SET_CURRENT(runStart);
+    }
+
     QueryDesc* queryDesc = portal->queryDesc;
 
     if (IS_PGXC_DATANODE && queryDesc != NULL && (queryDesc->plannedstmt) != NULL &&
@@ -1246,6 +1272,10 @@ bool PortalRun(
     }
     PG_END_TRY();
 
+    if (trackPlanTime) {
+        PortalAddRunTime(portal, &runStart);
+    }
+
     u_sess->opt_cxt.nextval_default_expr_type = save_nextval_default_expr_type;
     u_sess->plsql_cxt.portal_depth = savePortalDepth;
     stp_reset_xact_state_and_err_msg(savedisAllowCommitRollback, needResetErrMsg);
@@ -2026,7 +2056,9 @@ long PortalRunFetch(Portal portal, FetchDirection fdirection, long count, DestRe
     ResourceOwner saveResourceOwner;
     MemoryContext savePortalContext;
     MemoryContext oldContext;
+    instr_time runStart;
 
+    INSTR_TIME_SET_ZERO(runStart);
     AssertArg(PortalIsValid(portal));
     Assert(portal->prepStmtName == NULL || portal->prepStmtName[0] == '\0');
 
@@ -2035,6 +2067,11 @@ long PortalRunFetch(Portal portal, FetchDirection fdirection, long count, DestRe
      */
     MarkPortalActive(portal);
 
+    bool trackPlanTime = PortalTracksRunTime(portal);
+    if (trackPlanTime) {
+        INSTR_TIME_SET_CURRENT(runStart);
+    }
+
     /* Disable early free when using cursor which may need rescan */
     bool saved_early_free = u_sess->attr.attr_sql.enable_early_free;
     u_sess->attr.attr_sql.enable_early_free = false;
@@ -2105,6 +2142,10 @@ long PortalRunFetch(Portal portal, FetchDirection fdirection, long count, DestRe
     }
     PG_END_TRY();
 
+    if (trackPlanTime) {
+        PortalAddRunTime(portal, &runStart);
+    }
+
     MemoryContextSwitchTo(oldContext);
 
     /* Mark portal not active */
@@ -227,6 +227,13 @@ bool IsStmtRetryCapable(StatementRetryController* controller, bool is_extend_que
                                 : controller->retry_times + 1;
         uint32 sleep_duration = 10000000L * sleep_level; /* 10000000L for 10s. */
 
+        /*
+         * Every session hit by the same failover gets here at about the same
+         * time.  Spread the wake-ups over an extra quarter of the wait, so they
+         * do not all hit the recovered node in the same instant.
+         */
+        sleep_duration += (uint32)(gs_random() % (sleep_duration / 4 + 1));
+
         TimestampTz start_time = GetCurrentTimestamp();
         SimpleLogToServer(LOG, false, "Try to wait for cluster recovery in %ld s.", sleep_duration / 1000000L);
 
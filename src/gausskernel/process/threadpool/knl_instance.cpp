@@ -141,6 +141,9 @@ static void knl_g_wal_init(knl_g_wal_context *const wal_cxt)
     wal_cxt->upgradeSwitchMode = NoDemote;
     wal_cxt->totalXlogIterBytes = 0;
     wal_cxt->totalXlogIterTimes = 0;
+    wal_cxt->flushLatencyAvg = 0;
+    wal_cxt->recordIntervalAvg = 0;
+    wal_cxt->lastBackgroundFlushTime = 0;
     wal_cxt->xlogFlushStats = NULL;
 }
 
@@ -437,6 +440,8 @@ static void KnlGUndoInit(knl_g_undo_context *undoCxt)
     undoCxt->uZoneCount = 0;
     undoCxt->maxChainSize = 0;
     undoCxt->undoChainTotalSize = 0;
+    undoCxt->undoGrowthRate = 0;
+    undoCxt->undoExhaustSeconds = -1;
     undoCxt->globalFrozenXid = InvalidTransactionId;
     undoCxt->globalRecycleXid = InvalidTransactionId;
 }
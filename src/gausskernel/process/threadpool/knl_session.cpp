@@ -519,6 +519,8 @@ static void knl_u_plancache_init(knl_u_plancache_context* pcache_cxt)
     pcache_cxt->action = NULL;
     pcache_cxt->explored_plan_info = NULL;
     pcache_cxt->generic_roots = NULL;
+    pcache_cxt->matched_plan = NULL;
+    pcache_cxt->matched_region = 0;
 }
 
 static void knl_u_typecache_init(knl_u_typecache_context* tycache_cxt)
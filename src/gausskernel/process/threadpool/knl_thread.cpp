@@ -287,6 +287,8 @@ static void knl_t_xact_init(knl_t_xact_context* xact_cxt)
     xact_cxt->cachedFetchXid = InvalidTransactionId;
     xact_cxt->cachedFetchXidStatus = 0;
     xact_cxt->cachedCommitLSN = 0;
+    rc = memset_s(xact_cxt->xidStatusCache, sizeof(xact_cxt->xidStatusCache), 0, sizeof(xact_cxt->xidStatusCache));
+    securec_check(rc, "\0", "\0");
 
     /* init var in multixact.cpp */
     xact_cxt->MXactCache = NULL;
@@ -1488,6 +1490,8 @@ static void knl_t_walsender_init(knl_t_walsender_context* walsender_cxt)
     walsender_cxt->advancePrimaryConn = NULL;
     walsender_cxt->xlogReadBuf = NULL;
     walsender_cxt->compressBuf = NULL;
+    walsender_cxt->compressSkip = 0;
+    walsender_cxt->compressBackoff = 1;
     walsender_cxt->ep_fd = -1;
     walsender_cxt->datafd = -1;
     walsender_cxt->is_obsmode = false;
@@ -88,6 +88,10 @@ ThreadPoolGroup::ThreadPoolGroup(int maxWorkerNum, int expectWorkerNum, int maxS
 
     m_streams = NULL;
     m_freeStreamList = NULL;
+    INSTR_TIME_SET_ZERO(m_current_time);
+    m_sessionId = 0;
+    INSTR_TIME_SET_ZERO(m_criticalTime);
+    m_criticalSessionId = 0;
 }
 
 ThreadPoolGroup::~ThreadPoolGroup()
@@ -226,6 +230,9 @@ void ThreadPoolGroup::GetThreadPoolGroupStat(ThreadPoolStat* stat)
             m_sessionCount, m_waitServeSessionCount,
             runSessionNum, idleSessionNum);
     securec_check_ss(rc, "", "");
+    if (m_listener != NULL) {
+        m_listener->GetQueueWaitStat(stat->sessionInfo + rc, STATUS_INFO_SIZE - rc);
+    }
 
     if (IS_PGXC_DATANODE) {
         rc = sprintf_s(stat->streamInfo, STATUS_INFO_SIZE,
@@ -378,7 +385,7 @@ bool ThreadPoolGroup::IsGroupHang()
         m_idleWorkerNum != 0)
         return false;
 
-    bool ishang = m_listener->GetSessIshang(&m_current_time, &m_sessionId);
+    bool ishang = m_listener->GetSessIshang(&m_current_time, &m_sessionId, &m_criticalTime, &m_criticalSessionId);
     return ishang;
 }
 
@@ -116,6 +116,13 @@ ThreadPoolListener::ThreadPoolListener(ThreadPoolGroup* group)
     m_freeWorkerList = New(CurrentMemoryContext) DllistWithLock();
     m_readySessionList = New(CurrentMemoryContext) DllistWithLock();
     m_idleSessionList = New(CurrentMemoryContext) DllistWithLock();
+    m_criticalSessionList = New(CurrentMemoryContext) DllistWithLock();
+    m_criticalServed = 0;
+    for (int i = 0; i < TP_LATENCY_CLASS_NUM; i++) {
+        for (int j = 0; j < TP_QUEUE_WAIT_BUCKETS; j++) {
+            m_queueWait[i][j] = 0;
+        }
+    }
 
     if (EnableLocalSysCache()) {
         /* see HASH_INDEX, Since the hash table must contain a power-of-2 number of elements */
@@ -153,6 +160,7 @@ ThreadPoolListener::~ThreadPoolListener()
     m_freeWorkerList = NULL;
     m_readySessionList = NULL;
     m_idleSessionList = NULL;
+    m_criticalSessionList = NULL;
 
     if (EnableLocalSysCache()) {
         pfree_ext(m_session_bucket);
@@ -258,6 +266,8 @@ bool ThreadPoolListener::TryFeedWorker(ThreadPoolWorker* worker)
         pg_atomic_fetch_sub_u32((volatile uint32*)&m_group->m_waitServeSessionCount, 1);
         pg_atomic_fetch_add_u32((volatile uint32*)&m_group->m_processTaskCount, 1);
         return true;
+    } else if (TryStealSession(worker)) {
+        return true;
     } else {
         if (EnableLocalSysCache()) {
             LocalSysDBCache *lsc = worker->GetThreadContextPtr()->lsc_cxt.lsc;
@@ -274,6 +284,57 @@ bool ThreadPoolListener::TryFeedWorker(ThreadPoolWorker* worker)
     }
 }
 
+/*
+ * Our group has nothing ready, so let the worker serve a sibling group whose
+ * ready list is backing up while none of its own workers are free.  Running a
+ * session on another NUMA node than the one its memory came from costs, so we
+ * only steal once at least thread_pool_steal_threshold sessions are waiting
+ * there, and we pick the group that is furthest behind.  The session goes
+ * back to its own listener when the worker is done with it.
+ */
+bool ThreadPoolListener::TryStealSession(ThreadPoolWorker* worker)
+{
+    int threshold = g_instance.attr.attr_common.thread_pool_steal_threshold;
+    int groupNum = g_threadPoolControler->GetGroupNum();
+    ThreadPoolGroup* victim = NULL;
+    int maxWait = 0;
+
+    if (threshold <= 0 || groupNum <= 1 || m_reaperAllSession) {
+        return false;
+    }
+
+    for (int i = 0; i < groupNum; i++) {
+        ThreadPoolGroup* group = g_threadPoolControler->GetGroup(i);
+        if (group == NULL || group == m_group || group->m_listener == NULL ||
+            group->m_listener->m_reaperAllSession || group->m_idleWorkerNum > 0) {
+            continue;
+        }
+        if (group->m_waitServeSessionCount >= threshold && group->m_waitServeSessionCount > maxWait) {
+            maxWait = group->m_waitServeSessionCount;
+            victim = group;
+        }
+    }
+
+    if (victim == NULL) {
+        return false;
+    }
+
+    Dlelem* sc = victim->m_listener->GetReadySession(worker);
+    if (sc == NULL) {
+        return false;
+    }
+
+    knl_session_context* session = (knl_session_context*)sc->dle_val;
+    worker->SetSession(session, victim->m_listener);
+    pg_atomic_fetch_sub_u32((volatile uint32*)&victim->m_waitServeSessionCount, 1);
+    pg_atomic_fetch_add_u32((volatile uint32*)&victim->m_processTaskCount, 1);
+    ereport(DEBUG2,
+            (errmodule(MOD_THREAD_POOL),
+                errmsg("%s worker of group %d takes session:%lu from group %d",
+                       __func__, m_group->GetGroupId(), session->session_id, victim->GetGroupId())));
+    return true;
+}
+
 void ThreadPoolListener::AddNewSession(knl_session_context* session)
 {
     AddEpoll(session);
@@ -314,10 +375,10 @@ void ThreadPoolListener::ReaperAllSession()
                         " encounter FATAL problems before session close.")));
             abort();
         }
-        /* m_sessionCount should be sum of the list length of m_idleSessionList and m_readySessionList
-           and worker's attached session */
+        /* m_sessionCount should be sum of the list length of m_idleSessionList, m_readySessionList,
+           m_criticalSessionList and worker's attached session */
         pg_memory_barrier();
-        if (m_idleSessionList->IsEmpty() && m_readySessionList->IsEmpty() &&
+        if (m_idleSessionList->IsEmpty() && m_readySessionList->IsEmpty() && m_criticalSessionList->IsEmpty() &&
             m_group->m_workerNum - m_group->m_idleWorkerNum == 0) {
             ereport(WARNING, (errmsg("SessionCount should be zero when no session in this group.")));
             m_group->m_sessionCount = 0;
@@ -489,14 +550,18 @@ void ThreadPoolListener::RemoveWorkerFromList(ThreadPoolWorker* worker)
     m_freeWorkerList->Remove(&worker->m_elem);
 }
 
-bool ThreadPoolListener::GetSessIshang(instr_time* current_time, uint64* sessionId)
+/*
+ * A list is stuck when its head is still the session seen there last time;
+ * remember the current head for the next check otherwise.
+ */
+bool ThreadPoolListener::ListHeadIsStuck(DllistWithLock* list, instr_time* current_time, uint64* sessionId)
 {
     bool ishang = true;
-    m_readySessionList->GetLock();
+    list->GetLock();
 
-    Dlelem* elem = m_readySessionList->GetHead();
+    Dlelem* elem = list->GetHead();
     if (elem == NULL) {
-        m_readySessionList->ReleaseLock();
+        list->ReleaseLock();
         return false;
     }
     knl_session_context* head_sess = (knl_session_context *)(elem->dle_val);
@@ -508,10 +573,22 @@ bool ThreadPoolListener::GetSessIshang(instr_time* current_time, uint64* session
         *sessionId = head_sess->session_id;
         ishang = false;
     }
-    m_readySessionList->ReleaseLock();
+    list->ReleaseLock();
     return ishang;
 }
 
+/*
+ * Latency-critical sessions wait on their own list, so the group hangs when
+ * the head of either list has not moved since the last check.
+ */
+bool ThreadPoolListener::GetSessIshang(instr_time* current_time, uint64* sessionId,
+    instr_time* criticalTime, uint64* criticalId)
+{
+    bool readyHang = ListHeadIsStuck(m_readySessionList, current_time, sessionId);
+    bool criticalHang = ListHeadIsStuck(m_criticalSessionList, criticalTime, criticalId);
+    return readyHang || criticalHang;
+}
+
 Dlelem *ThreadPoolListener::GetFreeWorker(knl_session_context* session)
 {
     /* only lite mode need find right threadworker, 
@@ -603,14 +680,84 @@ Dlelem *ThreadPoolListener::GetSessFromReadySessionList(ThreadPoolWorker *worker
     return elt;
 }
 
+/*
+ * Take the next latency-critical session, unless thread_pool_latency_weight
+ * of them have been served in a row while other sessions are waiting too;
+ * then return NULL once so that batch work behind them still moves.  With
+ * force, don't hold back.
+ */
+Dlelem *ThreadPoolListener::GetCriticalSession(bool force)
+{
+    if (m_criticalSessionList->IsEmpty()) {
+        return NULL;
+    }
+    if (!force && m_criticalServed >= (uint32)g_instance.attr.attr_common.thread_pool_latency_weight &&
+        !m_readySessionList->IsEmpty()) {
+        m_criticalServed = 0;
+        return NULL;
+    }
+
+    Dlelem *elt = m_criticalSessionList->RemoveHead();
+    if (elt != NULL) {
+        pg_atomic_add_fetch_u32(&m_criticalServed, 1);
+        CountQueueWait(elt, TP_LATENCY_CRITICAL);
+    }
+    return elt;
+}
+
+/* Account how long the session waited in the ready list for a worker */
+void ThreadPoolListener::CountQueueWait(Dlelem *elt, ThreadPoolLatencyClass latencyClass)
+{
+    knl_session_context *session = (knl_session_context *)DLE_VAL(elt);
+    instr_time waited;
+    int bucket = 0;
+
+    INSTR_TIME_SET_CURRENT(waited);
+    INSTR_TIME_SUBTRACT(waited, session->last_access_time);
+    for (uint64 limit = 1000; bucket < TP_QUEUE_WAIT_BUCKETS - 1; bucket++, limit *= 10) {
+        if (INSTR_TIME_GET_MICROSEC(waited) < limit) {
+            break;
+        }
+    }
+    (void)pg_atomic_fetch_add_u64(&m_queueWait[latencyClass][bucket], 1);
+}
+
+void ThreadPoolListener::GetQueueWaitStat(char* buf, int len)
+{
+    const char* className[TP_LATENCY_CLASS_NUM] = {"normal", "critical"};
+    int used = 0;
+
+    buf[0] = '\0';
+    for (int i = 0; i < TP_LATENCY_CLASS_NUM && used < len; i++) {
+        int rc = snprintf_s(buf + used, len - used, len - used - 1,
+            " %s wait(ms) <1: %lu <10: %lu <100: %lu <1000: %lu >=1000: %lu", className[i],
+            m_queueWait[i][0], m_queueWait[i][1], m_queueWait[i][2], m_queueWait[i][3], m_queueWait[i][4]);
+        if (rc < 0) {
+            break;
+        }
+        used += rc;
+    }
+}
+
 Dlelem *ThreadPoolListener::GetReadySession(ThreadPoolWorker *worker)
 {
+    Dlelem *elt = GetCriticalSession(false);
+    if (elt != NULL) {
+        return elt;
+    }
+
     if (!EnableLocalSysCache()) {
-        return m_readySessionList->RemoveHead();
+        elt = m_readySessionList->RemoveHead();
+    } else {
+        elt = GetSessFromReadySessionList(worker);
     }
-    Dlelem *elt = GetSessFromReadySessionList(worker);
     if (elt == NULL) {
-        return NULL;
+        /* we may have held back a critical session for a batch one that is gone meanwhile */
+        return GetCriticalSession(true);
+    }
+    CountQueueWait(elt, TP_LATENCY_NORMAL);
+    if (!EnableLocalSysCache()) {
+        return elt;
     }
     knl_session_context *session = (knl_session_context *)DLE_VAL(elt);
     if (session->status == KNL_SESS_UNINIT) {
@@ -629,6 +776,10 @@ Dlelem *ThreadPoolListener::GetReadySession(ThreadPoolWorker *worker)
 
 void ThreadPoolListener::AddIdleSessionToTail(knl_session_context* session)
 {
+    if (session->attr.attr_common.session_latency_critical) {
+        m_criticalSessionList->AddTail(&session->elem);
+        return;
+    }
     if (!EnableLocalSysCache()) {
         m_readySessionList->AddTail(&session->elem);
         return;
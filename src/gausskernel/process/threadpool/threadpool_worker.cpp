@@ -82,6 +82,7 @@ ThreadPoolWorker::ThreadPoolWorker(uint idx, ThreadPoolGroup* group, pthread_mut
     m_tid = InvalidTid;
     m_threadStatus = THREAD_UNINIT;
     m_currentSession = NULL;
+    m_sessionListener = NULL;
     m_mutex = mutex;
     m_cond = cond;
     m_waitState = STATE_WAIT_UNDEFINED;
@@ -257,6 +258,7 @@ bool ThreadPoolWorker::WakeUpToWork(knl_session_context* session)
     pthread_mutex_lock(m_mutex);
     if (likely(m_threadStatus != THREAD_EXIT && m_threadStatus != THREAD_PENDING)) {
         m_currentSession = session;
+        m_sessionListener = NULL;
         pthread_cond_signal(m_cond);
     } else {
         succ = false;
@@ -265,6 +267,16 @@ bool ThreadPoolWorker::WakeUpToWork(knl_session_context* session)
     return succ;
 }
 
+/*
+ * The listener the current session came from.  That is our own group's
+ * listener unless the session was stolen from a sibling group, and the
+ * session has to go back there so the group's accounting stays right.
+ */
+ThreadPoolListener* ThreadPoolWorker::GetSessionListener()
+{
+    return (m_sessionListener != NULL) ? m_sessionListener : m_group->GetListener();
+}
+
 void ThreadPoolWorker::WakeUpToUpdate(ThreadStatus status)
 {
     pthread_mutex_lock(m_mutex);
@@ -571,7 +583,7 @@ void ThreadPoolWorker::DetachSessionFromThread()
     m_currentSession->attachPid = (ThreadId)-1;
 
     /* should restore the data before return to listener. */
-    m_group->GetListener()->AddEpoll(m_currentSession);
+    GetSessionListener()->AddEpoll(m_currentSession);
     m_currentSession = NULL;
     u_sess = NULL;
 }
@@ -716,7 +728,7 @@ void ThreadPoolWorker::CleanUpSession(bool threadexit)
         }
 
         /* Close Session. */
-        m_group->GetListener()->DelSessionFromEpoll(m_currentSession);
+        GetSessionListener()->DelSessionFromEpoll(m_currentSession);
 
         if (m_currentSession->proc_cxt.PassConnLimit) {
             SpinLockAcquire(&g_instance.conn_cxt.ConnCountLock);
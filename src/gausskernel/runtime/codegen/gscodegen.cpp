@@ -285,6 +285,42 @@ bool GsCodeGen::CheckPreloadModule(llvm::Module* mod)
     return true;
 }
 
+/*
+ * The IR file is the same for every statement of the process, keep its
+ * content around instead of reading it from disk each time a module is
+ * created.  Only accessed while holding LLVMParseIRLock.
+ */
+static MemoryBuffer* cached_ir_file_buffer = NULL;
+static char* cached_ir_file_path = NULL;
+
+static const MemoryBuffer* GetIRFileBuffer(const char* filename)
+{
+    if (cached_ir_file_buffer != NULL && strcmp(cached_ir_file_path, filename) == 0) {
+        return cached_ir_file_buffer;
+    }
+
+    ErrorOr<std::unique_ptr<MemoryBuffer>> fileOrErr = MemoryBuffer::getFile(filename);
+    if (std::error_code fileErr = fileOrErr.getError()) {
+        ereport(LOG,
+            (errmodule(MOD_LLVM),
+                errmsg("Failed to get file:%s because of %s.", filename, fileErr.message().c_str())));
+        return NULL;
+    }
+
+    char* path = strdup(filename);
+    if (path == NULL) {
+        ereport(LOG, (errmodule(MOD_LLVM), errmsg("Failed to cache IR file:%s, out of memory.", filename)));
+        return NULL;
+    }
+
+    /* replace the cached file only when a different one is asked for */
+    delete cached_ir_file_buffer;
+    free(cached_ir_file_path);
+    cached_ir_file_buffer = fileOrErr->release();
+    cached_ir_file_path = path;
+    return cached_ir_file_buffer;
+}
+
 bool GsCodeGen::parseIRFile(StringInfo filename)
 {
     llvm::Module* m_module = NULL;
@@ -296,15 +332,14 @@ bool GsCodeGen::parseIRFile(StringInfo filename)
     LLVM_TRY()
     {
         /*
-         * Loads an LLVM module. file should be the local path to the LLVM bitcode file.
+         * Loads an LLVM module. file should be the local path to the LLVM bitcode file,
+         * whose content is read only once per process, see GetIRFileBuffer.
          */
-        ErrorOr<std::unique_ptr<MemoryBuffer>> fileOrErr = MemoryBuffer::getFile(filename->data);
-        if (std::error_code fileErr = fileOrErr.getError()) {
-            ereport(LOG,
-                (errmodule(MOD_LLVM),
-                    errmsg("Failed to get file:%s because of %s.",
-                        filename->data,
-                        fileOrErr.getError().message().c_str())));
+        Assert(m_llvmContext != NULL);
+        LWLockAcquire(LLVMParseIRLock, LW_EXCLUSIVE);
+        const MemoryBuffer* irBuffer = GetIRFileBuffer(filename->data);
+        if (irBuffer == NULL) {
+            LWLockRelease(LLVMParseIRLock);
             return false;
         }
 
@@ -313,13 +348,10 @@ bool GsCodeGen::parseIRFile(StringInfo filename)
 
         /*
          * Loads an LLVM module, the ir file is a reference to a memory buffer containing
-         * LLVM bitcode. To avoid memory leak, we should use to memory alloced at the
-         * begenning.
+         * LLVM bitcode. The module does not keep a reference to the buffer once it is
+         * fully parsed.
          */
-        Assert(m_llvmContext != NULL);
-        LWLockAcquire(LLVMParseIRLock, LW_EXCLUSIVE);
-        Expected<std::unique_ptr<Module>> moduleOrErr =
-            parseBitcodeFile(fileOrErr->get()->getMemBufferRef(), *(m_llvmContext));
+        Expected<std::unique_ptr<Module>> moduleOrErr = parseBitcodeFile(irBuffer->getMemBufferRef(), *(m_llvmContext));
         LWLockRelease(LLVMParseIRLock);
 
         if (Error moduleErr = moduleOrErr.takeError()) {
@@ -397,6 +429,15 @@ void GsCodeGen::compileCurrentModule(bool enable_jitcache)
         return;
     }
 
+    /*
+     * The IR file may have been loaded by a node whose codegen gave up later.
+     * With no function waiting for machine code, optimizing and compiling the
+     * whole module is pure overhead, releaseResource drops the module.
+     */
+    if (m_machineCodeJitCompiled == NIL) {
+        return;
+    }
+
     MemoryContext oldContext = MemoryContextSwitchTo(m_codeGenContext);
     llvm::Module* module = m_currentModule;
 
@@ -423,7 +423,6 @@ void VecHashAggCodeGen::HashAggCodeGen(VecAggState* node)
     llvm::Function* jitted_vechashing = NULL;
     llvm::Function* jitted_vecsglhashing = NULL;
     llvm::Function* jitted_vecbatchagg = NULL;
-    llvm::Function* jitted_SortAggMatchKey = NULL;
 
     /*
      * For aggregation, if economy is too small, which means number of distinct
@@ -449,13 +448,6 @@ void VecHashAggCodeGen::HashAggCodeGen(VecAggState* node)
     if (NULL != jitted_vecbatchagg)
         llvmCodeGen->addFunctionToMCJit(jitted_vecbatchagg, reinterpret_cast<void**>(&(node->jitted_batchagg)));
 
-    /* Codegeneration for sortagg */
-    jitted_SortAggMatchKey = dorado::VecSortCodeGen::SortAggMatchKeyCodeGen(node);
-    node->jitted_SortAggMatchKey = NULL;
-    if (NULL != jitted_SortAggMatchKey)
-        llvmCodeGen->addFunctionToMCJit(
-            jitted_SortAggMatchKey, reinterpret_cast<void**>(&(node->jitted_SortAggMatchKey)));
-
     /* Codegenration for targetlist of aggregation */
     llvm::Function* jitted_vectarget = NULL;
     jitted_vectarget = dorado::VecExprCodeGen::TargetListCodeGen(node->ss.ps.targetlist, (PlanState*)node);
@@ -3789,6 +3789,19 @@ llvm::Function* VecSortCodeGen::SortAggMatchKeyCodeGen(VecAggState* node)
     llvmCodeGen->FinalizeFunction(jitted_matchkey, node->ss.ps.plan->plan_node_id);
     return jitted_matchkey;
 }
+
+void VecSortCodeGen::SortAggCodeGen(VecAggState* node)
+{
+    Assert(NULL != (GsCodeGen*)t_thrd.codegen_cxt.thr_codegen_obj);
+    GsCodeGen* llvmCodeGen = (GsCodeGen*)t_thrd.codegen_cxt.thr_codegen_obj;
+
+    /* Codegeneration for match_key in SortAggRunner::BatchMatchAndAgg */
+    llvm::Function* jitted_SortAggMatchKey = SortAggMatchKeyCodeGen(node);
+    node->jitted_SortAggMatchKey = NULL;
+    if (NULL != jitted_SortAggMatchKey)
+        llvmCodeGen->addFunctionToMCJit(
+            jitted_SortAggMatchKey, reinterpret_cast<void**>(&(node->jitted_SortAggMatchKey)));
+}
 }  // namespace dorado
 
 /*
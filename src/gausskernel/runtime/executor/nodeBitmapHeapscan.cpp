@@ -1291,7 +1291,11 @@ void BitmapHeapPrefetchNext(
         Oid oldOid = GPIGetCurrPartOid(node->gpi_scan);
         int2 oldBktId = cbi_get_current_bucketid(node->cbi_scan);
         Relation oldheap = NULL;
-        
+        /* run of consecutive blocks of the same relation not yet handed to the kernel */
+        Relation run_rel = NULL;
+        BlockNumber run_start = InvalidBlockNumber;
+        BlockNumber run_len = 0;
+
         while (node->prefetch_pages < node->prefetch_target) {
             TBMIterateResult* tbmpre = tbm_iterate(*prefetch_iterator);
             Relation prefetchRel = scan->rs_rd;
@@ -1311,8 +1315,16 @@ void BitmapHeapPrefetchNext(
                 continue;
             }
 
-            /* For posix_fadvise() we just send the one request */
-            PrefetchBuffer(prefetchRel, MAIN_FORKNUM, tbmpre->blockno);
+            /* Coalesce consecutive blocks so that posix_fadvise() is called once per run */
+            if (prefetchRel != run_rel || tbmpre->blockno != run_start + run_len) {
+                if (run_len > 0) {
+                    PrefetchBufferRange(run_rel, MAIN_FORKNUM, run_start, run_len);
+                }
+                run_rel = prefetchRel;
+                run_start = tbmpre->blockno;
+                run_len = 0;
+            }
+            run_len++;
             if (RelationIsValid(oldheap) && oldheap != prefetchRel && PointerIsValid(hpscan) &&
                 oldheap != hpscan->currBktRel) {
                 /* release previous bucket fake relation except the current scanning one */
@@ -1322,6 +1334,10 @@ void BitmapHeapPrefetchNext(
             oldheap = prefetchRel;
         }
 
+        if (run_len > 0) {
+            PrefetchBufferRange(run_rel, MAIN_FORKNUM, run_start, run_len);
+        }
+
         if (RelationIsValid(oldheap) && PointerIsValid(hpscan) && oldheap != hpscan->currBktRel) {
             /* release previous bucket fake relation except the current scanning one */
             bucketCloseRelation(oldheap);
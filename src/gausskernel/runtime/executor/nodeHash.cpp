@@ -54,8 +54,36 @@ static void ExecHashBuildSkewHash(HashJoinTable hashtable, Hash* node, int mcvsT
 static void ExecHashSkewTableInsert(HashJoinTable hashtable, TupleTableSlot* slot, uint32 hashvalue, int bucketNumber);
 static void ExecHashRemoveNextSkewBucket(HashJoinTable hashtable);
 static void ExecHashIncreaseBuckets(HashJoinTable hashtable);
+static void ExecHashFilterCreate(HashJoinTable hashtable, int log2_nbuckets);
+static void ExecHashFilterRelease(HashJoinTable hashtable);
+static bool ExecHashFilterReject(HashJoinTable hashtable, uint32 hashvalue);
 
 static void* dense_alloc(HashJoinTable hashtable, Size size);
+
+/*
+ * The hash filter only pays off once the bucket array no longer fits in the
+ * CPU caches; it takes 2^HASH_FILTER_BITS_LOG2 bits per bucket.  After
+ * HASH_FILTER_SAMPLE probes it is dropped unless it rejected at least
+ * HASH_FILTER_MIN_REJECT_RATIO of them.
+ */
+#define HASH_FILTER_MIN_BUCKETS (1 << 16)
+#define HASH_FILTER_BITS_LOG2 3
+#define HASH_FILTER_SAMPLE 4096
+#define HASH_FILTER_MIN_REJECT_RATIO 0.05
+
+#define HASH_FILTER_BYTES(nbuckets) ((((Size)(nbuckets)) << HASH_FILTER_BITS_LOG2) / BITS_PER_BYTE)
+
+/*
+ * The bucket number is taken from the low-order bits of the hash value, so
+ * mix all of them into the high-order bits before picking the filter bit.
+ */
+#define HASH_FILTER_BIT(hashtable, hashvalue) (((hashvalue) * 0x9E3779B1U) >> (hashtable)->hashFilterShift)
+
+#define HASH_FILTER_ADD(hashtable, hashvalue)                                                  \
+    do {                                                                                       \
+        uint32 _bit = HASH_FILTER_BIT(hashtable, hashvalue);                                   \
+        (hashtable)->hashFilter[_bit >> 6] |= ((uint64)1) << (_bit & 63);                      \
+    } while (0)
 /* ----------------------------------------------------------------
  *		ExecHash
  *
@@ -351,6 +379,13 @@ HashJoinTable ExecHashTableCreate(Hash* node, List* hashOperators, bool keepNull
     hashtable->maxMem = max_mem * 1024L;
     hashtable->spreadNum = 0;
 
+    hashtable->hashFilter = NULL;
+    hashtable->hashFilterSize = 0;
+    hashtable->hashFilterShift = 0;
+    hashtable->hashFilterEnabled = true;
+    hashtable->hashFilterProbes = 0;
+    hashtable->hashFilterRejects = 0;
+
     /*
      * Get info about the hash functions to be used for each hash key. Also
      * remember whether the join operators are strict.
@@ -417,6 +452,7 @@ HashJoinTable ExecHashTableCreate(Hash* node, List* hashOperators, bool keepNull
     MemoryContextSwitchTo(hashtable->batchCxt);
 
     hashtable->buckets = (HashJoinTuple*)palloc0(nbuckets * sizeof(HashJoinTuple));
+    ExecHashFilterCreate(hashtable, log2_nbuckets);
 
     /*
      * Set up for skew optimization, if possible and there's a need for more
@@ -1009,6 +1045,10 @@ static void ExecHashIncreaseNumBatches(HashJoinTable hashtable)
         0,
         sizeof(HashJoinTuple) * hashtable->nbuckets);
     securec_check(rc, "\0", "\0");
+    if (hashtable->hashFilter != NULL) {
+        rc = memset_s(hashtable->hashFilter, hashtable->hashFilterSize, 0, hashtable->hashFilterSize);
+        securec_check(rc, "\0", "\0");
+    }
     oldchunks = hashtable->chunks;
     hashtable->chunks = NULL;
 
@@ -1038,6 +1078,9 @@ static void ExecHashIncreaseNumBatches(HashJoinTable hashtable)
                 /* and add it back to the appropriate bucket */
                 copyTuple->next = hashtable->buckets[bucketno];
                 hashtable->buckets[bucketno] = copyTuple;
+                if (hashtable->hashFilter != NULL) {
+                    HASH_FILTER_ADD(hashtable, copyTuple->hashvalue);
+                }
             } else {
                 /* dump it out */
                 Assert(batchno > curbatch);
@@ -1129,6 +1172,9 @@ void ExecHashTableInsert(
         /* Push it onto the front of the bucket's list */
         hashTuple->next = hashtable->buckets[bucketno];
         hashtable->buckets[bucketno] = hashTuple;
+        if (hashtable->hashFilter != NULL) {
+            HASH_FILTER_ADD(hashtable, hashvalue);
+        }
 
         /* Record the total width and total tuples for first batch until spill */
         if (hashtable->width[0] >= 0) {
@@ -1357,8 +1403,12 @@ bool ExecScanHashBucket(HashJoinState* hjstate, ExprContext* econtext)
         hashTuple = hashTuple->next;
     else if (hjstate->hj_CurSkewBucketNo != INVALID_SKEW_BUCKET_NO)
         hashTuple = hashtable->skewBucket[hjstate->hj_CurSkewBucketNo]->tuples;
-    else
+    else {
+        /* the filter can tell us the bucket holds no match without reading it */
+        if (hashtable->hashFilter != NULL && ExecHashFilterReject(hashtable, hashvalue))
+            return false;
         hashTuple = hashtable->buckets[hjstate->hj_CurBucketNo];
+    }
 
     while (hashTuple != NULL) {
         if (hashTuple->hashvalue == hashvalue) {
@@ -1496,7 +1546,11 @@ void ExecHashTableReset(HashJoinTable hashtable)
     /* Reallocate and reinitialize the hash bucket headers. */
     hashtable->buckets = (HashJoinTuple*)palloc0(nbuckets * sizeof(HashJoinTuple));
 
+    /* the old filter went away with the context */
+    hashtable->hashFilter = NULL;
+    hashtable->hashFilterSize = 0;
     hashtable->spaceUsed = 0;
+    ExecHashFilterCreate(hashtable, hashtable->log2_nbuckets);
 
     MemoryContextSwitchTo(oldcxt);
 
@@ -1838,6 +1892,9 @@ static void ExecHashRemoveNextSkewBucket(HashJoinTable hashtable)
             /* Move the tuple to the main hash table */
             hashTuple->next = hashtable->buckets[bucketno];
             hashtable->buckets[bucketno] = hashTuple;
+            if (hashtable->hashFilter != NULL) {
+                HASH_FILTER_ADD(hashtable, hashvalue);
+            }
             /* We have reduced skew space, but overall space doesn't change */
             hashtable->spaceUsedSkew -= tupleSize;
         } else {
@@ -1923,6 +1980,12 @@ static void ExecHashIncreaseBuckets(HashJoinTable hashtable)
         hashtable->nbuckets * sizeof(HashJoinTuple));
     securec_check(rc, "\0", "\0");
 
+    /*
+     * Size the filter for the doubled bucket array, which may be the first
+     * time it is big enough to need one; the loop below refills it.
+     */
+    ExecHashFilterCreate(hashtable, hashtable->log2_nbuckets + 1);
+
     /*
      * Scan through the existing hash table entries and dump out any that are
      * no longer of the current batch.
@@ -1934,6 +1997,9 @@ static void ExecHashIncreaseBuckets(HashJoinTable hashtable)
         while (htuple != NULL) {
             int offset = (htuple->hashvalue >> hashtable->log2_nbuckets) & 1;
 
+            if (hashtable->hashFilter != NULL) {
+                HASH_FILTER_ADD(hashtable, htuple->hashvalue);
+            }
             ntotal++;
             next = htuple->next;
             if (offset == 1) {
@@ -1975,6 +2041,71 @@ static void ExecHashIncreaseBuckets(HashJoinTable hashtable)
     hashtable->log2_nbuckets++;
 }
 
+/*
+ * ExecHashFilterCreate
+ *		Replace the hash filter with an empty one sized for 2^log2_nbuckets
+ *		buckets, allocated in the batch context
+ *
+ * Called whenever a new set of bucket headers is set up, so the filter always
+ * covers exactly the tuples linked into the main buckets.  Its memory is
+ * counted in spaceUsed like the tuples themselves.
+ */
+static void ExecHashFilterCreate(HashJoinTable hashtable, int log2_nbuckets)
+{
+    ExecHashFilterRelease(hashtable);
+    if (!hashtable->hashFilterEnabled || (1L << log2_nbuckets) < HASH_FILTER_MIN_BUCKETS)
+        return;
+
+    hashtable->hashFilterShift = 32 - (log2_nbuckets + HASH_FILTER_BITS_LOG2);
+    hashtable->hashFilterSize = HASH_FILTER_BYTES(1L << log2_nbuckets);
+    hashtable->hashFilter = (uint64*)MemoryContextAllocZero(hashtable->batchCxt, hashtable->hashFilterSize);
+
+    hashtable->spaceUsed += hashtable->hashFilterSize;
+    if (hashtable->spaceUsed > hashtable->spacePeak) {
+        hashtable->spacePeak = hashtable->spaceUsed;
+    }
+}
+
+/*
+ * ExecHashFilterRelease
+ *		Free the hash filter, if any, and give its memory back to spaceUsed
+ */
+static void ExecHashFilterRelease(HashJoinTable hashtable)
+{
+    if (hashtable->hashFilter == NULL)
+        return;
+
+    pfree_ext(hashtable->hashFilter);
+    hashtable->spaceUsed -= hashtable->hashFilterSize;
+    hashtable->hashFilterSize = 0;
+}
+
+/*
+ * ExecHashFilterReject
+ *		Return true if no tuple in the main buckets can have this hash value
+ *
+ * Once enough probes have been seen, the filter is dropped for the rest of
+ * the join if it rejects too few of them to pay for itself.
+ */
+static bool ExecHashFilterReject(HashJoinTable hashtable, uint32 hashvalue)
+{
+    uint32 bit = HASH_FILTER_BIT(hashtable, hashvalue);
+    bool reject = (hashtable->hashFilter[bit >> 6] & (((uint64)1) << (bit & 63))) == 0;
+
+    if (hashtable->hashFilterProbes < HASH_FILTER_SAMPLE) {
+        hashtable->hashFilterProbes++;
+        if (reject)
+            hashtable->hashFilterRejects++;
+        if (hashtable->hashFilterProbes == HASH_FILTER_SAMPLE &&
+            hashtable->hashFilterRejects < HASH_FILTER_SAMPLE * HASH_FILTER_MIN_REJECT_RATIO) {
+            hashtable->hashFilterEnabled = false;
+            ExecHashFilterRelease(hashtable);
+        }
+    }
+
+    return reject;
+}
+
 void ExecHashTableStats(HashJoinTable hashtable, int planid)
 {
     int fillRows = 0;
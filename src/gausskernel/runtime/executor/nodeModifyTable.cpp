@@ -273,7 +273,7 @@ static TupleTableSlot* ExecProcessReturning(
     return ExecProject(projectReturning, NULL);
 }
 
-static void ExecCheckTIDVisible(Relation        targetrel, EState* estate, Relation rel, ItemPointer tid)
+void ExecCheckTIDVisible(Relation targetrel, EState* estate, Relation rel, ItemPointer tid)
 {
     /* check isolation level to tell if tuple visibility check is needed */
     if (!IsolationUsesXactSnapshot()) {
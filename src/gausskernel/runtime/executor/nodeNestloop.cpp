@@ -21,13 +21,379 @@
 #include "postgres.h"
 #include "knl/knl_variable.h"
 
+#include "access/hash.h"
 #include "access/tableam.h"
 #include "executor/exec/execdebug.h"
 #include "executor/node/nodeNestloop.h"
 #include "executor/exec/execStream.h"
+#include "lib/ilist.h"
+#include "optimizer/clauses.h"
+#include "utils/datum.h"
+#include "utils/lsyscache.h"
 #include "utils/memutils.h"
 #include "executor/node/nodeHashjoin.h"
 
+/*
+ * Inner result cache (enable_memoize)
+ *
+ * When the inner side is a parameterized index scan, outer rows that repeat
+ * the same parameter values make us rescan the index for the same result
+ * over and over.  The cache keeps the complete inner result of recent
+ * parameter values, bounded by work_mem with least-recently-used eviction,
+ * and replays it instead of rescanning.  Keys are compared by binary
+ * equality of the parameter values, so a hit gives exactly the result the
+ * rescan would have produced.  A result is only kept once the inner scan has
+ * run to completion; semi and anti joins that stop early just leave nothing
+ * behind for that value.  If after a sample of lookups the hit ratio is too
+ * low to pay for copying the tuples, caching is switched off for the rest of
+ * the scan.
+ */
+#define NESTLOOP_CACHE_BUCKETS 1024 /* must be a power of 2 */
+#define NESTLOOP_CACHE_SAMPLE_LOOKUPS 1000
+#define NESTLOOP_CACHE_MIN_HIT_RATIO 0.1
+
+typedef struct NestLoopCacheEntry {
+    dlist_node lru_node;             /* link in LRU list, most recent first */
+    struct NestLoopCacheEntry* next; /* next entry in the same bucket */
+    uint32 hashvalue;
+    Datum* keys;
+    bool* nulls;
+    MinimalTuple* tuples;
+    int ntuples;
+    int maxtuples;
+    Size memsize; /* memory charged to this entry */
+    bool complete;
+} NestLoopCacheEntry;
+
+typedef struct NestLoopCacheData {
+    MemoryContext cxt; /* holds entries and cached tuples */
+    int nkeys;
+    int* paramnos;
+    int16* typlens;
+    bool* typbyvals;
+    NestLoopCacheEntry** buckets;
+    dlist_head lru;
+    Size memUsed;
+    Size memLimit;
+    NestLoopCacheEntry* current; /* entry being replayed or filled */
+    int readpos;                 /* next tuple of current to replay */
+    bool filling;                /* current is being filled from the inner plan */
+    bool disabled;               /* hit ratio too low, stop caching */
+    long lookups;
+    long hits;
+    TupleTableSlot* slot; /* for replaying cached inner tuples */
+} NestLoopCacheData;
+
+/*
+ * Decide whether the inner side of the join can be served from a cache.  It
+ * must be a plain index scan driven by the join parameters, with nothing
+ * volatile that could give a different result for the same values.
+ */
+static bool NestLoopCacheEligible(NestLoop* node)
+{
+    Plan* inner = innerPlan(node);
+    List* indexquals = NIL;
+
+    if (!u_sess->attr.attr_sql.enable_memoize || node->nestParams == NIL || node->join.optimizable) {
+        return false;
+    }
+
+    if (IsA(inner, IndexScan)) {
+        indexquals = ((IndexScan*)inner)->indexqualorig;
+    } else if (IsA(inner, IndexOnlyScan)) {
+        indexquals = ((IndexOnlyScan*)inner)->indexqual;
+    } else {
+        return false;
+    }
+
+    return !contain_volatile_functions((Node*)inner->targetlist) && !contain_volatile_functions((Node*)inner->qual) &&
+           !contain_volatile_functions((Node*)indexquals);
+}
+
+static NestLoopCache NestLoopCacheCreate(NestLoopState* nlstate, NestLoop* node, EState* estate)
+{
+    NestLoopCache cache = (NestLoopCache)palloc0(sizeof(NestLoopCacheData));
+    ListCell* lc = NULL;
+    int i = 0;
+
+    cache->cxt = AllocSetContextCreate(CurrentMemoryContext,
+        "NestLoopCache",
+        ALLOCSET_DEFAULT_MINSIZE,
+        ALLOCSET_DEFAULT_INITSIZE,
+        ALLOCSET_DEFAULT_MAXSIZE);
+    cache->nkeys = list_length(node->nestParams);
+    cache->paramnos = (int*)palloc(cache->nkeys * sizeof(int));
+    cache->typlens = (int16*)palloc(cache->nkeys * sizeof(int16));
+    cache->typbyvals = (bool*)palloc(cache->nkeys * sizeof(bool));
+    foreach (lc, node->nestParams) {
+        NestLoopParam* nlp = (NestLoopParam*)lfirst(lc);
+
+        cache->paramnos[i] = nlp->paramno;
+        get_typlenbyval(nlp->paramval->vartype, &cache->typlens[i], &cache->typbyvals[i]);
+        i++;
+    }
+    cache->buckets = (NestLoopCacheEntry**)palloc0(NESTLOOP_CACHE_BUCKETS * sizeof(NestLoopCacheEntry*));
+    dlist_init(&cache->lru);
+    cache->memLimit = u_sess->attr.attr_memory.work_mem * 1024L;
+    cache->slot = ExecInitExtraTupleSlot(estate);
+    ExecSetSlotDescriptor(cache->slot, ExecGetResultType(innerPlanState(nlstate)));
+
+    return cache;
+}
+
+static void NestLoopCacheReset(NestLoopCache cache)
+{
+    MemoryContextReset(cache->cxt);
+    errno_t rc = memset_s(cache->buckets, NESTLOOP_CACHE_BUCKETS * sizeof(NestLoopCacheEntry*), 0,
+        NESTLOOP_CACHE_BUCKETS * sizeof(NestLoopCacheEntry*));
+    securec_check(rc, "\0", "\0");
+    dlist_init(&cache->lru);
+    cache->memUsed = 0;
+    cache->current = NULL;
+    cache->filling = false;
+    cache->disabled = false;
+    cache->lookups = 0;
+    cache->hits = 0;
+}
+
+static void NestLoopCacheRemove(NestLoopCache cache, NestLoopCacheEntry* entry)
+{
+    NestLoopCacheEntry** link = &cache->buckets[entry->hashvalue & (NESTLOOP_CACHE_BUCKETS - 1)];
+
+    while (*link != entry) {
+        link = &(*link)->next;
+    }
+    *link = entry->next;
+    dlist_delete(&entry->lru_node);
+
+    for (int i = 0; i < cache->nkeys; i++) {
+        if (!cache->typbyvals[i] && !entry->nulls[i]) {
+            pfree(DatumGetPointer(entry->keys[i]));
+        }
+    }
+    for (int i = 0; i < entry->ntuples; i++) {
+        pfree(entry->tuples[i]);
+    }
+    if (entry->tuples != NULL) {
+        pfree(entry->tuples);
+    }
+    pfree(entry->keys);
+    pfree(entry->nulls);
+    cache->memUsed -= entry->memsize;
+    pfree(entry);
+
+    if (cache->current == entry) {
+        cache->current = NULL;
+        cache->filling = false;
+    }
+}
+
+/* Evict least recently used entries, other than the current one, to fit */
+static void NestLoopCacheShrink(NestLoopCache cache)
+{
+    while (cache->memUsed > cache->memLimit && !dlist_is_empty(&cache->lru)) {
+        NestLoopCacheEntry* victim = dlist_tail_element(NestLoopCacheEntry, lru_node, &cache->lru);
+
+        if (victim == cache->current) {
+            break;
+        }
+        NestLoopCacheRemove(cache, victim);
+    }
+}
+
+static uint32 NestLoopCacheHash(NestLoopCache cache, ParamExecData* prms)
+{
+    uint32 hashkey = 0;
+
+    for (int i = 0; i < cache->nkeys; i++) {
+        ParamExecData* prm = &prms[cache->paramnos[i]];
+
+        /* rotate hashkey left 1 bit at each step */
+        hashkey = (hashkey << 1) | ((hashkey & 0x80000000) ? 1 : 0);
+        if (prm->isnull) {
+            continue;
+        }
+        if (cache->typbyvals[i]) {
+            hashkey ^= DatumGetUInt32(hash_any((const unsigned char*)&prm->value, sizeof(Datum)));
+        } else {
+            Size size = datumGetSize(prm->value, false, cache->typlens[i]);
+
+            hashkey ^= DatumGetUInt32(hash_any((const unsigned char*)DatumGetPointer(prm->value), (int)size));
+        }
+    }
+
+    return hashkey;
+}
+
+static bool NestLoopCacheMatch(NestLoopCache cache, NestLoopCacheEntry* entry, ParamExecData* prms)
+{
+    for (int i = 0; i < cache->nkeys; i++) {
+        ParamExecData* prm = &prms[cache->paramnos[i]];
+
+        if (prm->isnull != entry->nulls[i]) {
+            return false;
+        }
+        if (!prm->isnull &&
+            !datumIsEqual(prm->value, entry->keys[i], cache->typbyvals[i], cache->typlens[i])) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/*
+ * Look up the current parameter values.  On a hit, the cached result is set
+ * up for replay and true is returned, so the caller must not rescan the
+ * inner plan.  On a miss a new entry is started which the inner scan fills.
+ */
+static bool NestLoopCacheLookup(NestLoopCache cache, ParamExecData* prms)
+{
+    NestLoopCacheEntry* entry = NULL;
+    MemoryContext oldcxt;
+    uint32 hashvalue;
+
+    /* a result we did not read to the end is of no use */
+    if (cache->current != NULL && cache->filling) {
+        NestLoopCacheRemove(cache, cache->current);
+    }
+    cache->current = NULL;
+    cache->filling = false;
+
+    if (cache->disabled) {
+        return false;
+    }
+
+    hashvalue = NestLoopCacheHash(cache, prms);
+    cache->lookups++;
+    for (entry = cache->buckets[hashvalue & (NESTLOOP_CACHE_BUCKETS - 1)]; entry != NULL; entry = entry->next) {
+        if (entry->hashvalue == hashvalue && NestLoopCacheMatch(cache, entry, prms)) {
+            Assert(entry->complete);
+            cache->hits++;
+            dlist_move_head(&cache->lru, &entry->lru_node);
+            cache->current = entry;
+            cache->readpos = 0;
+            return true;
+        }
+    }
+
+    if (cache->lookups >= NESTLOOP_CACHE_SAMPLE_LOOKUPS &&
+        cache->hits < cache->lookups * NESTLOOP_CACHE_MIN_HIT_RATIO) {
+        NestLoopCacheReset(cache);
+        cache->disabled = true;
+        return false;
+    }
+
+    oldcxt = MemoryContextSwitchTo(cache->cxt);
+    entry = (NestLoopCacheEntry*)palloc0(sizeof(NestLoopCacheEntry));
+    entry->hashvalue = hashvalue;
+    entry->keys = (Datum*)palloc(cache->nkeys * sizeof(Datum));
+    entry->nulls = (bool*)palloc(cache->nkeys * sizeof(bool));
+    entry->memsize = GetMemoryChunkSpace(entry) + GetMemoryChunkSpace(entry->keys) +
+                     GetMemoryChunkSpace(entry->nulls);
+    for (int i = 0; i < cache->nkeys; i++) {
+        ParamExecData* prm = &prms[cache->paramnos[i]];
+
+        entry->nulls[i] = prm->isnull;
+        entry->keys[i] = (Datum)0;
+        if (!prm->isnull) {
+            entry->keys[i] = datumCopy(prm->value, cache->typbyvals[i], cache->typlens[i]);
+            if (!cache->typbyvals[i]) {
+                entry->memsize += GetMemoryChunkSpace(DatumGetPointer(entry->keys[i]));
+            }
+        }
+    }
+    (void)MemoryContextSwitchTo(oldcxt);
+
+    entry->next = cache->buckets[hashvalue & (NESTLOOP_CACHE_BUCKETS - 1)];
+    cache->buckets[hashvalue & (NESTLOOP_CACHE_BUCKETS - 1)] = entry;
+    dlist_push_head(&cache->lru, &entry->lru_node);
+    cache->memUsed += entry->memsize;
+    cache->current = entry;
+    cache->filling = true;
+
+    return false;
+}
+
+static void NestLoopCacheAddTuple(NestLoopCache cache, TupleTableSlot* slot)
+{
+    NestLoopCacheEntry* entry = cache->current;
+    MemoryContext oldcxt = MemoryContextSwitchTo(cache->cxt);
+    MinimalTuple tuple;
+
+    if (entry->ntuples == entry->maxtuples) {
+        Size oldspace = (entry->tuples != NULL) ? GetMemoryChunkSpace(entry->tuples) : 0;
+
+        if (entry->tuples == NULL) {
+            entry->maxtuples = 8;
+            entry->tuples = (MinimalTuple*)palloc(entry->maxtuples * sizeof(MinimalTuple));
+        } else {
+            entry->maxtuples *= 2;
+            entry->tuples = (MinimalTuple*)repalloc(entry->tuples, entry->maxtuples * sizeof(MinimalTuple));
+        }
+        entry->memsize += GetMemoryChunkSpace(entry->tuples) - oldspace;
+        cache->memUsed += GetMemoryChunkSpace(entry->tuples) - oldspace;
+    }
+    tuple = ExecCopySlotMinimalTuple(slot);
+    entry->tuples[entry->ntuples++] = tuple;
+    entry->memsize += GetMemoryChunkSpace(tuple);
+    cache->memUsed += GetMemoryChunkSpace(tuple);
+    (void)MemoryContextSwitchTo(oldcxt);
+
+    if (cache->memUsed > cache->memLimit) {
+        NestLoopCacheShrink(cache);
+        /* this result alone does not fit, give up on caching it */
+        if (cache->memUsed > cache->memLimit) {
+            NestLoopCacheRemove(cache, entry);
+        }
+    }
+}
+
+/*
+ * Fetch the next inner tuple for the current outer tuple, replaying it from
+ * the cache or reading it from the inner plan.
+ */
+static TupleTableSlot* ExecNestLoopInner(NestLoopState* node, PlanState* inner_plan)
+{
+    NestLoopCache cache = node->nl_Cache;
+    TupleTableSlot* slot = NULL;
+
+    if (cache != NULL && cache->current != NULL && !cache->filling) {
+        NestLoopCacheEntry* entry = cache->current;
+
+        if (cache->readpos < entry->ntuples) {
+            return ExecStoreMinimalTuple(entry->tuples[cache->readpos++], cache->slot, false);
+        }
+        cache->current = NULL;
+        return ExecClearTuple(cache->slot);
+    }
+
+    /*
+     * If inner plan is mergejoin, which does not cache data,
+     * but will early free the left and right tree's caching memory.
+     * When rescan left tree, may fail.
+     */
+    bool orig_value = inner_plan->state->es_skip_early_free;
+    if (!IsA(inner_plan, MaterialState))
+        inner_plan->state->es_skip_early_free = true;
+
+    slot = ExecProcNode(inner_plan);
+
+    inner_plan->state->es_skip_early_free = orig_value;
+
+    if (cache != NULL && cache->filling) {
+        if (TupIsNull(slot)) {
+            cache->current->complete = true;
+            cache->current = NULL;
+            cache->filling = false;
+        } else {
+            NestLoopCacheAddTuple(cache, slot);
+        }
+    }
+
+    return slot;
+}
+
 static void MaterialAll(PlanState* node)
 {
     if (IsA(node, MaterialState)) {
@@ -191,10 +557,13 @@ TupleTableSlot* ExecNestLoop(NestLoopState* node)
             }
 
             /*
-             * now rescan the inner plan
+             * now rescan the inner plan, unless its result for these
+             * parameter values is cached
              */
-            ENL1_printf("rescanning inner plan");
-            ExecReScan(inner_plan);
+            if (node->nl_Cache == NULL || !NestLoopCacheLookup(node->nl_Cache, econtext->ecxt_param_exec_vals)) {
+                ENL1_printf("rescanning inner plan");
+                ExecReScan(inner_plan);
+            }
         }
 
         /*
@@ -202,18 +571,7 @@ TupleTableSlot* ExecNestLoop(NestLoopState* node)
          */
         ENL1_printf("getting new inner tuple");
 
-        /*
-         * If inner plan is mergejoin, which does not cache data,
-         * but will early free the left and right tree's caching memory.
-         * When rescan left tree, may fail.
-         */
-        bool orig_value = inner_plan->state->es_skip_early_free;
-        if (!IsA(inner_plan, MaterialState))
-            inner_plan->state->es_skip_early_free = true;
-
-        inner_tuple_slot = ExecProcNode(inner_plan);
-
-        inner_plan->state->es_skip_early_free = orig_value;
+        inner_tuple_slot = ExecNestLoopInner(node, inner_plan);
         econtext->ecxt_innertuple = inner_tuple_slot;
 
         if (TupIsNull(inner_tuple_slot)) {
@@ -378,6 +736,10 @@ NestLoopState* ExecInitNestLoop(NestLoop* node, EState* estate, int eflags)
      */
     ExecInitResultTupleSlot(estate, &nlstate->js.ps);
 
+    if (NestLoopCacheEligible(node)) {
+        nlstate->nl_Cache = NestLoopCacheCreate(nlstate, node, estate);
+    }
+
     switch (node->join.jointype) {
         case JOIN_INNER:
         case JOIN_SEMI:
@@ -427,6 +789,11 @@ void ExecEndNestLoop(NestLoopState* node)
      */
     ExecFreeExprContext(&node->js.ps);
 
+    if (node->nl_Cache != NULL) {
+        MemoryContextDelete(node->nl_Cache->cxt);
+        node->nl_Cache = NULL;
+    }
+
     /*
      * clean out the tuple table
      */
@@ -471,7 +838,13 @@ void ExecReScanNestLoop(NestLoopState* node)
      * inner_plan is re-scanned for each new outer tuple and MUST NOT be
      * re-scanned from here or you'll get troubles from inner index scans when
      * outer Vars are used as run-time keys...
+     *
+     * Parameters from above may have changed, so cached inner results are
+     * no longer trustworthy.
      */
+    if (node->nl_Cache != NULL) {
+        NestLoopCacheReset(node->nl_Cache);
+    }
     node->js.ps.ps_TupFromTlist = false;
     node->nl_NeedNewOuter = true;
     node->nl_MatchedOuter = false;
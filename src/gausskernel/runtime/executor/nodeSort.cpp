@@ -22,6 +22,7 @@
 #include "optimizer/streamplan.h"
 #include "pgstat.h"
 #include "instruments/instr_unique_sql.h"
+#include "utils/lsyscache.h"
 #include "utils/tuplesort.h"
 #include "workload/workload.h"
 
@@ -121,6 +122,16 @@ TupleTableSlot* ExecSort(SortState* node)
         node->tuplesortstate = (void*)tuple_sortstate;
         WaitState old_status = pgstat_report_waitstatus(STATE_EXEC_SORT_FETCH_TUPLE);
 
+        /*
+         * When the input is already ordered on the leading numPresorted sort
+         * columns and only the first "bound" tuples are wanted, every tuple
+         * after the group holding the bound-th one sorts behind all of those,
+         * so we can stop reading there.
+         */
+        bool check_presorted = node->bounded && node->bound > 0 && node->presortedEqfunctions != NULL;
+        bool stopped_early = false;
+        int64 nfed = 0;
+
         /*
          * Scan the subplan and feed all the tuples to tuplesort.
          */
@@ -128,12 +139,31 @@ TupleTableSlot* ExecSort(SortState* node)
             slot = ExecProcNode(outer_node);
             if (TupIsNull(slot))
                 break;
+            if (check_presorted && nfed >= node->bound) {
+                ExprContext* econtext = node->ss.ps.ps_ExprContext;
+                bool same_group = execTuplesMatch(slot,
+                    node->ss.ss_ScanTupleSlot,
+                    plan_node->numPresorted,
+                    plan_node->sortColIdx,
+                    node->presortedEqfunctions,
+                    econtext->ecxt_per_tuple_memory);
+
+                ResetExprContext(econtext);
+                if (!same_group) {
+                    stopped_early = true;
+                    break;
+                }
+            }
 #ifdef PGXC
             if (plan_node->srt_start_merge)
                 tuplesort_puttupleslotontape(tuple_sortstate, slot);
             else
 #endif /* PGXC */
                 tuplesort_puttupleslot(tuple_sortstate, slot);
+            if (check_presorted && ++nfed == node->bound) {
+                /* remember the group of the bound-th tuple */
+                (void)ExecCopySlot(node->ss.ss_ScanTupleSlot, slot);
+            }
         }
         
         pgstat_report_waitstatus(STATE_EXEC_SORT);
@@ -150,8 +180,12 @@ TupleTableSlot* ExecSort(SortState* node)
                 node->ss.ps.instrument->memoryinfo.peakOpMemory = peakMemorySize;
         }
 
-        /* Finish scanning the subplan, it's safe to early free the memory of lefttree */
-        ExecEarlyFree(outerPlanState(node));
+        /*
+         * Finish scanning the subplan, it's safe to early free the memory of
+         * lefttree, unless we left it in the middle of its output.
+         */
+        if (!stopped_early)
+            ExecEarlyFree(outerPlanState(node));
 
         EARLY_FREE_LOG(elog(LOG,
             "Early Free: Before completing the sort "
@@ -267,6 +301,31 @@ SortState* ExecInitSort(Sort* node, EState* estate, int eflags)
      */
     ExecAssignScanTypeFromOuterPlan(&sortstate->ss);
 
+    /*
+     * Prepare to detect the end of presorted groups for bounded sorts.  The
+     * expression context is only used as comparison workspace.
+     */
+    if (node->numPresorted > 0
+#ifdef PGXC
+        && !node->srt_start_merge
+#endif
+    ) {
+        Oid* eqOperators = (Oid*)palloc(node->numPresorted * sizeof(Oid));
+
+        for (int i = 0; i < node->numPresorted; i++) {
+            eqOperators[i] = get_equality_op_for_ordering_op(node->sortOperators[i], NULL);
+            if (!OidIsValid(eqOperators[i]))
+                ereport(ERROR,
+                    (errmodule(MOD_EXECUTOR),
+                        errcode(ERRCODE_UNDEFINED_FUNCTION),
+                        errmsg("could not find equality operator for ordering operator %u",
+                            node->sortOperators[i])));
+        }
+        sortstate->presortedEqfunctions = execTuplesMatchPrepare(node->numPresorted, eqOperators);
+        ExecAssignExprContext(estate, &sortstate->ss.ps);
+        pfree(eqOperators);
+    }
+
     ExecAssignResultTypeFromTL(
             &sortstate->ss.ps,
             sortstate->ss.ss_ScanTupleSlot->tts_tupleDescriptor->tdTableAmType);
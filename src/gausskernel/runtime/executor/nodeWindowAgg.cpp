@@ -47,6 +47,7 @@
 #include "utils/acl.h"
 #include "utils/builtins.h"
 #include "utils/datum.h"
+#include "utils/fmgroids.h"
 #include "utils/lsyscache.h"
 #include "utils/memutils.h"
 #include "utils/syscache.h"
@@ -56,6 +57,9 @@ static void initialize_windowaggregate(
     WindowAggState* winstate, WindowStatePerFunc perfuncstate, WindowStatePerAgg peraggstate);
 static void advance_windowaggregate(
     WindowAggState* winstate, WindowStatePerFunc perfuncstate, WindowStatePerAgg peraggstate);
+static void retreat_windowaggregate(
+    WindowAggState* winstate, WindowStatePerFunc perfuncstate, WindowStatePerAgg peraggstate);
+static void retreat_windowaggregates(WindowAggState* winstate);
 static void finalize_windowaggregate(WindowAggState* winstate, WindowStatePerFunc perfuncstate,
     WindowStatePerAgg peraggstate, Datum* result, bool* is_null);
 
@@ -96,6 +100,7 @@ static void initialize_windowaggregate(
     peraggstate->transValueIsNull = peraggstate->initValueIsNull;
     peraggstate->noTransValue = peraggstate->initValueIsNull;
     peraggstate->resultValueIsNull = true;
+    peraggstate->transCount = 0;
 }
 
 /*
@@ -130,6 +135,16 @@ static void advance_windowaggregate(
         i++;
     }
 
+    if (peraggstate->invertible) {
+        /* remember how many non-NULL inputs are in transValue */
+        for (i = 1; i <= num_arguments; i++) {
+            if (fcinfo->argnull[i])
+                break;
+        }
+        if (i > num_arguments)
+            peraggstate->transCount++;
+    }
+
     if (peraggstate->transfn.fn_strict) {
         /*
          * For a strict transfn, nothing happens when there's a NULL input; we
@@ -198,6 +213,111 @@ static void advance_windowaggregate(
     peraggstate->transValueIsNull = fcinfo->isnull;
 }
 
+/*
+ * retreat_windowaggregate
+ * remove the current row from the transition value of an invertible aggregate
+ *
+ * This is the inverse of advance_windowaggregate for the transition functions
+ * accepted by initialize_peragg: count(*), count(expr), sum(int2) and
+ * sum(int4), all of which keep a pass-by-value int8 state.  The row must have
+ * been accumulated before, so the arithmetic cannot overflow.
+ */
+static void retreat_windowaggregate(
+    WindowAggState* winstate, WindowStatePerFunc perfuncstate, WindowStatePerAgg peraggstate)
+{
+    WindowFuncExprState* wfuncstate = perfuncstate->wfuncstate;
+    ExprContext* econtext = winstate->tmpcontext;
+    MemoryContext old_context;
+    ListCell* arg = NULL;
+    Datum value = (Datum)0;
+    bool isnull = false;
+
+    old_context = MemoryContextSwitchTo(econtext->ecxt_per_tuple_memory);
+    foreach (arg, wfuncstate->args) {
+        bool argnull = false;
+
+        value = ExecEvalExpr((ExprState*)lfirst(arg), econtext, &argnull, NULL);
+        isnull = isnull || argnull;
+    }
+    MemoryContextSwitchTo(old_context);
+
+    /* NULL inputs never changed the transition value */
+    if (isnull)
+        return;
+
+    Assert(peraggstate->transCount > 0 && !peraggstate->transValueIsNull);
+    peraggstate->transCount--;
+
+    if (peraggstate->transCount == 0) {
+        /* back to the initial state (the agg's initcond), as if no row had been seen */
+        peraggstate->transValue = peraggstate->initValue;
+        peraggstate->transValueIsNull = peraggstate->initValueIsNull;
+        peraggstate->noTransValue = peraggstate->initValueIsNull;
+        return;
+    }
+
+    switch (peraggstate->transfn_oid) {
+        case F_INT8INC:
+        case F_INT8INC_ANY:
+            peraggstate->transValue = Int64GetDatum(DatumGetInt64(peraggstate->transValue) - 1);
+            break;
+        case F_INT4_SUM:
+        case F_INT2_SUM: {
+            int64 arg_value = (peraggstate->transfn_oid == F_INT4_SUM) ? (int64)DatumGetInt32(value)
+                                                                       : (int64)DatumGetInt16(value);
+
+            peraggstate->transValue = Int64GetDatum(DatumGetInt64(peraggstate->transValue) - arg_value);
+            break;
+        }
+        default:
+            ereport(ERROR,
+                (errcode(ERRCODE_UNRECOGNIZED_NODE_TYPE),
+                    errmodule(MOD_EXECUTOR),
+                    errmsg("unexpected transition function %u for moving window aggregate",
+                        peraggstate->transfn_oid)));
+            break;
+    }
+}
+
+/*
+ * retreat_windowaggregates
+ * remove the rows from aggregatedbase up to the new frame head from the
+ * aggregate transition values
+ *
+ * Only called when every aggregate is invertible.  The rows are fetched with
+ * the forward-only agg_invptr read pointer, which always sits at
+ * aggregatedbase, so the cost is proportional to the number of rows leaving
+ * the frame rather than to the frame width.
+ */
+static void retreat_windowaggregates(WindowAggState* winstate)
+{
+    TupleTableSlot* slot = winstate->temp_slot_2;
+    int64 pos;
+    int i;
+
+    tuplestore_select_read_pointer(winstate->buffer, winstate->agg_invptr);
+    for (pos = winstate->aggregatedbase; pos < winstate->frameheadpos; pos++) {
+        if (!tuplestore_gettupleslot(winstate->buffer, true, true, slot))
+            ereport(ERROR,
+                (errcode(ERRCODE_DATA_EXCEPTION),
+                    errmodule(MOD_EXECUTOR),
+                    errmsg("unexpected end of tuplestore while removing rows from window frame")));
+
+        winstate->tmpcontext->ecxt_outertuple = slot;
+        for (i = 0; i < winstate->numaggs; i++) {
+            WindowStatePerAgg peraggstate = &winstate->peragg[i];
+
+            retreat_windowaggregate(winstate, &winstate->perfunc[peraggstate->wfuncno], peraggstate);
+        }
+        ResetExprContext(winstate->tmpcontext);
+    }
+    (void)ExecClearTuple(slot);
+
+    /* keep the mark pointer at the frame head, so tuplestore can trim */
+    WinSetMarkPosition(winstate->agg_winobj, winstate->frameheadpos);
+    winstate->aggregatedbase = winstate->frameheadpos;
+}
+
 /*
  * finalize_windowaggregate
  * parallel to finalize_aggregate in nodeAgg.c
@@ -259,6 +379,7 @@ static void eval_windowaggregates(WindowAggState* winstate)
     ExprContext* econtext = NULL;
     WindowObject agg_winobj;
     TupleTableSlot* agg_row_slot = NULL;
+    bool retreated = false;
 
     num_aggs = winstate->numaggs;
     if (num_aggs == 0) {
@@ -300,11 +421,11 @@ static void eval_windowaggregates(WindowAggState* winstate)
      * accumulated into the aggregate transition values.  Whenever we start a
      * new peer group, we accumulate forward to the end of the peer group.
      *
-     * Rerunning aggregates from the frame start can be pretty slow. For
-     * some aggregates like SUM and COUNT we could avoid that by implementing
-     * a "negative transition function" that would be called for each row as
-     * it exits the frame.	We'd have to think about avoiding recalculation of
-     * volatile arguments of aggregate functions, too.
+     * Rerunning aggregates from the frame start can be pretty slow.  When
+     * every aggregate is COUNT or an integer SUM with non-volatile arguments,
+     * we instead remove the rows that left the frame from the transition
+     * values (see retreat_windowaggregates), as long as the new frame head is
+     * still within the rows aggregated so far.
      */
     /*
      * First, update the frame head position.
@@ -315,7 +436,11 @@ static void eval_windowaggregates(WindowAggState* winstate)
      * Initialize aggregates on first call for partition, or if the frame head
      * position moved since last time.
      */
-    if (winstate->currentpos == 0 || winstate->frameheadpos != winstate->aggregatedbase) {
+    if (winstate->currentpos != 0 && winstate->agg_invptr >= 0 &&
+        winstate->frameheadpos > winstate->aggregatedbase && winstate->frameheadpos <= winstate->aggregatedupto) {
+        retreat_windowaggregates(winstate);
+        retreated = true;
+    } else if (winstate->currentpos == 0 || winstate->frameheadpos != winstate->aggregatedbase) {
         /*
          * Discard transient aggregate values
          */
@@ -334,6 +459,17 @@ static void eval_windowaggregates(WindowAggState* winstate)
         if (agg_winobj->markptr >= 0)
             WinSetMarkPosition(agg_winobj, winstate->frameheadpos);
 
+        /* Likewise skip the rows-leaving-frame pointer over the rows we dropped */
+        if (winstate->agg_invptr >= 0) {
+            int64 pos;
+
+            tuplestore_select_read_pointer(winstate->buffer, winstate->agg_invptr);
+            for (pos = winstate->aggregatedbase; pos < winstate->frameheadpos; pos++) {
+                if (!tuplestore_advance(winstate->buffer, true))
+                    break;
+            }
+        }
+
         /*
          * Initialize for loop below
          */
@@ -347,9 +483,11 @@ static void eval_windowaggregates(WindowAggState* winstate)
      * except when the frame head moves.  In END_CURRENT_ROW mode, we only
      * have to recalculate when the frame head moves or currentpos has
      * advanced past the place we'd aggregated up to.  Check for these cases
-     * and if so, reuse the saved result values.
+     * and if so, reuse the saved result values.  After rows were removed
+     * from the frame head the saved values are stale and must be finalized
+     * again, even though nothing new has to be accumulated.
      */
-    if ((winstate->frameOptions & (FRAMEOPTION_END_UNBOUNDED_FOLLOWING | FRAMEOPTION_END_CURRENT_ROW)) &&
+    if (!retreated && (winstate->frameOptions & (FRAMEOPTION_END_UNBOUNDED_FOLLOWING | FRAMEOPTION_END_CURRENT_ROW)) &&
         winstate->aggregatedbase <= winstate->currentpos && winstate->aggregatedupto > winstate->currentpos) {
         for (i = 0; i < num_aggs; i++) {
             peraggstate = &winstate->peragg[i];
@@ -553,6 +691,9 @@ static void begin_partition(WindowAggState* winstate)
             agg_winobj->markptr = tuplestore_alloc_read_pointer(winstate->buffer, 0);
             /* and the read pointer will need BACKWARD capability */
             readptr_flags |= EXEC_FLAG_BACKWARD;
+            /* rows leaving the frame are read forward only, in order */
+            if (winstate->agg_invertible)
+                winstate->agg_invptr = tuplestore_alloc_read_pointer(winstate->buffer, 0);
         }
 
         agg_winobj->readptr = tuplestore_alloc_read_pointer(winstate->buffer, readptr_flags);
@@ -1332,6 +1473,14 @@ WindowAggState* ExecInitWindowAgg(WindowAgg* node, EState* estate, int eflags)
     winstate->numfuncs = wfuncno + 1;
     winstate->numaggs = aggno + 1;
 
+    /* rows can only be removed from the frame if every aggregate allows it */
+    winstate->agg_invertible = (winstate->numaggs > 0);
+    winstate->agg_invptr = -1;
+    for (aggno = 0; aggno < winstate->numaggs; aggno++) {
+        if (!winstate->peragg[aggno].invertible)
+            winstate->agg_invertible = false;
+    }
+
     /* Set up WindowObject for aggregates, if needed */
     if (winstate->numaggs > 0) {
         WindowObject agg_winobj = makeNode(WindowObjectData);
@@ -1549,6 +1698,18 @@ WindowStatePerAggData* initialize_peragg(WindowAggState* winstate, WindowFunc* w
                     errmsg("aggregate %u needs to have compatible input type and transition type", wfunc->winfnoid)));
     }
 
+    /*
+     * Aggregates we know how to undo, see retreat_windowaggregate.  Volatile
+     * arguments could evaluate differently when the row leaves the frame, and
+     * a strict transfn with a NULL initcond takes the first input as its state,
+     * which can't be subtracted back out.
+     */
+    peraggstate->invertible = (transfn_oid == F_INT8INC || transfn_oid == F_INT8INC_ANY ||
+        transfn_oid == F_INT4_SUM || transfn_oid == F_INT2_SUM) && peraggstate->transtypeByVal &&
+        !(peraggstate->transfn.fn_strict && peraggstate->initValueIsNull) &&
+        !contain_volatile_functions((Node*)wfunc->args);
+    peraggstate->transCount = 0;
+
     ReleaseSysCache(agg_tuple);
 
     return peraggstate;
@@ -39,6 +39,7 @@
 #include "opfusion/opfusion_agg.h"
 #include "opfusion/opfusion_delete.h"
 #include "opfusion/opfusion_insert.h"
+#include "opfusion/opfusion_nestloop.h"
 #include "opfusion/opfusion_select.h"
 #include "opfusion/opfusion_selectforupdate.h"
 #include "opfusion/opfusion_sort.h"
@@ -704,6 +705,9 @@ void *OpFusion::FusionFactory(FusionType ftype, MemoryContext context, CachedPla
         case SORT_INDEX_FUSION:
             opfusionObj = New(objCxt)SortFusion(context, psrc, plantree_list, params);
             break;
+        case NESTLOOP_INDEX_FUSION:
+            opfusionObj = New(objCxt)NestLoopIndexFusion(context, psrc, plantree_list, params);
+            break;
         case NONE_FUSION:
             opfusionObj = NULL;
             break;
@@ -71,7 +71,8 @@ IndexScanFusion::IndexScanFusion(IndexScan* node, PlannedStmt* planstmt, ParamLi
                 var = ((RelabelType*)var)->arg;
             }
 
-            if (IsA(var, Param)) {
+            /* PARAM_EXEC keys are filled by the nestloop fusion from its outer row */
+            if (IsA(var, Param) && ((Param*)var)->paramkind == PARAM_EXTERN) {
                 Param* param = (Param*)var;
                 m_paramLoc[m_paramNum].paramId = param->paramid;
                 m_paramLoc[m_paramNum++].scanKeyIndx = i;
@@ -30,6 +30,7 @@
 #include "commands/sequence.h"
 #include "executor/node/nodeModifyTable.h"
 #include "parser/parse_coerce.h"
+#include "utils/snapmgr.h"
 
 void InsertFusion::InitGlobals()
 {
@@ -38,8 +39,8 @@ void InsertFusion::InitGlobals()
     m_global->m_reloid = getrelid(linitial_int((List*)linitial(m_global->m_planstmt->resultRelations)),
                                   m_global->m_planstmt->rtable);
     ModifyTable* node = (ModifyTable*)m_global->m_planstmt->planTree;
-    BaseResult* baseresult = (BaseResult*)linitial(node->plans);
-    List* targetList = baseresult->plan.targetlist;
+    Plan* subplan = (Plan*)linitial(node->plans);
+    List* targetList = subplan->targetlist;
 
     Relation rel = heap_open(m_global->m_reloid, AccessShareLock);
     m_global->m_table_type = RelationIsUstoreFormat(rel) ? TAM_USTORE : TAM_HEAP;
@@ -52,12 +53,37 @@ void InsertFusion::InitGlobals()
 
     /* init param func const */
     m_global->m_paramNum = 0;
-    m_global->m_paramLoc = (ParamLoc*)palloc0(m_global->m_natts * sizeof(ParamLoc));
-    m_c_global->m_targetParamNum = 0;
-    m_c_global->m_targetFuncNum = 0;
-    m_c_global->m_targetFuncNodes = (FuncExprInfo*)palloc0(m_global->m_natts * sizeof(FuncExprInfo));
-    m_c_global->m_targetConstNum = 0;
-    m_c_global->m_targetConstLoc = (ConstLoc*)palloc0(m_global->m_natts * sizeof(ConstLoc));
+    m_global->m_paramLoc = NULL;
+    m_c_global->m_upsertNothing = (node->upsertAction == UPSERT_NOTHING);
+
+    if (IsA(subplan, ValuesScan)) {
+        /* multi-row VALUES, every row gets its own targetlist with the Vars replaced */
+        ValuesScan* valuesScan = (ValuesScan*)subplan;
+        m_c_global->m_rowNum = list_length(valuesScan->values_lists);
+        m_c_global->m_rowTargets =
+            (InsertFusionRowTarget*)palloc0(m_c_global->m_rowNum * sizeof(InsertFusionRowTarget));
+
+        ListCell* lc = NULL;
+        int row = 0;
+        foreach (lc, valuesScan->values_lists) {
+            List* rowTargetList = GetValuesRowTargetList(targetList, valuesScan, (List*)lfirst(lc));
+            InitRowTarget(&m_c_global->m_rowTargets[row++], rowTargetList);
+        }
+    } else {
+        m_c_global->m_rowNum = 1;
+        m_c_global->m_rowTargets = (InsertFusionRowTarget*)palloc0(sizeof(InsertFusionRowTarget));
+        InitRowTarget(m_c_global->m_rowTargets, targetList);
+    }
+}
+
+void InsertFusion::InitRowTarget(InsertFusionRowTarget* row, List* targetList)
+{
+    row->m_paramLoc = (ParamLoc*)palloc0(m_global->m_natts * sizeof(ParamLoc));
+    row->m_targetParamNum = 0;
+    row->m_targetFuncNum = 0;
+    row->m_targetFuncNodes = (FuncExprInfo*)palloc0(m_global->m_natts * sizeof(FuncExprInfo));
+    row->m_targetConstNum = 0;
+    row->m_targetConstLoc = (ConstLoc*)palloc0(m_global->m_natts * sizeof(ConstLoc));
 
     ListCell* lc = NULL;
     int i = 0;
@@ -74,36 +100,36 @@ void InsertFusion::InitGlobals()
             expr = ((RelabelType*)expr)->arg;
         }
 
-        m_c_global->m_targetConstLoc[i].constLoc = -1;
+        row->m_targetConstLoc[i].constLoc = -1;
         if (IsA(expr, FuncExpr)) {
             func = (FuncExpr*)expr;
-            m_c_global->m_targetFuncNodes[m_c_global->m_targetFuncNum].resno = res->resno;
-            m_c_global->m_targetFuncNodes[m_c_global->m_targetFuncNum].resname = res->resname;
-            m_c_global->m_targetFuncNodes[m_c_global->m_targetFuncNum].funcid = func->funcid;
-            m_c_global->m_targetFuncNodes[m_c_global->m_targetFuncNum].args = func->args;
-            ++m_c_global->m_targetFuncNum;
+            row->m_targetFuncNodes[row->m_targetFuncNum].resno = res->resno;
+            row->m_targetFuncNodes[row->m_targetFuncNum].resname = res->resname;
+            row->m_targetFuncNodes[row->m_targetFuncNum].funcid = func->funcid;
+            row->m_targetFuncNodes[row->m_targetFuncNum].args = func->args;
+            ++row->m_targetFuncNum;
         } else if (IsA(expr, Param)) {
             Param* param = (Param*)expr;
-            m_global->m_paramLoc[m_c_global->m_targetParamNum].paramId = param->paramid;
-            m_global->m_paramLoc[m_c_global->m_targetParamNum++].scanKeyIndx = i;
+            row->m_paramLoc[row->m_targetParamNum].paramId = param->paramid;
+            row->m_paramLoc[row->m_targetParamNum++].scanKeyIndx = i;
         } else if (IsA(expr, Const)) {
             Assert(IsA(expr, Const));
-            m_c_global->m_targetConstLoc[i].constValue = ((Const*)expr)->constvalue;
-            m_c_global->m_targetConstLoc[i].constIsNull = ((Const*)expr)->constisnull;
-            m_c_global->m_targetConstLoc[i].constLoc = i;
+            row->m_targetConstLoc[i].constValue = ((Const*)expr)->constvalue;
+            row->m_targetConstLoc[i].constIsNull = ((Const*)expr)->constisnull;
+            row->m_targetConstLoc[i].constLoc = i;
         } else if (IsA(expr, OpExpr)) {
             opexpr = (OpExpr*)expr;
-            m_c_global->m_targetFuncNodes[m_c_global->m_targetFuncNum].resno = res->resno;
-            m_c_global->m_targetFuncNodes[m_c_global->m_targetFuncNum].resname = res->resname;
-            m_c_global->m_targetFuncNodes[m_c_global->m_targetFuncNum].funcid = opexpr->opfuncid;
-            m_c_global->m_targetFuncNodes[m_c_global->m_targetFuncNum].args = opexpr->args;
-            ++m_c_global->m_targetFuncNum;
+            row->m_targetFuncNodes[row->m_targetFuncNum].resno = res->resno;
+            row->m_targetFuncNodes[row->m_targetFuncNum].resname = res->resname;
+            row->m_targetFuncNodes[row->m_targetFuncNum].funcid = opexpr->opfuncid;
+            row->m_targetFuncNodes[row->m_targetFuncNum].args = opexpr->args;
+            ++row->m_targetFuncNum;
         }
         i++;
     }
-    m_c_global->m_targetConstNum = i;
-
+    row->m_targetConstNum = i;
 }
+
 void InsertFusion::InitLocals(ParamListInfo params)
 {
     m_c_local.m_estate = CreateExecutorStateForOpfusion(m_local.m_localContext, m_local.m_tmpContext);
@@ -139,7 +165,7 @@ InsertFusion::InsertFusion(MemoryContext context, CachedPlanSource* psrc, List*
     MemoryContextSwitchTo(old_context);
 }
 
-void InsertFusion::refreshParameterIfNecessary()
+void InsertFusion::refreshParameterIfNecessary(const InsertFusionRowTarget* row)
 {
     ParamListInfo parms = m_local.m_outParams != NULL ? m_local.m_outParams : m_local.m_params;
     bool func_isnull = false;
@@ -149,34 +175,34 @@ void InsertFusion::refreshParameterIfNecessary()
         m_c_local.m_curVarIsnull[i] = m_local.m_isnull[i];
     }
     /* refresh const value */
-    for (int i = 0; i < m_c_global->m_targetConstNum; i++) {
-        if (m_c_global->m_targetConstLoc[i].constLoc >= 0) {
-            m_local.m_values[m_c_global->m_targetConstLoc[i].constLoc] = m_c_global->m_targetConstLoc[i].constValue;
-            m_local.m_isnull[m_c_global->m_targetConstLoc[i].constLoc] = m_c_global->m_targetConstLoc[i].constIsNull;
+    for (int i = 0; i < row->m_targetConstNum; i++) {
+        if (row->m_targetConstLoc[i].constLoc >= 0) {
+            m_local.m_values[row->m_targetConstLoc[i].constLoc] = row->m_targetConstLoc[i].constValue;
+            m_local.m_isnull[row->m_targetConstLoc[i].constLoc] = row->m_targetConstLoc[i].constIsNull;
         }
     }
     /* calculate func result */
-    for (int i = 0; i < m_c_global->m_targetFuncNum; ++i) {
-        ELOG_FIELD_NAME_START(m_c_global->m_targetFuncNodes[i].resname);
-        if (m_c_global->m_targetFuncNodes[i].funcid != InvalidOid) {
+    for (int i = 0; i < row->m_targetFuncNum; ++i) {
+        ELOG_FIELD_NAME_START(row->m_targetFuncNodes[i].resname);
+        if (row->m_targetFuncNodes[i].funcid != InvalidOid) {
             func_isnull = false;
-            m_local.m_values[m_c_global->m_targetFuncNodes[i].resno - 1] =
-                CalFuncNodeVal(m_c_global->m_targetFuncNodes[i].funcid,
-                               m_c_global->m_targetFuncNodes[i].args,
+            m_local.m_values[row->m_targetFuncNodes[i].resno - 1] =
+                CalFuncNodeVal(row->m_targetFuncNodes[i].funcid,
+                               row->m_targetFuncNodes[i].args,
                                &func_isnull,
                                m_c_local.m_curVarValue,
                                m_c_local.m_curVarIsnull);
-            m_local.m_isnull[m_c_global->m_targetFuncNodes[i].resno - 1] = func_isnull;
+            m_local.m_isnull[row->m_targetFuncNodes[i].resno - 1] = func_isnull;
         }
         ELOG_FIELD_NAME_END;
     }
     /* mapping params */
-    if (m_c_global->m_targetParamNum > 0) {
-        for (int i = 0; i < m_c_global->m_targetParamNum; i++) {
-            m_local.m_values[m_global->m_paramLoc[i].scanKeyIndx] =
-                parms->params[m_global->m_paramLoc[i].paramId - 1].value;
-            m_local.m_isnull[m_global->m_paramLoc[i].scanKeyIndx] =
-                parms->params[m_global->m_paramLoc[i].paramId - 1].isnull;
+    if (row->m_targetParamNum > 0) {
+        for (int i = 0; i < row->m_targetParamNum; i++) {
+            m_local.m_values[row->m_paramLoc[i].scanKeyIndx] =
+                parms->params[row->m_paramLoc[i].paramId - 1].value;
+            m_local.m_isnull[row->m_paramLoc[i].scanKeyIndx] =
+                parms->params[row->m_paramLoc[i].paramId - 1].isnull;
         }
     }
 }
@@ -256,26 +282,37 @@ unsigned long InsertFusion::ExecInsert(Relation rel, ResultRelInfo* result_rel_i
         MemoryContext old_context = MemoryContextSwitchTo(m_local.m_tmpContext);
         tuple = set_user_tuple_hash(tmp_tuple, target_rel);
         (void)ExecStoreTuple(tuple, m_local.m_reslot, InvalidBuffer, false);
-        m_local.m_ledger_hash_exist = hist_table_record_insert(target_rel, (HeapTuple)tuple, &m_local.m_ledger_relhash);
+        uint64 res_hash = 0;
+        m_local.m_ledger_hash_exist = hist_table_record_insert(target_rel, (HeapTuple)tuple, &res_hash);
+        m_local.m_ledger_relhash += res_hash;
         (void)MemoryContextSwitchTo(old_context);
         tableam_tops_free_tuple(tmp_tuple);
     }
 
-    /* check unique constraint first if SQL has keyword IGNORE */
+    /* check unique constraint first if SQL has keyword IGNORE or DUPLICATE KEY UPDATE NOTHING */
     bool isgpi = false;
     ConflictInfoData conflictInfo;
     Oid conflictPartOid = InvalidOid;
     int2 conflictBucketid = InvalidBktId;
-    if (m_c_local.m_estate->es_plannedstmt && m_c_local.m_estate->es_plannedstmt->hasIgnore &&
+    bool specConflict = false;
+    bool checkConflict = m_c_global->m_upsertNothing ||
+        (m_c_local.m_estate->es_plannedstmt && m_c_local.m_estate->es_plannedstmt->hasIgnore);
+
+vlock:
+    if (checkConflict &&
         !ExecCheckIndexConstraints(m_local.m_reslot, m_c_local.m_estate, target_rel, part, &isgpi, bucketid,
                                    &conflictInfo, &conflictPartOid, &conflictBucketid)) {
-        ereport(WARNING, (errmsg("duplicate key value violates unique constraint in table \"%s\"",
-                                 RelationGetRelationName(target_rel))));
-        
+        if (m_c_global->m_upsertNothing) {
+            /* DUPLICATE KEY UPDATE NOTHING, but the conflict tuple must be visible at higher isolation levels */
+            ExecCheckTIDVisible(target_rel, m_c_local.m_estate, target_rel, &conflictInfo.conflictTid);
+        } else {
+            ereport(WARNING, (errmsg("duplicate key value violates unique constraint in table \"%s\"",
+                                     RelationGetRelationName(target_rel))));
+        }
+
         /* clear before ended */
         tableam_tops_free_tuple(tuple);
         (void)ExecClearTuple(m_local.m_reslot);
-        ExecCloseIndices(result_rel_info);
         ExecDoneStepInFusion(m_c_local.m_estate);
         if (bucket_rel != NULL) {
             bucketCloseRelation(bucket_rel);
@@ -313,7 +350,29 @@ unsigned long InsertFusion::ExecInsert(Relation rel, ResultRelInfo* result_rel_i
                                                 m_c_local.m_estate,
                                                 RELATION_IS_PARTITIONED(rel) ? partRel : NULL,
                                                 RELATION_IS_PARTITIONED(rel) ? part : NULL,
-                                                bucketid, NULL, NULL);
+                                                bucketid, m_c_global->m_upsertNothing ? &specConflict : NULL, NULL);
+    }
+
+    /*
+     * another transaction inserted the same key after our check, kill our tuple
+     * and look for the conflict tuple again.
+     */
+    if (specConflict) {
+        /* delete index tuples and mark them as dead */
+        ExecIndexTuplesState exec_index_tuples_state;
+        exec_index_tuples_state.estate = m_c_local.m_estate;
+        exec_index_tuples_state.targetPartRel = RELATION_IS_PARTITIONED(rel) ? partRel : NULL;
+        exec_index_tuples_state.p = RELATION_IS_PARTITIONED(rel) ? part : NULL;
+        exec_index_tuples_state.conflict = NULL;
+        exec_index_tuples_state.rollbackIndex = true;
+        tableam_tops_exec_delete_index_tuples(m_local.m_reslot, target_rel, NULL,
+                                              &(((HeapTuple)tuple)->t_self), exec_index_tuples_state, NULL);
+
+        /* rollback heap/uheap tuple */
+        tableam_tuple_abort_speculative(target_rel, tuple);
+        list_free_ext(recheck_indexes);
+        specConflict = false;
+        goto vlock;
     }
 
     list_free_ext(recheck_indexes);
@@ -325,9 +384,6 @@ unsigned long InsertFusion::ExecInsert(Relation rel, ResultRelInfo* result_rel_i
     /****************
      * step 3: done *
      ****************/
-    ExecCloseIndices(result_rel_info);
-
-
     ExecDoneStepInFusion(m_c_local.m_estate);
 
     if (bucket_rel != NULL) {
@@ -361,13 +417,26 @@ bool InsertFusion::execute(long max_rows, char* completionTag)
     init_gtt_storage(CMD_INSERT, result_rel_info);
     m_c_local.m_estate->es_result_relation_info = result_rel_info;
     m_c_local.m_estate->es_plannedstmt = m_global->m_planstmt;
-    refreshParameterIfNecessary();
+    if (m_c_global->m_upsertNothing) {
+        /* used to check the visibility of conflict tuples */
+        m_c_local.m_estate->es_snapshot = GetActiveSnapshot();
+    }
+    m_local.m_ledger_hash_exist = false;
+    m_local.m_ledger_relhash = 0;
 
     /************************
      * step 2: begin insert *
      ************************/
 
-    unsigned long nprocessed = (this->*(m_global->m_exec_func_ptr))(rel, result_rel_info);
+    /* all rows of a VALUES list share the opened relation and indexes */
+    unsigned long nprocessed = 0;
+    for (int row = 0; row < m_c_global->m_rowNum; row++) {
+        CHECK_FOR_INTERRUPTS();
+        refreshParameterIfNecessary(&m_c_global->m_rowTargets[row]);
+        nprocessed += (this->*(m_global->m_exec_func_ptr))(rel, result_rel_info);
+    }
+
+    ExecCloseIndices(result_rel_info);
     heap_close(rel, RowExclusiveLock);
 
     /****************
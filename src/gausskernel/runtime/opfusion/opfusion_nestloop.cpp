@@ -0,0 +1,200 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * ---------------------------------------------------------------------------------------
+ *
+ * opfusion_nestloop.cpp
+ *        Definition of nestloop index join operator for bypass executor.
+ *
+ * IDENTIFICATION
+ *        src/gausskernel/runtime/opfusion/opfusion_nestloop.cpp
+ *
+ * ---------------------------------------------------------------------------------------
+ */
+
+#include "opfusion/opfusion_nestloop.h"
+
+#include "access/tableam.h"
+#include "opfusion/opfusion_util.h"
+
+NestLoopIndexFusion::NestLoopIndexFusion(
+    MemoryContext context, CachedPlanSource* psrc, List* plantree_list, ParamListInfo params)
+    : OpFusion(context, psrc, plantree_list)
+{
+    MemoryContext old_context = NULL;
+
+    if (!IsGlobal()) {
+        old_context = MemoryContextSwitchTo(m_global->m_context);
+        InitGlobals();
+        MemoryContextSwitchTo(old_context);
+    } else {
+        m_c_global = ((NestLoopIndexFusion*)(psrc->opFusionObj))->m_c_global;
+    }
+    old_context = MemoryContextSwitchTo(m_local.m_localContext);
+    InitLocals(params);
+    MemoryContextSwitchTo(old_context);
+}
+
+void NestLoopIndexFusion::InitGlobals()
+{
+    NestLoop* node = (NestLoop*)m_global->m_planstmt->planTree;
+    IndexScan* inner = (IndexScan*)node->join.plan.righttree;
+
+    m_global->m_reloid = 0;
+    m_global->m_tupDesc = ExecCleanTypeFromTL(node->join.plan.targetlist, false);
+    m_global->m_attrno = (int16*)palloc(m_global->m_tupDesc->natts * sizeof(int16));
+
+    m_c_global = (NestLoopFusionGlobalVariable*)palloc0(sizeof(NestLoopFusionGlobalVariable));
+    m_c_global->m_fromInner = (bool*)palloc(m_global->m_tupDesc->natts * sizeof(bool));
+
+    /* output columns are plain Vars of either side's targetlist */
+    ListCell* lc = NULL;
+    int cur_resno = 1;
+    foreach (lc, node->join.plan.targetlist) {
+        TargetEntry* res = (TargetEntry*)lfirst(lc);
+        if (res->resjunk) {
+            continue;
+        }
+
+        Var* var = (Var*)res->expr;
+        m_global->m_attrno[cur_resno - 1] = var->varattno;
+        m_c_global->m_fromInner[cur_resno - 1] = (var->varno == INNER_VAR);
+        cur_resno++;
+    }
+
+    /* locate the inner scan keys compared with the outer row */
+    m_c_global->m_nestParamLoc = (NestParamLoc*)palloc0(list_length(inner->indexqual) * sizeof(NestParamLoc));
+    m_c_global->m_nestParamNum = 0;
+
+    int i = 0;
+    foreach (lc, inner->indexqual) {
+        if (IsA(lfirst(lc), OpExpr)) {
+            Expr* rightop = (Expr*)lsecond(((OpExpr*)lfirst(lc))->args);
+            if (IsA(rightop, RelabelType)) {
+                rightop = ((RelabelType*)rightop)->arg;
+            }
+
+            if (IsA(rightop, Param) && ((Param*)rightop)->paramkind == PARAM_EXEC) {
+                ListCell* nlc = NULL;
+                foreach (nlc, node->nestParams) {
+                    NestLoopParam* nlp = (NestLoopParam*)lfirst(nlc);
+                    if (nlp->paramno == ((Param*)rightop)->paramid) {
+                        m_c_global->m_nestParamLoc[m_c_global->m_nestParamNum].outerAttno = nlp->paramval->varattno;
+                        m_c_global->m_nestParamLoc[m_c_global->m_nestParamNum++].scanKeyIndx = i;
+                        break;
+                    }
+                }
+            }
+        }
+        i++;
+    }
+}
+
+void NestLoopIndexFusion::InitLocals(ParamListInfo params)
+{
+    NestLoop* node = (NestLoop*)m_global->m_planstmt->planTree;
+
+    initParams(params);
+    m_local.m_receiver = NULL;
+    m_local.m_isInsideRec = true;
+
+    ParamListInfo scanParams = m_local.m_outParams ? m_local.m_outParams : m_local.m_params;
+    m_local.m_scan = ScanFusion::getScanFusion((Node*)node->join.plan.lefttree, m_global->m_planstmt, scanParams);
+    m_c_local.m_inner =
+        (IndexScanFusion*)ScanFusion::getScanFusion((Node*)node->join.plan.righttree, m_global->m_planstmt, scanParams);
+
+    m_local.m_reslot = MakeSingleTupleTableSlot(m_global->m_tupDesc);
+    m_local.m_values = (Datum*)palloc0(m_global->m_tupDesc->natts * sizeof(Datum));
+    m_local.m_isnull = (bool*)palloc0(m_global->m_tupDesc->natts * sizeof(bool));
+}
+
+bool NestLoopIndexFusion::execute(long max_rows, char* completionTag)
+{
+    max_rows = FETCH_ALL;
+    bool success = false;
+    IndexScanFusion* inner = m_c_local.m_inner;
+    TupleDesc tupDesc = m_global->m_tupDesc;
+    Datum* values = m_local.m_values;
+    bool* isnull = m_local.m_isnull;
+    ParamListInfo params = m_local.m_outParams == NULL ? m_local.m_params : m_local.m_outParams;
+
+    MemoryContext oldContext = MemoryContextSwitchTo(m_local.m_tmpContext);
+
+    /* step 1: prepare, both sides are opened once for the whole join */
+    m_local.m_scan->refreshParameter(params);
+    m_local.m_scan->Init(max_rows);
+    inner->refreshParameter(params);
+    inner->Init(max_rows);
+
+    setReceiver();
+
+    /* step 2: rescan the inner index with the join keys of each outer row */
+    unsigned long nprocessed = 0;
+    TupleTableSlot* outerSlot = NULL;
+    TupleTableSlot* innerSlot = NULL;
+    while ((outerSlot = m_local.m_scan->getTupleSlot()) != NULL) {
+        for (int i = 0; i < m_c_global->m_nestParamNum; i++) {
+            NestParamLoc* loc = &m_c_global->m_nestParamLoc[i];
+            ScanKey key = &inner->m_scanKeys[loc->scanKeyIndx];
+
+            key->sk_argument = outerSlot->tts_values[loc->outerAttno - 1];
+            if (outerSlot->tts_isnull[loc->outerAttno - 1]) {
+                key->sk_flags |= SK_ISNULL;
+            } else {
+                key->sk_flags &= ~SK_ISNULL;
+            }
+        }
+
+        if (inner->m_scandesc != NULL) {
+            scan_handler_idx_rescan_local(inner->m_scandesc, inner->m_scanKeys, inner->m_keyNum, NULL, 0);
+        }
+
+        while ((innerSlot = inner->getTupleSlot()) != NULL) {
+            CHECK_FOR_INTERRUPTS();
+            for (int i = 0; i < tupDesc->natts; i++) {
+                TupleTableSlot* slot = m_c_global->m_fromInner[i] ? innerSlot : outerSlot;
+                values[i] = slot->tts_values[m_global->m_attrno[i] - 1];
+                isnull[i] = slot->tts_isnull[m_global->m_attrno[i] - 1];
+            }
+
+            HeapTuple tmptup = (HeapTuple)tableam_tops_form_tuple(tupDesc, values, isnull, HEAP_TUPLE);
+            (void)ExecStoreTuple(tmptup, m_local.m_reslot, InvalidBuffer, false);
+            (*m_local.m_receiver->receiveSlot)(m_local.m_reslot, m_local.m_receiver);
+            tableam_tops_free_tuple(tmptup);
+            tpslot_free_heaptuple(innerSlot);
+            nprocessed++;
+        }
+        tpslot_free_heaptuple(outerSlot);
+    }
+
+    success = true;
+
+    /* step 3: done */
+    if (m_local.m_isInsideRec) {
+        (*m_local.m_receiver->rDestroy)(m_local.m_receiver);
+    }
+
+    m_local.m_isCompleted = true;
+    inner->End(true);
+    m_local.m_scan->End(true);
+
+    errno_t errorno =
+        snprintf_s(completionTag, COMPLETION_TAG_BUFSIZE, COMPLETION_TAG_BUFSIZE - 1, "SELECT %lu", nprocessed);
+    securec_check_ss(errorno, "\0", "\0");
+    MemoryContextSwitchTo(oldContext);
+
+    /* instr unique sql - we assume that this is no nesting calling of Fusion::execute */
+    UniqueSQLStatCountReturnedRows(nprocessed);
+
+    return success;
+}
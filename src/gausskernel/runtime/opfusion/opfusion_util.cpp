@@ -34,6 +34,7 @@
 #include "libpq/pqformat.h"
 #include "mb/pg_wchar.h"
 #include "nodes/makefuncs.h"
+#include "nodes/nodeFuncs.h"
 #include "optimizer/clauses.h"
 #include "parser/parsetree.h"
 #include "utils/dynahash.h"
@@ -78,6 +79,10 @@ const char* getBypassReason(FusionType result)
         	return "Bypass executed through sort fusion";
         }
 
+        case NESTLOOP_INDEX_FUSION: {
+            return "Bypass executed through nestloop index join fusion";
+        }
+
         case NOBYPASS_NO_SIMPLE_PLAN: {
             return "Bypass not executed because the plan of query is not a simple plan";
         }
@@ -223,13 +228,20 @@ const char* getBypassReason(FusionType result)
             break;
         }
 
+        case NOBYPASS_NESTLOOP_NOT_INDEX_JOIN: {
+            return "Bypass not executed because only inner nestloop join of two index scans "
+                "without join filter is supported";
+            break;
+        }
+
         case NOBYPASS_REPLACE_NOT_SUPPORT: {
             return "Bypass not support REPLACE INTO statement";
             break;
         }
 		
         case NOBYPASS_UPSERT_NOT_SUPPORT: {
-            return "Bypass not support INSERT INTO ... ON DUPLICATE KEY UPDATE statement";
+            return "Bypass not support INSERT INTO ... ON DUPLICATE KEY UPDATE statement except UPDATE NOTHING on "
+                "plain heap table";
             break;
         }
 
@@ -488,7 +500,25 @@ FusionType checkFusionSort(Sort *node, ParamListInfo params)
 
     return BYPASS_OK;
  }
-template <bool is_dml, bool isonlyindex> FusionType checkFusionIndexScan(Node *node, ParamListInfo params)
+/* check whether param is set by the nestloop above the index scan */
+static bool checkFusionNestParam(Param *param, List *nestParams)
+{
+    if (param->paramkind != PARAM_EXEC) {
+        return false;
+    }
+
+    ListCell *lc = NULL;
+    foreach (lc, nestParams) {
+        if (((NestLoopParam *)lfirst(lc))->paramno == param->paramid) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+template <bool is_dml, bool isonlyindex>
+FusionType checkFusionIndexScan(Node *node, ParamListInfo params, List *nestParams = NIL)
 {
     List *tarlist = NULL;
     List *indexorderby = NULL;
@@ -601,7 +631,8 @@ template <bool is_dml, bool isonlyindex> FusionType checkFusionIndexScan(Node *n
             }
         }
 
-        if (IsA(rightop, Param) && !checkFusionParam((Param *)rightop, params)) {
+        if (IsA(rightop, Param) && !checkFusionParam((Param *)rightop, params) &&
+            !checkFusionNestParam((Param *)rightop, nestParams)) {
             return NOBYPASS_PARAM_TYPE_INVALID;
         }
     }
@@ -617,6 +648,111 @@ template <bool is_dml, bool isonlyindex> FusionType checkFusionIndexScan(Node *n
     return BYPASS_OK;
 }
 
+/* check whether every target is a plain Var, since columns are mapped by position */
+static bool checkNestLoopChildTargetlist(List *targetList)
+{
+    ListCell *lc = NULL;
+    foreach (lc, targetList) {
+        TargetEntry *res = (TargetEntry *)lfirst(lc);
+        if (res->resjunk || !IsA(res->expr, Var)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool checkNestLoopRelation(Index scanrelid, PlannedStmt *plannedstmt)
+{
+    Oid relid = getrelid(scanrelid, plannedstmt->rtable);
+    Relation rel = heap_open(relid, AccessShareLock);
+    bool result = !checkDMLRelation(rel, plannedstmt, false, false);
+    heap_close(rel, AccessShareLock);
+    return result;
+}
+
+/*
+ * check the nestloop of two plain index scans, the inner one is probed by
+ * the join keys of each outer row through nestParams.
+ */
+FusionType checkFusionNestLoop(NestLoop *node, PlannedStmt *plannedstmt, ParamListInfo params)
+{
+    Plan *outerPlan = node->join.plan.lefttree;
+    Plan *innerPlan = node->join.plan.righttree;
+
+    if (node->join.jointype != JOIN_INNER || node->join.joinqual != NIL || node->join.nulleqqual != NIL ||
+        node->join.plan.qual != NIL || node->nestParams == NIL) {
+        return NOBYPASS_NESTLOOP_NOT_INDEX_JOIN;
+    }
+
+    if (outerPlan == NULL || innerPlan == NULL || !IsA(outerPlan, IndexScan) || !IsA(innerPlan, IndexScan) ||
+        outerPlan->lefttree != NULL || innerPlan->lefttree != NULL) {
+        return NOBYPASS_NESTLOOP_NOT_INDEX_JOIN;
+    }
+
+    IndexScan *outerScan = (IndexScan *)outerPlan;
+    IndexScan *innerScan = (IndexScan *)innerPlan;
+    if (outerScan->scan.isPartTbl || innerScan->scan.isPartTbl) {
+        return NOBYPASS_NESTLOOP_NOT_INDEX_JOIN;
+    }
+
+    if (!checkNestLoopChildTargetlist(outerPlan->targetlist) || !checkNestLoopChildTargetlist(innerPlan->targetlist)) {
+        return NOBYPASS_NESTLOOP_NOT_INDEX_JOIN;
+    }
+
+    /* join keys must be outer columns */
+    ListCell *lc = NULL;
+    foreach (lc, node->nestParams) {
+        Var *paramval = ((NestLoopParam *)lfirst(lc))->paramval;
+        if (!IsA(paramval, Var) || paramval->varno != OUTER_VAR || paramval->varattno < 1 ||
+            paramval->varattno > list_length(outerPlan->targetlist)) {
+            return NOBYPASS_NESTLOOP_NOT_INDEX_JOIN;
+        }
+    }
+
+    /* output columns must be plain columns of either side */
+    foreach (lc, node->join.plan.targetlist) {
+        TargetEntry *res = (TargetEntry *)lfirst(lc);
+        if (res->resjunk) {
+            continue;
+        }
+
+        if (!IsA(res->expr, Var)) {
+            return NOBYPASS_TARGET_WITH_NO_TABLE_COL;
+        }
+
+        Var *var = (Var *)res->expr;
+        List *childTargetList = NIL;
+        if (var->varno == OUTER_VAR) {
+            childTargetList = outerPlan->targetlist;
+        } else if (var->varno == INNER_VAR) {
+            childTargetList = innerPlan->targetlist;
+        } else {
+            return NOBYPASS_NESTLOOP_NOT_INDEX_JOIN;
+        }
+
+        if (var->varattno < 1 || var->varattno > list_length(childTargetList)) {
+            return NOBYPASS_TARGET_WITH_SYS_COL;
+        }
+    }
+
+    FusionType ttype = checkFusionIndexScan<false, false>((Node *)outerPlan, params);
+    if (ttype > BYPASS_OK) {
+        return ttype;
+    }
+
+    ttype = checkFusionIndexScan<false, false>((Node *)innerPlan, params, node->nestParams);
+    if (ttype > BYPASS_OK) {
+        return ttype;
+    }
+
+    if (!checkNestLoopRelation(outerScan->scan.scanrelid, plannedstmt) ||
+        !checkNestLoopRelation(innerScan->scan.scanrelid, plannedstmt)) {
+        return NOBYPASS_DML_RELATION_NOT_SUPPORT;
+    }
+
+    return NESTLOOP_INDEX_FUSION;
+}
+
 /* check expression can be used for pruning */
 void CheckExprPartitionTable(Node* node, ParamListInfo params, FusionType* ftype)
 {
@@ -802,6 +938,12 @@ FusionType getSelectFusionType(List *stmt_list, ParamListInfo params)
             ftype = SORT_INDEX_FUSION;
             top_plan = top_plan->lefttree;
         }
+
+        /* check select for nestloop index join */
+        if (u_sess->attr.attr_sql.enable_beta_opfusion && !limitplan && IsA(top_plan, NestLoop) &&
+            ftype == SELECT_FUSION) {
+            return checkFusionNestLoop((NestLoop *)top_plan, plannedstmt, params);
+        }
 #endif
 
     /* check for partition table */
@@ -900,18 +1042,54 @@ void checkTargetlist(List *targetList, FusionType* ftype)
     return;
 }
 
+typedef struct ValuesRowContext {
+    Index scanrelid;
+    List *row;
+} ValuesRowContext;
+
+static Node *ValuesRowMutator(Node *node, ValuesRowContext *context)
+{
+    if (node == NULL) {
+        return NULL;
+    }
+
+    if (IsA(node, Var) && ((Var *)node)->varno == context->scanrelid) {
+        return (Node *)copyObject(list_nth(context->row, ((Var *)node)->varattno - 1));
+    }
+
+    return expression_tree_mutator(node, (Node * (*)(Node *, void *)) ValuesRowMutator, (void *)context);
+}
+
+/* build the targetlist of one VALUES row, by replacing the Vars of the values scan with its expressions */
+List *GetValuesRowTargetList(List *targetList, ValuesScan *scan, List *row)
+{
+    ValuesRowContext context;
+    context.scanrelid = scan->scan.scanrelid;
+    context.row = row;
+
+    return (List *)ValuesRowMutator((Node *)targetList, &context);
+}
+
 FusionType checkBaseResult(Plan* top_plan)
 {
     FusionType result = INSERT_FUSION;
     ModifyTable *node = (ModifyTable *)top_plan;
-    if (!IsA(linitial(node->plans), BaseResult)) {
-        return NOBYPASS_NO_SIMPLE_INSERT;
-    }
-    BaseResult *base = (BaseResult *)linitial(node->plans);
-    if (base->plan.lefttree != NULL || base->plan.initPlan != NIL || base->resconstantqual != NULL) {
+    if (IsA(linitial(node->plans), ValuesScan)) {
+        /* multi-row VALUES list */
+        ValuesScan *scan = (ValuesScan *)linitial(node->plans);
+        if (scan->scan.plan.lefttree != NULL || scan->scan.plan.initPlan != NIL || scan->scan.plan.qual != NIL) {
+            return NOBYPASS_NO_SIMPLE_INSERT;
+        }
+    } else if (!IsA(linitial(node->plans), BaseResult)) {
         return NOBYPASS_NO_SIMPLE_INSERT;
+    } else {
+        BaseResult *base = (BaseResult *)linitial(node->plans);
+        if (base->plan.lefttree != NULL || base->plan.initPlan != NIL || base->resconstantqual != NULL) {
+            return NOBYPASS_NO_SIMPLE_INSERT;
+        }
     }
-    if (node->upsertAction != UPSERT_NONE) {
+    /* DUPLICATE KEY UPDATE NOTHING only skips conflicting rows, the UPDATE part needs the executor */
+    if (node->upsertAction != UPSERT_NONE && node->upsertAction != UPSERT_NOTHING) {
         return NOBYPASS_UPSERT_NOT_SUPPORT;
     }
     if (node->isReplace) {
@@ -947,7 +1125,7 @@ FusionType getInsertFusionType(List *stmt_list, ParamListInfo params)
         return ttype;
     }
     ModifyTable *node = (ModifyTable *)top_plan;
-    BaseResult *base = (BaseResult *)linitial(node->plans);
+    Plan *subplan = (Plan *)linitial(node->plans);
 
     /* check relation */
     Index res_rel_idx = linitial_int((List*)linitial(plannedstmt->resultRelations));
@@ -988,13 +1166,32 @@ FusionType getInsertFusionType(List *stmt_list, ParamListInfo params)
         heap_close(rel, AccessShareLock);
         return NOBYPASS_PARTITION_TYPE_NOT_SUPPORT;
     }
+    /* conflict retry in fusion only handles plain heap relations */
+    if (node->upsertAction == UPSERT_NOTHING &&
+        (RELATION_IS_PARTITIONED(rel) || RELATION_OWN_BUCKET(rel) || RelationIsUstoreFormat(rel) ||
+        rel->rd_isblockchain || rel->rd_mlogoid != InvalidOid)) {
+        heap_close(rel, AccessShareLock);
+        return NOBYPASS_UPSERT_NOT_SUPPORT;
+    }
     heap_close(rel, AccessShareLock);
     /*
      * check targetlist
      * maybe expr type is FuncExpr because of type conversion.
      */
-    List *targetlist = base->plan.targetlist;
-    checkTargetlist(targetlist, &ftype);
+    List *targetlist = subplan->targetlist;
+    if (IsA(subplan, ValuesScan)) {
+        ListCell *lc = NULL;
+        foreach (lc, ((ValuesScan *)subplan)->values_lists) {
+            List *rowTargetList = GetValuesRowTargetList(targetlist, (ValuesScan *)subplan, (List *)lfirst(lc));
+            checkTargetlist(rowTargetList, &ftype);
+            list_free_deep(rowTargetList);
+            if (ftype > BYPASS_OK) {
+                break;
+            }
+        }
+    } else {
+        checkTargetlist(targetlist, &ftype);
+    }
     return ftype;
 }
 
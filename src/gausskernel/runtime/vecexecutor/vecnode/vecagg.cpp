@@ -740,6 +740,8 @@ VecAggState* ExecInitVecAggregation(VecAgg* node, EState* estate, int eflags)
             dorado::VecHashAggCodeGen::SonicHashAggCodeGen(aggstate);
         } else if (node->aggstrategy == AGG_HASHED) {
             dorado::VecHashAggCodeGen::HashAggCodeGen(aggstate);
+        } else if (node->aggstrategy == AGG_SORTED) {
+            dorado::VecSortCodeGen::SortAggCodeGen(aggstate);
         }
     }
 #endif
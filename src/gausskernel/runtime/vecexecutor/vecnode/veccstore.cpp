@@ -175,6 +175,75 @@ void OptimizeProjectionAndFilter(CStoreScanState* node)
     node->m_fSimpleMap = simple_map;
 }
 
+static inline bool IsRuntimeFilterIntType(Oid type_oid)
+{
+    return type_oid == INT2OID || type_oid == INT4OID || type_oid == INT8OID;
+}
+
+/*
+ * Apply the bloom filters pushed down by hash joins to the scanned batch.
+ * A filter is published only after the join's build side is complete, so
+ * filters that are not ready yet are skipped. Hash join keys never match
+ * NULL, so NULL keys are dropped as well.
+ */
+static void ApplyRuntimeFilter(CStoreScanState* node, VectorBatch* p_scan_batch)
+{
+    Plan* plan = node->ps.plan;
+    filter::BloomFilter** bf_array = node->ps.state->es_bloom_filter.bfarray;
+    bool* sel = p_scan_batch->m_sel;
+    bool filtered = false;
+    ListCell* lc1 = NULL;
+    ListCell* lc2 = NULL;
+
+    if (bf_array == NULL || list_length(plan->var_list) != list_length(plan->filterIndexList)) {
+        return;
+    }
+
+    forboth(lc1, plan->var_list, lc2, plan->filterIndexList)
+    {
+        Var* var = (Var*)lfirst(lc1);
+        filter::BloomFilter* bf = bf_array[lfirst_int(lc2)];
+
+        if (bf == NULL || !IsA(var, Var) || var->varattno <= 0 || var->varattno > p_scan_batch->m_cols) {
+            continue;
+        }
+
+        /*
+         * Only integer keys are probed per row. String probes convert every
+         * value into a palloc'd cstring, which costs more than the join probe.
+         */
+        if (!IsRuntimeFilterIntType(var->vartype) || !IsRuntimeFilterIntType(bf->getDataType())) {
+            continue;
+        }
+
+        if (!filtered) {
+            errno_t rc = memset_s(sel, BatchMaxSize * sizeof(bool), true, BatchMaxSize * sizeof(bool));
+            securec_check(rc, "\0", "\0");
+            filtered = true;
+        }
+
+        ScalarVector* vec = &p_scan_batch->m_arr[var->varattno - 1];
+        for (int i = 0; i < p_scan_batch->m_rows; i++) {
+            if (!sel[i]) {
+                continue;
+            }
+
+            if (vec->IsNull(i)) {
+                sel[i] = false;
+            } else {
+                int64 value = (var->vartype == INT2OID)   ? DatumGetInt16(vec->m_vals[i])
+                              : (var->vartype == INT4OID) ? DatumGetInt32(vec->m_vals[i])
+                                                          : DatumGetInt64(vec->m_vals[i]);
+                sel[i] = bf->includeLong(value);
+            }
+        }
+    }
+
+    if (filtered) {
+        p_scan_batch->Pack(sel);
+    }
+}
+
 VectorBatch* ApplyProjectionAndFilter(CStoreScanState* node, VectorBatch* p_scan_batch, ExprDoneCond* done)
 {
     List* qual = NIL;
@@ -246,6 +315,16 @@ VectorBatch* ApplyProjectionAndFilter(CStoreScanState* node, VectorBatch* p_scan
             node->ss_deltaScan = false;
         }
 
+        // Drop rows that the runtime filters of hash joins above us reject
+        //
+        if (node->ps.plan->var_list != NIL) {
+            ApplyRuntimeFilter(node, p_scan_batch);
+            if (p_scan_batch->m_rows == 0) {
+                p_out_batch->m_rows = 0;
+                goto done;
+            }
+        }
+
         // Project the final result
         //
         if (!simple_map) {
@@ -924,6 +924,8 @@ void HashJoinTbl::PushDownFilterIfNeed()
     filter::BloomFilter** bf_array = m_runtime->bf_runtime.bf_array;
     List* bf_var_list = m_runtime->bf_runtime.bf_var_list;
 
+    ResetRuntimeBloomFilter(&m_runtime->bf_runtime);
+
     if (u_sess->attr.attr_sql.enable_bloom_filter && MEMORY_HASH == m_strategy && !m_complicateJoinKey &&
         list_length(m_cache) != 0 && m_rows <= DEFAULT_ORC_BLOOM_FILTER_ENTRIES * 5) {
         for (int i = 0; i < list_length(bf_var_list); i++) {
@@ -3700,6 +3702,8 @@ void HashJoinTbl::ResetNecessary()
         return;
     }
 
+    ResetRuntimeBloomFilter(&m_runtime->bf_runtime);
+
     if (m_strategy == GRACE_HASH) {
         /*
          * Temp files may have already been released, must close temp files
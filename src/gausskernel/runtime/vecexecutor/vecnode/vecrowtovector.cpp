@@ -228,8 +228,12 @@ void VectorizeTupleBatchMode(VectorBatch *pBatch, TupleTableSlot **slots,
 
     /* for not late read, deform all the column into batch */
     if (!lateRead) {
-        for (j = 0; j < rows; j++) {
-            tableam_tslot_formbatch(slots[j], pBatch, j, scanstate->maxcolId);
+        if (rows > 0 && slots[0]->tts_tupslotTableAm == TAM_HEAP) {
+            heap_slots_formbatch(slots, pBatch, rows, scanstate->maxcolId);
+        } else {
+            for (j = 0; j < rows; j++) {
+                tableam_tslot_formbatch(slots[j], pBatch, j, scanstate->maxcolId);
+            }
         }
 
         for (i = 0; i < scanstate->maxcolId; i++) {
@@ -133,13 +133,17 @@ vnumeric_avg(PG_FUNCTION_ARGS)
 				
 					if(NUMERIC_FLAG_IS_BI(num1Flags) && NUMERIC_FLAG_IS_BI(num2Flags))
 					{
-						arg1 = NUMERIC_FLAG_IS_BI128(num1Flags);
-						arg2 = NUMERIC_FLAG_IS_BI128(num2Flags);
-						ctl.store_pos = cell->m_val[idx].val;
-						// call big integer fast add function
-						(BiAggFunMatrix[BI_AGG_ADD][arg1][arg2])(leftarg, rightarg, &ctl);
-						// ctl.store_pos may be pointed to new address.
-						cell->m_val[idx].val = ctl.store_pos;
+						// same scale, add in place
+						if (!BiAggAddSameScale(leftarg, rightarg))
+						{
+							arg1 = NUMERIC_FLAG_IS_BI128(num1Flags);
+							arg2 = NUMERIC_FLAG_IS_BI128(num2Flags);
+							ctl.store_pos = cell->m_val[idx].val;
+							// call big integer fast add function
+							(BiAggFunMatrix[BI_AGG_ADD][arg1][arg2])(leftarg, rightarg, &ctl);
+							// ctl.store_pos may be pointed to new address.
+							cell->m_val[idx].val = ctl.store_pos;
+						}
 					} 
 					else // call numeric_add
 					{
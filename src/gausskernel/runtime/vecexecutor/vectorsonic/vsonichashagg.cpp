@@ -367,10 +367,22 @@ SonicHashAgg::SonicHashAgg(VecAggState* runtime, int arrSize) : SonicHash(arrSiz
     m_arrayExpandSize = 0;
     m_segNum = 0;
     m_segBucket = NULL;
+    m_flushPending = false;
+    m_flushed = false;
+    m_buildRows = 0;
 
     VecAgg* node = (VecAgg*)(m_runtime->ss.ps.plan);
     m_econtext = m_runtime->ss.ps.ps_ExprContext;
 
+    /*
+     * Only the lower stage of a two-phase agg, whose output the upper agg
+     * combines again on the same groups, may output the same group twice.
+     * The planner marks it with upper_combine; other non-final aggs, such as
+     * the one removing duplicates below count(distinct), must not flush.
+     */
+    m_partialFlush = !IS_PGXC_COORDINATOR && node->upper_combine && !node->single_node && !node->is_final &&
+                     node->plan.qual == NIL;
+
     /* init aggregation information */
     initAggInfo();
 
@@ -833,7 +845,8 @@ bool SonicHashAgg::ResetNecessary(VecAggState* node)
      * rescan the existing hash table, and have not spill to disk;
      * no need to build it again.
      */
-    if (m_memControl.spillToDisk == false && node->ss.ps.lefttree->chgParam == NULL && agg_node->aggParams == NULL) {
+    if (m_memControl.spillToDisk == false && !m_flushed && node->ss.ps.lefttree->chgParam == NULL &&
+        agg_node->aggParams == NULL) {
         m_runState = AGG_FETCH;
         return false;
     }
@@ -875,6 +888,9 @@ bool SonicHashAgg::ResetNecessary(VecAggState* node)
 
     m_rows = 0;
     m_fill_table_rows = 0;
+    m_buildRows = 0;
+    m_flushPending = false;
+    m_flushed = false;
     m_partFileSource = NULL;
     m_overflowFileSource = NULL;
 
@@ -942,7 +958,7 @@ VectorBatch* SonicHashAgg::Run()
                     }
                 }
 
-                if (!m_memControl.spillToDisk) {
+                if (!m_memControl.spillToDisk && !m_flushPending) {
                     /* Early free left tree after hash table built */
                     ExecEarlyFree(outerPlanState(m_runtime));
 
@@ -962,6 +978,13 @@ VectorBatch* SonicHashAgg::Run()
                 res = Probe();
 
                 if (BatchIsNull(res)) {
+                    /* Groups flushed to the upper agg, go on building from the left tree */
+                    if (m_flushPending) {
+                        resetHashTableForFlush();
+                        m_runState = AGG_BUILD;
+                        break;
+                    }
+
                     /* If not matched, turn to next partition */
                     if (true == m_memControl.spillToDisk) {
                         m_strategy = HASH_IN_DISK;
@@ -996,10 +1019,17 @@ void SonicHashAgg::Build()
     /* load data, build hash table & calculate agg function */
     WaitState oldStatus = pgstat_report_waitstatus(STATE_EXEC_HASHAGG_BUILD_HASH);
     for (;;) {
+        /* hand the groups to the upper agg rather than spilling unreduced rows */
+        if (m_partialFlush && judgePartialFlush()) {
+            m_flushPending = true;
+            break;
+        }
+
         outer_batch = m_sonicHashSource->getBatch();
         if (unlikely(BatchIsNull(outer_batch))) {
             break;
         }
+        m_buildRows += outer_batch->m_rows;
 
         /* first try to expand hash table if needed */
         tryExpandHashTable();
@@ -2010,6 +2040,83 @@ void SonicHashAgg::tryExpandHashTable()
     }
 }
 
+/*
+ * @Description	: Judge whether a lower stage agg should emit its hash table now.
+ *				  After sampling the first batches of the round, if the groups barely
+ *				  reduce the input and the hash table is close to the work mem, spilling
+ *				  would write out almost every input row only to read it back, while the
+ *				  upper agg combines the groups anyway.
+ * @return		: Return true if the current hash table should be flushed.
+ */
+bool SonicHashAgg::judgePartialFlush()
+{
+    int64 used_size = 0;
+    int64 free_size = 0;
+
+    /* only rounds reading from the left tree, spilled data is not partial any more */
+    if (m_strategy != HASH_IN_MEMORY || m_memControl.spillToDisk) {
+        return false;
+    }
+
+    if (m_buildRows < SONIC_AGG_FLUSH_SAMPLE_BATCHES * BatchMaxSize) {
+        return false;
+    }
+
+    if (m_rows < m_buildRows * SONIC_AGG_FLUSH_GROUP_RATIO) {
+        return false;
+    }
+
+    calcHashContextSize(m_memControl.hashContext, &used_size, &free_size);
+    if ((uint64)used_size < m_memControl.totalMem * SONIC_AGG_FLUSH_MEM_RATIO) {
+        return false;
+    }
+
+    MEMCTL_LOG(DEBUG2,
+        "[VecSonicHashAgg(%d)]: flush %ld groups of %ld input rows to upper agg, usedmem: %ldKB.",
+        m_runtime->ss.ps.plan->plan_node_id,
+        m_rows,
+        m_buildRows,
+        used_size / 1024L);
+
+    return true;
+}
+
+/*
+ * @Description	: Rebuild an empty hash table of the current size after its groups
+ *				  have been flushed, so that building goes on from the left tree.
+ */
+void SonicHashAgg::resetHashTableForFlush()
+{
+    m_rows = 0;
+    m_buildRows = 0;
+    m_flushPending = false;
+    m_flushed = true;
+
+    /* reset context to free the memory */
+    MemoryContextResetAndDeleteChildren(m_memControl.hashContext);
+
+    {
+        AutoContextSwitch memSwitch(m_memControl.hashContext);
+
+        /* reinitialize sonic data array */
+        m_arrayElementSize = 0;
+        m_arrayExpandSize = 0;
+        initDataArray();
+
+        /* the grown table size already fits in memory, keep it for the next round */
+        m_hashSize = calcHashTableSize<false, false>(m_hashSize);
+
+        /* reinitialize sonic hash table */
+        initHashTable();
+
+        /* reset runtime build function */
+        BindingFp();
+    }
+
+    m_stateLog.restore = false;
+    m_stateLog.lastProcessIdx = 0;
+}
+
 /*
  * @Description	: expand hash table with new hash size
  */
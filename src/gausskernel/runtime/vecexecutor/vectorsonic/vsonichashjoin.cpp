@@ -56,6 +56,17 @@
 #define GETLOCID(val, mask) ((val) & (mask))
 #endif
 
+/*
+ * Probing a bucket array larger than the cache is bound by memory latency,
+ * so bucket heads are prefetched this many rows ahead of the lookup. Smaller
+ * bucket arrays stay cache resident and are probed without prefetching.
+ */
+#define SONIC_PROBE_PREFETCH_DISTANCE 16
+#define SONIC_PROBE_PREFETCH_MIN_SIZE (4 * 1024 * 1024)
+
+#define SONIC_PROBE_NEED_PREFETCH(partition, BucketType) \
+    ((uint64)(partition)->m_hashSize * sizeof(BucketType) >= SONIC_PROBE_PREFETCH_MIN_SIZE)
+
 /*
  * @Description:  Check condition for sonic hash join.
  * 	If return value is true, goto Sonic hash join.
@@ -1153,6 +1164,7 @@ inline VectorBatch* SonicHashJoin::probeMemoryTable(SonicHashSource* probeP)
     Assert(mem_partition->m_status == partitionStatusMemory);
 
     mask = mem_partition->m_mask;
+    bool prefetchBucket = SONIC_PROBE_NEED_PREFETCH(mem_partition, BucketType);
 
     for (;;) {
         switch (m_probeStatus) {
@@ -1184,6 +1196,10 @@ inline VectorBatch* SonicHashJoin::probeMemoryTable(SonicHashSource* probeP)
                  * the hash value between build and probe is same.
                  */
                 for (int i = 0; i < nrows; i++, loc3++) {
+                    if (!isSegHashTable && prefetchBucket && i + SONIC_PROBE_PREFETCH_DISTANCE < nrows) {
+                        __builtin_prefetch(&hashBucket[GETLOCID(loc3[SONIC_PROBE_PREFETCH_DISTANCE], mask)]);
+                    }
+
                     if (isSegHashTable) {
                         loc_id = (BucketType)mem_partition->m_segBucket->getNthDatum(GETLOCID(*loc3, mask));
                     } else {
@@ -1657,10 +1673,13 @@ inline VectorBatch* SonicHashJoin::probePartition(SonicHashSource* probeP)
     BucketType* hash_bucket = NULL;
     SonicDatumArray* seg_bucket = NULL;
 
+    bool prefetch_bucket = false;
+
     if (m_partLoadedOffset >= 0) {
         mask = mem_partition->m_mask;
         seg_bucket = mem_partition->m_segBucket;
         hash_bucket = (BucketType*)mem_partition->m_bucket;
+        prefetch_bucket = !isSegHashTable && SONIC_PROBE_NEED_PREFETCH(mem_partition, BucketType);
     }
 
     for (;;) {
@@ -1697,6 +1716,10 @@ inline VectorBatch* SonicHashJoin::probePartition(SonicHashSource* probeP)
                  * the hash value between build and probe is same.
                  */
                 for (int i = 0; i < nrows; i++, loc3++) {
+                    if (prefetch_bucket && i + SONIC_PROBE_PREFETCH_DISTANCE < nrows) {
+                        __builtin_prefetch(&hash_bucket[GETLOCID(loc3[SONIC_PROBE_PREFETCH_DISTANCE], mask)]);
+                    }
+
                     part_idx = *loc3 % m_partNum;
 
                     /* check the status of the inner partition */
@@ -2787,6 +2810,8 @@ void SonicHashJoin::pushDownFilterIfNeed()
     ScalarValue val;
     SonicHashMemPartition* mem_partition = NULL;
 
+    ResetRuntimeBloomFilter(&m_runtime->bf_runtime);
+
     if (u_sess->attr.attr_sql.enable_bloom_filter && MEMORY_HASH == m_strategy && !m_complicatekey &&
         m_rows <= DEFAULT_ORC_BLOOM_FILTER_ENTRIES * 5) {
         Assert(m_probeIdx == 0);
@@ -2980,6 +3005,8 @@ void SonicHashJoin::ResetNecessary()
         return;
     }
 
+    ResetRuntimeBloomFilter(&m_runtime->bf_runtime);
+
     if (m_strategy == GRACE_HASH)
         closeAllFiles();
 
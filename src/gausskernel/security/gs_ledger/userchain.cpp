@@ -248,13 +248,14 @@ int user_hash_attrno(const TupleDesc rd_att)
  * data_string: combination of hash that calculate from each attribute
  * tabledesc: tuple description of user table
  * tuple: row data of user table
+ *
+ * Returns the length of the combination string.
  */
-static void hash_combine_tuple_data(char *buf, int buf_size, TupleDesc tabledesc, HeapTuple tuple)
+static int hash_combine_tuple_data(char *buf, int buf_size, TupleDesc tabledesc, HeapTuple tuple)
 {
     int natts = tabledesc->natts;
     int buflen = 0;
-    errno_t rc = EOK;
-    char hash_str[UINT64STRSIZE + 1] = {0};
+    int rc;
     Datum *values = (Datum *) palloc0(natts * sizeof(Datum));
     bool *nulls = (bool *) palloc0(natts * sizeof(bool));
     heap_deform_tuple(tuple, tabledesc, values, nulls);
@@ -264,14 +265,14 @@ static void hash_combine_tuple_data(char *buf, int buf_size, TupleDesc tabledesc
         }
 
         uint64 col_hash = compute_hash(tabledesc->attrs[i]->atttypid, values[i], LOCATOR_TYPE_HASH);
-        rc = snprintf_s(hash_str, UINT64STRSIZE + 1, UINT64STRSIZE, "%lu", col_hash);
-        securec_check_ss(rc, "", "");
-        rc = snprintf_s(buf + buflen, buf_size - buflen, buf_size - buflen - 1, "%s", hash_str);
+        /* print straight into place, snprintf_s returns the length written */
+        rc = snprintf_s(buf + buflen, buf_size - buflen, buf_size - buflen - 1, "%lu", col_hash);
         securec_check_ss(rc, "", "");
-        buflen += strlen(hash_str);
+        buflen += rc;
     }
     pfree_ext(values);
     pfree_ext(nulls);
+    return buflen;
 }
 
 /*
@@ -301,10 +302,10 @@ static uint64 gen_user_tuple_hash(Relation rel, HeapTuple tuple)
     TupleDesc tabledesc = RelationGetDescr(rel);
     int data_size = UINT64STRSIZE * tabledesc->natts + 1;
     char *data_string = (char *)palloc0(data_size * sizeof(char));
-    hash_combine_tuple_data(data_string, data_size, tabledesc, tuple);
+    int data_len = hash_combine_tuple_data(data_string, data_size, tabledesc, tuple);
 
     uint8 sum[16];
-    if (pg_md5_binary(data_string, strlen(data_string), sum) == false) {
+    if (pg_md5_binary(data_string, data_len, sum) == false) {
         pfree_ext(data_string);
         ereport(ERROR, (errcode(ERRCODE_OUT_OF_MEMORY), errmsg("out of memory")));
     }
@@ -1200,7 +1200,15 @@ static void slot_deform_tuple(TupleTableSlot *slot, uint32 natts)
 }
 
 
-static void slot_deform_batch(TupleTableSlot *slot, VectorBatch* batch, int cur_rows, uint32 natts)
+/*
+ * slot_deform_batch
+ *		Deform the physical tuple of the slot straight into row cur_rows of
+ *		the batch, from attribute startatt up through the natts'th column.
+ *		Attributes before startatt must be fixed-width, non-null columns with
+ *		a valid attcacheoff (see heap_slots_formbatch).
+ */
+static void slot_deform_batch(TupleTableSlot *slot, VectorBatch* batch, int cur_rows, uint32 natts,
+    uint32 startatt = 0)
 {
     HeapTuple tuple = (HeapTuple)slot->tts_tuple;
     Assert(tuple->tupTableType == HEAP_TUPLE);
@@ -1219,8 +1227,8 @@ static void slot_deform_batch(TupleTableSlot *slot, VectorBatch* batch, int cur_
      * Check whether the first call for this tuple, and initialize or restore
      * loop state.
      */
-    attnum = 0;
-    off = 0;
+    attnum = startatt;
+    off = (startatt == 0) ? 0 : (att[startatt - 1]->attcacheoff + att[startatt - 1]->attlen);
     slow = false;
 
     /*
@@ -1661,6 +1669,91 @@ void heap_slot_formbatch(TupleTableSlot* slot, VectorBatch* batch, int cur_rows,
     }
 }
 
+/*
+ * heap_slots_formbatch
+ *		Deform the heap tuples of rows slots into the first rows of the batch,
+ *		up through the natts'th column.
+ *
+ * Columns before the first variable-width or uncached attribute sit at the
+ * same offset in every tuple without nulls, so they are copied column by
+ * column straight from attcacheoff, and only the remaining columns are
+ * walked tuple by tuple.  Tuples having nulls, fewer attributes than natts
+ * or compressed data go through heap_slot_formbatch as before.
+ */
+void heap_slots_formbatch(TupleTableSlot** slots, VectorBatch* batch, int rows, int natts)
+{
+    TupleDesc tupleDesc = NULL;
+    Form_pg_attribute* att = NULL;
+    int prefix = 0;
+    int fastrows = 0;
+    int i, j;
+    bool* fast = NULL;
+
+    if (rows <= 0) {
+        return;
+    }
+
+    /* the first row also sets up attcacheoff for the rest of them */
+    heap_slot_formbatch(slots[0], batch, 0, natts);
+    if (rows == 1) {
+        return;
+    }
+
+    tupleDesc = slots[0]->tts_tupleDescriptor;
+    att = tupleDesc->attrs;
+    if (tupleDesc->tdTableAmType != TAM_USTORE) {
+        while (prefix < natts && att[prefix]->attlen > 0 && att[prefix]->attcacheoff >= 0) {
+            prefix++;
+        }
+    }
+
+    if (prefix == 0) {
+        for (j = 1; j < rows; j++) {
+            heap_slot_formbatch(slots[j], batch, j, natts);
+        }
+        return;
+    }
+
+    fast = (bool*)palloc(sizeof(bool) * rows);
+    for (j = 1; j < rows; j++) {
+        HeapTuple tuple = (HeapTuple)slots[j]->tts_tuple;
+
+        fast[j] = (tuple != NULL && !HeapTupleHasNulls(tuple) && !HEAP_TUPLE_IS_COMPRESSED(tuple->t_data) &&
+                   GetAttrNumber(slots[j], natts) == natts);
+        if (fast[j]) {
+            fastrows++;
+        } else {
+            heap_slot_formbatch(slots[j], batch, j, natts);
+        }
+    }
+
+    if (fastrows > 0) {
+        for (i = 0; i < prefix; i++) {
+            Form_pg_attribute thisatt = att[i];
+            ScalarVector* pVector = &batch->m_arr[i];
+
+            for (j = 1; j < rows; j++) {
+                if (fast[j]) {
+                    HeapTupleHeader tup = ((HeapTuple)slots[j]->tts_tuple)->t_data;
+
+                    pVector->m_vals[j] = fetchatt(thisatt, (char*)tup + tup->t_hoff + thisatt->attcacheoff);
+                    SET_NOTNULL(pVector->m_flag[j]);
+                }
+            }
+        }
+
+        if (prefix < natts) {
+            for (j = 1; j < rows; j++) {
+                if (fast[j]) {
+                    slot_deform_batch(slots[j], batch, j, natts, prefix);
+                }
+            }
+        }
+    }
+
+    pfree(fast);
+}
+
 /*
  * heap_slot_getsomeattrs
  *		This function forces the entries of the slot's Datum/isnull
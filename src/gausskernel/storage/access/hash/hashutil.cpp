@@ -22,6 +22,7 @@
 #include "utils/lsyscache.h"
 #include "utils/rel.h"
 #include "utils/rel_gs.h"
+#include "utils/uuid.h"
 #include "storage/buf/buf_internals.h"
 
 #define CALC_NEW_BUCKET(old_bucket, lowmask) ((old_bucket) | ((lowmask) + 1))
@@ -79,6 +80,28 @@ uint32 _hash_datum2hashkey(Relation rel, Datum key)
 
     /* XXX assumes index has only one attribute */
     procinfo = index_getprocinfo(rel, 1, HASHPROC);
+
+    /*
+     * The usual point-lookup key types are hashed here directly, saving the
+     * function call setup on every probe and insert.  The results must stay
+     * identical to those of the hash procedures.
+     */
+    if (procinfo->fn_addr == hashint4) {
+        return DatumGetUInt32(hash_uint32((uint32)DatumGetInt32(key)));
+    } else if (procinfo->fn_addr == hashint8) {
+        /* see hashint8 */
+        int64 val = DatumGetInt64(key);
+        uint32 lohalf = (uint32)val;
+        uint32 hihalf = (uint32)((uint64)val >> 32);
+
+        lohalf ^= (val >= 0) ? hihalf : ~hihalf;
+        return DatumGetUInt32(hash_uint32(lohalf));
+    } else if (procinfo->fn_addr == hashoid) {
+        return DatumGetUInt32(hash_uint32((uint32)DatumGetObjectId(key)));
+    } else if (procinfo->fn_addr == uuid_hash) {
+        return DatumGetUInt32(hash_any(DatumGetUUIDP(key)->data, UUID_LEN));
+    }
+
     collation = rel->rd_indcollation[0];
 
     return DatumGetUInt32(FunctionCall1Coll(procinfo, collation, key));
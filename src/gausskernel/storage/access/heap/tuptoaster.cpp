@@ -224,11 +224,17 @@ struct varlena *heap_tuple_untoast_attr_slice(struct varlena *attr, int64 slice_
 
     if (VARATT_IS_COMPRESSED(preslice)) {
         PGLZ_Header *tmp = (PGLZ_Header *)preslice;
-        Size size = PGLZ_RAW_SIZE(tmp) + VARHDRSZ;
+        int32 rawsize = PGLZ_RAW_SIZE(tmp);
+
+        /* A slice that ends before the value does needs only a prefix decompressed */
+        if (slice_length >= 0 && slice_offset + slice_length < rawsize)
+            rawsize = (int32)(slice_offset + slice_length);
+
+        Size size = rawsize + VARHDRSZ;
 
         preslice = (struct varlena *)palloc(size);
         SET_VARSIZE(preslice, size);
-        pglz_decompress(tmp, VARDATA(preslice));
+        pglz_decompress_prefix(tmp, VARDATA(preslice), rawsize);
 
         if (tmp != (PGLZ_Header *)attr)
             pfree(tmp);
@@ -423,14 +423,7 @@ int32 _bt_compare(Relation rel, int keysz, ScanKey scankey, Page page, OffsetNum
         datum = index_getattr(itup, scankey->sk_attno, itupdesc, &isNull);
 
         if (likely((!(scankey->sk_flags & SK_ISNULL)) && !isNull)) {
-            /* btint4cmp */
-            if (scankey->sk_func.fn_oid == BTINT4CMP_OID) {
-                if ((int32)datum != (int32)scankey->sk_argument) {
-                    result = ((int32)datum > (int32)scankey->sk_argument) ? 1 : -1;
-                } else {
-                    continue;
-                }
-            } else {
+            if (!_bt_inline_compare(scankey, datum, &result)) {
                 result = DatumGetInt32(
                     FunctionCall2Coll(&scankey->sk_func, scankey->sk_collation, datum, scankey->sk_argument));
             }
@@ -250,11 +250,11 @@ XLogRedoAction XLogCheckBlockDataRedoAction(XLogBlockDataParse *datadecode, Redo
         uint16 hole_length;
 
         imagedata = XLogBlockDataRecGetImage(datadecode, &hole_offset, &hole_length);
-        if (imagedata == NULL) {
+        if (imagedata == NULL ||
+            !RestoreBlockImage(imagedata, hole_offset, hole_length, (char *)bufferinfo->pageinfo.page)) {
             ereport(ERROR,
                     (errcode(ERRCODE_DATA_EXCEPTION), errmsg("XLogCheckRedoAction failed to restore block image")));
         } else {
-            RestoreBlockImage(imagedata, hole_offset, hole_length, (char *)bufferinfo->pageinfo.page);
             XlogUpdateFullPageWriteLsn(bufferinfo->pageinfo.page, bufferinfo->lsn);
             MakeRedoBufferDirty(bufferinfo);
             return BLK_RESTORED;
@@ -29,6 +29,8 @@
 #include "storage/smgr/segment.h"
 #include "storage/buf/bufpage.h"
 #include "access/redo_common.h"
+#include "lz4.h"
+#include <zstd.h>
 
 /*
  * Returns information about the block that a block reference refers to.
@@ -93,14 +95,27 @@ char *XLogRecGetBlockData(XLogReaderState *record, uint8 block_id, Size *len)
 /*
  * Restore a full-page image from a backup block attached to an XLOG record.
  *
- * Returns the buffer number containing the page.
+ * Returns false if a compressed image could not be decompressed.
  *
  * Reconstruct for batchredo
  */
-void RestoreBlockImage(const char *bkp_image, uint16 hole_offset, uint16 hole_length, char *page)
+bool RestoreBlockImage(const char *bkp_image, uint16 hole_offset, uint16 hole_length, char *page)
 {
     errno_t rc = EOK;
 
+    if (BKPIMAGE_IS_COMPRESSED(hole_offset)) {
+        /* the whole page is stored compressed, see XLogCompressBackupBlock */
+        int compressed_len = BLCKSZ - hole_length;
+        int len = 0;
+        if ((hole_offset & BKPIMAGE_COMPRESS_MASK) == BKPIMAGE_COMPRESS_LZ4) {
+            len = LZ4_decompress_safe(bkp_image, page, compressed_len, BLCKSZ);
+        } else if ((hole_offset & BKPIMAGE_COMPRESS_MASK) == BKPIMAGE_COMPRESS_ZSTD) {
+            size_t zlen = ZSTD_decompress(page, BLCKSZ, bkp_image, compressed_len);
+            len = ZSTD_isError(zlen) ? -1 : (int)zlen;
+        }
+        return len == BLCKSZ;
+    }
+
     if (hole_length == 0) {
         rc = memcpy_s(page, BLCKSZ, bkp_image, BLCKSZ);
         securec_check(rc, "", "");
@@ -113,12 +128,13 @@ void RestoreBlockImage(const char *bkp_image, uint16 hole_offset, uint16 hole_le
 
         Assert(hole_offset + hole_length <= BLCKSZ);
         if (hole_offset + hole_length == BLCKSZ)
-            return;
+            return true;
 
         rc = memcpy_s(page + (hole_offset + hole_length), BLCKSZ - (hole_offset + hole_length), bkp_image + hole_offset,
                       BLCKSZ - (hole_offset + hole_length));
         securec_check(rc, "", "");
     }
+    return true;
 }
 
 void XLogRecGetPhysicalBlock(const XLogReaderState *record, uint8 blockId, 
@@ -44,6 +44,8 @@
 
 #include "catalog/storage_xlog.h"
 #include "storage/buf/buf_internals.h"
+#include "storage/buf/bufmgr.h"
+#include "storage/smgr/smgr.h"
 #include "storage/ipc.h"
 #include "storage/standby.h"
 #include "utils/hsearch.h"
@@ -115,6 +117,7 @@ static void GetSlotIds(XLogReaderState *record);
 static void GetUndoSlotIds(XLogReaderState *record);
 STATIC LogDispatcher *CreateDispatcher();
 static void DestroyRecoveryWorkers();
+static void PrefetchCloseRels();
 
 static void DispatchRecordWithPages(XLogReaderState *, List *);
 static void DispatchRecordWithoutPage(XLogReaderState *, List *);
@@ -646,6 +649,7 @@ static void DestroyRecoveryWorkers()
 
         DestroyPageRedoWorker(g_dispatcher->readLine.managerThd);
         DestroyPageRedoWorker(g_dispatcher->readLine.readThd);
+        PrefetchCloseRels();
         pfree(g_dispatcher->rtoXlogBufState.readsegbuf);
         pfree(g_dispatcher->rtoXlogBufState.readBuf);
         pfree(g_dispatcher->rtoXlogBufState.errormsg_buf);
@@ -713,6 +717,66 @@ static bool RmgrGistRecordInfoValid(XLogReaderState *record, uint8 minInfo, uint
     return false;
 }
 
+/*
+ * The dispatcher never closes smgr handles on its own, so prefetch keeps the
+ * ones it opens in a small round-robin cache instead of leaking one per
+ * relation ever replayed.  The cache owns its entries, so any smgrclose()
+ * elsewhere in this thread clears the slot rather than leaving it dangling.
+ */
+static SMgrRelation PrefetchOpenRel(const RelFileNode &rnode)
+{
+    for (uint32 i = 0; i < REDO_PREFETCH_REL_CACHE_SIZE; i++) {
+        SMgrRelation reln = g_dispatcher->prefetchRels[i];
+        if (reln != NULL && RelFileNodeEquals(reln->smgr_rnode.node, rnode)) {
+            return reln;
+        }
+    }
+
+    uint32 slot = g_dispatcher->prefetchRelNext;
+    g_dispatcher->prefetchRelNext = (slot + 1) % REDO_PREFETCH_REL_CACHE_SIZE;
+    if (g_dispatcher->prefetchRels[slot] != NULL) {
+        smgrclose(g_dispatcher->prefetchRels[slot]);
+    }
+    smgrsetowner(&g_dispatcher->prefetchRels[slot], smgropen(rnode, InvalidBackendId));
+    return g_dispatcher->prefetchRels[slot];
+}
+
+/* Drop every cached handle; called before relation files may be removed. */
+static void PrefetchCloseRels()
+{
+    for (uint32 i = 0; i < REDO_PREFETCH_REL_CACHE_SIZE; i++) {
+        if (g_dispatcher->prefetchRels[i] != NULL) {
+            smgrclose(g_dispatcher->prefetchRels[i]);
+        }
+    }
+    g_dispatcher->prefetchRelNext = 0;
+}
+
+/*
+ * Hint the kernel to start reading the data blocks a record is about to
+ * replay on.  The record still has to go through the batch and page redo
+ * queues, so the pipeline depth is the lookahead distance: by the time a
+ * redo worker reads the page, it is usually already in the page cache.
+ * Blocks that redo overwrites wholesale (full-page image or re-init) don't
+ * need their old contents and are skipped.
+ */
+static void PrefetchRecordBlocks(XLogReaderState *record)
+{
+    for (int blockId = 0; blockId <= record->max_block_id; blockId++) {
+        DecodedBkpBlock *block = &record->blocks[blockId];
+        if (!block->in_use || block->has_image || (block->flags & BKPBLOCK_WILL_INIT)) {
+            continue;
+        }
+        RelFileNode rnode;
+        ForkNumber forknum;
+        BlockNumber blkno;
+        if (!XLogRecGetBlockTag(record, (uint8)blockId, &rnode, &forknum, &blkno)) {
+            continue;
+        }
+        PrefetchSharedBuffer(PrefetchOpenRel(rnode), forknum, blkno);
+    }
+}
+
 /* Run from the dispatcher thread. */
 void DispatchRedoRecordToFile(XLogReaderState *record, List *expectedTLIs, TimestampTz recordXTime)
 {
@@ -757,6 +821,12 @@ void DispatchRedoRecordToFile(XLogReaderState *record, List *expectedTLIs, Times
 #ifdef ENABLE_UT
             TestXLogReaderProbe(UTEST_EVENT_RTO_DISPATCH_REDO_RECORD_TO_FILE, __FUNCTION__, record);
 #endif
+            if (XactWillRemoveRelFiles(record) || IsSmgrTruncate(record) || IsDataBaseDrop(record) ||
+                IsTableSpaceDrop(record)) {
+                PrefetchCloseRels();
+            } else if (g_instance.attr.attr_storage.enable_redo_prefetch) {
+                PrefetchRecordBlocks(record);
+            }
             g_dispatchTable[rmid].rm_dispatch(record, expectedTLIs, recordXTime);
         } else {
             DispatchDefaultRecord(record, expectedTLIs, recordXTime);
@@ -643,16 +643,33 @@ void RedoPageManagerDistributeBlockRecord(HTAB *redoItemHash, XLogRecParseState
     HASH_SEQ_STATUS status;
     RedoItemHashEntry *redoItemEntry = NULL;
     HTAB *curMap = redoItemHash;
+    /*
+     * hand items to each worker a cache line at a time; SPSCBlockingQueuePutN
+     * still spins until a full worker queue has room for the batch
+     */
+    void *pending[MAX_REDO_WORKERS_PER_PARSE][SPSC_QUEUE_PUT_BATCH];
+    uint32 pendingNum[MAX_REDO_WORKERS_PER_PARSE] = {0};
+    Assert(WorkerNumPerMng <= MAX_REDO_WORKERS_PER_PARSE);
     hash_seq_init(&status, curMap);
 
     while ((redoItemEntry = (RedoItemHashEntry *)hash_seq_search(&status)) != NULL) {
         uint32 workId = GetWorkerId(&redoItemEntry->redoItemTag, WorkerNumPerMng);
-        AddPageRedoItem(myRedoLine->redoThd[workId], redoItemEntry->head);
+        pending[workId][pendingNum[workId]++] = redoItemEntry->head;
+        if (pendingNum[workId] == SPSC_QUEUE_PUT_BATCH) {
+            (void)SPSCBlockingQueuePutN(myRedoLine->redoThd[workId]->queue, pending[workId], pendingNum[workId]);
+            pendingNum[workId] = 0;
+        }
 
         if (hash_search(curMap, (void *)&redoItemEntry->redoItemTag, HASH_REMOVE, NULL) == NULL)
             ereport(ERROR, (errcode(ERRCODE_DATA_CORRUPTED), errmsg("hash table corrupted")));
     }
 
+    for (uint32 i = 0; i < WorkerNumPerMng; ++i) {
+        if (pendingNum[i] > 0) {
+            (void)SPSCBlockingQueuePutN(myRedoLine->redoThd[i]->queue, pending[i], pendingNum[i]);
+        }
+    }
+
     if (parsestate != NULL) {
         RedoPageManagerDistributeToAllOneBlock(parsestate);
     }
@@ -1939,6 +1956,21 @@ static void CheckAndDoForceFinish(XLogReaderState *xlogreader)
     }
 }
 
+/*
+ * Decode the record in the read page worker, so that the startup thread, which
+ * dispatches every record, only has to route it. A record that fails to decode
+ * is queued as is: the startup thread decodes it again and reports the error
+ * with its own error level, as before.
+ */
+static void DecodeRecordForDispatch(XLogReaderState *xlogreader)
+{
+    char *errormsg = NULL;
+
+    if (xlogreader->isPRProcess && !xlogreader->isDecode) {
+        (void)DecodeXLogRecord(xlogreader, (XLogRecord *)xlogreader->readRecordBuf, &errormsg);
+    }
+}
+
 /* read xlog for parellel */
 void XLogReadPageWorkerMain()
 {
@@ -1965,6 +1997,7 @@ void XLogReadPageWorkerMain()
         }
         GetRedoStartTime(g_redoWorker->timeCostList[TIME_COST_STEP_3]);
         XLogReaderState *newxlogreader = NewReaderState(xlogreader);
+        DecodeRecordForDispatch(xlogreader);
         CountAndGetRedoTime(g_redoWorker->timeCostList[TIME_COST_STEP_3], g_redoWorker->timeCostList[TIME_COST_STEP_4]);
         PutRecordToReadQueue(xlogreader);
         CountAndGetRedoTime(g_redoWorker->timeCostList[TIME_COST_STEP_4], g_redoWorker->timeCostList[TIME_COST_STEP_5]);
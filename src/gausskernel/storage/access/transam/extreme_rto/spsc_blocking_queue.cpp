@@ -49,6 +49,7 @@ namespace extreme_rto {
 
 const uint32 MAX_REDO_QUE_TAKE_DELAY = 200; /* 100 us */
 const uint32 MAX_REDO_QUE_IDEL_TAKE_DELAY = 1000;
+const uint32 MIN_REDO_QUE_TAKE_DELAY = 10;
 const uint32 SLEEP_COUNT_QUE_TAKE = 0xFFF;
 
 const int QUEUE_CAPACITY_MIN_LIMIT = 2;
@@ -68,6 +69,8 @@ SPSCBlockingQueue *SPSCBlockingQueueCreate(uint32 capacity, CallBackFunc func)
     uint32 mask = capacity - 1;
     pg_atomic_init_u32(&queue->writeHead, 0);
     pg_atomic_init_u32(&queue->readTail, 0);
+    pg_atomic_init_u64(&queue->fullWaitCnt, 0);
+    pg_atomic_init_u64(&queue->emptyWaitCnt, 0);
     queue->capacity = capacity;
     queue->mask = mask;
     queue->maxUsage = 0;
@@ -81,10 +84,45 @@ void SPSCBlockingQueueDestroy(SPSCBlockingQueue *queue)
     pfree(queue);
 }
 
+/*
+ * Wait until the queue holds an element past tail, returns the write head seen.
+ *
+ * Spin first, calling the interrupt callback, then sleep with a delay that
+ * starts short and doubles up to the configured maximum, so a consumer that
+ * just ran dry wakes up quickly while an idle one still costs little CPU.
+ */
+static uint32 SPSCBlockingQueueWaitNotEmpty(SPSCBlockingQueue *queue, uint32 tail)
+{
+    uint32 head = pg_atomic_read_u32(&queue->writeHead);
+    uint32 count = 0;
+    long sleeptime = MIN_REDO_QUE_TAKE_DELAY;
+
+    while (COUNT(head, tail, queue->mask) == 0) {
+        ++count;
+        /* here we sleep, let the cpu to do other important work */
+        if ((count & SLEEP_COUNT_QUE_TAKE) == SLEEP_COUNT_QUE_TAKE) {
+            long maxsleep = t_thrd.page_redo_cxt.sleep_long ? MAX_REDO_QUE_IDEL_TAKE_DELAY : MAX_REDO_QUE_TAKE_DELAY;
+            pg_atomic_write_u64(&queue->emptyWaitCnt, pg_atomic_read_u64(&queue->emptyWaitCnt) + 1);
+            pg_usleep(Min(sleeptime, maxsleep));
+            sleeptime = Min(sleeptime * 2, maxsleep);
+        }
+        if (queue->callBackFunc != NULL) {
+            queue->callBackFunc();
+        }
+        head = pg_atomic_read_u32(&queue->writeHead);
+    }
+
+    t_thrd.page_redo_cxt.sleep_long = false;
+    return head;
+}
+
 bool SPSCBlockingQueuePut(SPSCBlockingQueue *queue, void *element)
 {
     uint32 head = pg_atomic_read_u32(&queue->writeHead);
     uint32 tail = pg_atomic_read_u32(&queue->readTail);
+    if (SPACE(head, tail, queue->mask) == 0) {
+        pg_atomic_write_u64(&queue->fullWaitCnt, pg_atomic_read_u64(&queue->fullWaitCnt) + 1);
+    }
     while (SPACE(head, tail, queue->mask) == 0) {
         if (queue->callBackFunc != NULL) {
             queue->callBackFunc();
@@ -114,6 +152,49 @@ bool SPSCBlockingQueuePut(SPSCBlockingQueue *queue, void *element)
     return true;
 }
 
+/*
+ * Put n elements, publishing the write head once for as many of them as there
+ * is room, instead of once per element. The consumer sees them in order.
+ */
+bool SPSCBlockingQueuePutN(SPSCBlockingQueue *queue, void **elements, uint32 n)
+{
+    uint32 head = pg_atomic_read_u32(&queue->writeHead);
+    uint32 done = 0;
+
+    while (done < n) {
+        uint32 tail = pg_atomic_read_u32(&queue->readTail);
+        if (SPACE(head, tail, queue->mask) == 0) {
+            pg_atomic_write_u64(&queue->fullWaitCnt, pg_atomic_read_u64(&queue->fullWaitCnt) + 1);
+        }
+        while (SPACE(head, tail, queue->mask) == 0) {
+            if (queue->callBackFunc != NULL) {
+                queue->callBackFunc();
+            }
+            tail = pg_atomic_read_u32(&queue->readTail);
+        }
+
+        /* see SPSCBlockingQueuePut() */
+        pg_memory_barrier();
+        uint32 batch = Min(SPACE(head, tail, queue->mask), n - done);
+        uint32 tmpCnt = COUNT(head, tail, queue->mask) + batch;
+        if (tmpCnt > queue->maxUsage) {
+            pg_atomic_write_u32(&queue->maxUsage, tmpCnt);
+        }
+
+        for (uint32 i = 0; i < batch; i++) {
+            queue->buffer[(head + i) & queue->mask] = elements[done + i];
+        }
+
+        /* Make sure the index is updated after the buffer has been written. */
+        pg_write_barrier();
+
+        head = (head + batch) & queue->mask;
+        pg_atomic_write_u32(&queue->writeHead, head);
+        done += batch;
+    }
+    return true;
+}
+
 uint32 SPSCGetQueueCount(SPSCBlockingQueue *queue)
 {
     uint32 head = pg_atomic_read_u32(&queue->writeHead);
@@ -123,29 +204,9 @@ uint32 SPSCGetQueueCount(SPSCBlockingQueue *queue)
 
 void *SPSCBlockingQueueTake(SPSCBlockingQueue *queue)
 {
-    uint32 head;
-    uint32 tail;
-    uint32 count = 0;
-    long sleeptime;
-    tail = pg_atomic_read_u32(&queue->readTail);
-    head = pg_atomic_read_u32(&queue->writeHead);
-    while (COUNT(head, tail, queue->mask) == 0) {
-        ++count;
-        /* here we sleep, let the cpu to do other important work */
-        if ((count & SLEEP_COUNT_QUE_TAKE) == SLEEP_COUNT_QUE_TAKE) {
-            if (t_thrd.page_redo_cxt.sleep_long)
-                sleeptime = MAX_REDO_QUE_IDEL_TAKE_DELAY;
-            else
-                sleeptime = MAX_REDO_QUE_TAKE_DELAY;
-            pg_usleep(sleeptime);
-        }
-        if (queue->callBackFunc != NULL) {
-            queue->callBackFunc();
-        }
-        head = pg_atomic_read_u32(&queue->writeHead);
-    }
+    uint32 tail = pg_atomic_read_u32(&queue->readTail);
+    (void)SPSCBlockingQueueWaitNotEmpty(queue, tail);
 
-    t_thrd.page_redo_cxt.sleep_long = false;
     /* Make sure the buffer is read after the index. */
     pg_read_barrier();
 
@@ -160,29 +221,9 @@ void *SPSCBlockingQueueTake(SPSCBlockingQueue *queue)
 
 bool SPSCBlockingQueueGetAll(SPSCBlockingQueue *queue, void ***eleArry, uint32 *eleNum)
 {
-    uint32 head;
-    uint32 tail;
-    uint32 count = 0;
-    long sleeptime;
+    uint32 tail = pg_atomic_read_u32(&queue->readTail);
+    uint32 head = SPSCBlockingQueueWaitNotEmpty(queue, tail);
 
-    tail = pg_atomic_read_u32(&queue->readTail);
-    head = pg_atomic_read_u32(&queue->writeHead);
-    while (COUNT(head, tail, queue->mask) == 0) {
-        ++count;
-        /* here we sleep, let the cpu to do other important work */
-        if ((count & SLEEP_COUNT_QUE_TAKE) == SLEEP_COUNT_QUE_TAKE) {
-            if (t_thrd.page_redo_cxt.sleep_long)
-                sleeptime = MAX_REDO_QUE_IDEL_TAKE_DELAY;
-            else
-                sleeptime = MAX_REDO_QUE_TAKE_DELAY;
-            pg_usleep(sleeptime);
-        }
-        if (queue->callBackFunc != NULL) {
-            queue->callBackFunc();
-        }
-        head = pg_atomic_read_u32(&queue->writeHead);
-    }
-    t_thrd.page_redo_cxt.sleep_long = false;
     /* Make sure the buffer is read after the index. */
     pg_read_barrier();
     head = head & (queue->mask);
@@ -231,28 +272,9 @@ bool SPSCBlockingQueueIsEmpty(SPSCBlockingQueue *queue)
 
 void *SPSCBlockingQueueTop(SPSCBlockingQueue *queue)
 {
-    uint32 head;
-    uint32 tail;
-    uint32 count = 0;
-    long sleeptime;
-    tail = pg_atomic_read_u32(&queue->readTail);
-    head = pg_atomic_read_u32(&queue->writeHead);
-    while (COUNT(head, tail, queue->mask) == 0) {
-        ++count;
-        /* here we sleep, let the cpu to do other important work */
-        if ((count & SLEEP_COUNT_QUE_TAKE) == SLEEP_COUNT_QUE_TAKE) {
-            if (t_thrd.page_redo_cxt.sleep_long)
-                sleeptime = MAX_REDO_QUE_IDEL_TAKE_DELAY;
-            else
-                sleeptime = MAX_REDO_QUE_TAKE_DELAY;
-            pg_usleep(sleeptime);
-        }
-        if (queue->callBackFunc != NULL) {
-            queue->callBackFunc();
-        }
-        head = pg_atomic_read_u32(&queue->writeHead);
-    }
-    t_thrd.page_redo_cxt.sleep_long = false;
+    uint32 tail = pg_atomic_read_u32(&queue->readTail);
+    (void)SPSCBlockingQueueWaitNotEmpty(queue, tail);
+
     pg_read_barrier();
     void *elem = queue->buffer[tail];
     return elem;
@@ -279,7 +301,9 @@ void SPSCBlockingQueuePop(SPSCBlockingQueue *queue)
 void DumpQueue(const SPSCBlockingQueue *queue)
 {
     ereport(LOG, (errmodule(MOD_REDO), errcode(ERRCODE_LOG),
-                  errmsg("[REDO_LOG_TRACE]queue info: writeHead %u, readTail %u, capacity %u, mask %u",
-                         queue->writeHead, queue->readTail, queue->capacity, queue->mask)));
+                  errmsg("[REDO_LOG_TRACE]queue info: writeHead %u, readTail %u, capacity %u, mask %u, "
+                         "maxUsage %u, fullWaitCnt %lu, emptyWaitCnt %lu",
+                         queue->writeHead, queue->readTail, queue->capacity, queue->mask, queue->maxUsage,
+                         queue->fullWaitCnt, queue->emptyWaitCnt)));
 }
 }  // namespace extreme_rto
@@ -278,6 +278,7 @@ static CLogXidStatus TransactionLogFetch(TransactionId transactionId)
 {
     CLogXidStatus xidstatus;
     XLogRecPtr xidlsn;
+    knl_t_xact_context::XidStatusCacheEnt* slot = NULL;
 
     /*
      * Before going to the commit log manager, check our single item cache to
@@ -301,6 +302,20 @@ static CLogXidStatus TransactionLogFetch(TransactionId transactionId)
         return CLOG_XID_STATUS_ABORTED;
     }
 
+    /*
+     * Then the direct-mapped cache.  Normal xids never wrap in 64 bits, so an
+     * entry that matches is still the final status of that transaction.
+     */
+    slot = &t_thrd.xact_cxt.xidStatusCache[transactionId & (XID_STATUS_CACHE_SIZE - 1)];
+    if (TransactionIdEquals(transactionId, slot->xid)) {
+        t_thrd.xact_cxt.cachedFetchXid = slot->xid;
+        t_thrd.xact_cxt.cachedFetchXidStatus = slot->status;
+        t_thrd.xact_cxt.cachedCommitLSN = slot->lsn;
+        t_thrd.xact_cxt.latestFetchXid = slot->xid;
+        t_thrd.xact_cxt.latestFetchXidStatus = slot->status;
+        return slot->status;
+    }
+
     /*
      * Get the transaction status.
      */
@@ -313,6 +328,9 @@ static CLogXidStatus TransactionLogFetch(TransactionId transactionId)
         t_thrd.xact_cxt.cachedFetchXid = transactionId;
         t_thrd.xact_cxt.cachedFetchXidStatus = xidstatus;
         t_thrd.xact_cxt.cachedCommitLSN = xidlsn;
+        slot->xid = transactionId;
+        slot->status = xidstatus;
+        slot->lsn = xidlsn;
     }
 
     t_thrd.xact_cxt.latestFetchXid = transactionId;
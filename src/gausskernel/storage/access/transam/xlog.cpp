@@ -117,6 +117,7 @@
 #include "utils/builtins.h"
 #include "utils/elog.h"
 #include "utils/guc.h"
+#include "utils/log2hist.h"
 #include "utils/pg_lsn.h"
 #include "utils/ps_status.h"
 #include "utils/relmapper.h"
@@ -187,6 +188,7 @@
 const int ONE_SECOND_TO_MICROSECOND = 1000000L;
 const uint64 PAGE_SIZE_BYTES = 4096;
 const uint64 XLOG_FLUSH_SIZE_INIT = 1024 * 1024;
+const uint64 XLOG_FLUSH_HIST_REPORT_INTERVAL = 60 * ONE_SECOND_TO_MICROSECOND;
 
 const int SIZE_OF_UINT64 = 8;
 const int SIZE_OF_UINT32 = 4;
@@ -1969,6 +1971,54 @@ static char *GetXLogBuffer(XLogRecPtr ptr, PGPROC *proc)
     return t_thrd.xlog_cxt.cachedPos + ptr % XLOG_BLCKSZ;
 }
 
+/*
+ * Copy WAL starting at 'startptr' from the shared WAL buffers into 'buf',
+ * as long as the pages are still there.  Returns the number of bytes copied,
+ * which is less than 'count' once a page is found that has already been
+ * replaced (or was never in the buffers); the caller reads the rest from the
+ * segment files.  Only WAL that has been flushed may be asked for.
+ *
+ * WALBufMappingLock is held in shared mode while copying a page, which keeps
+ * AdvanceXLInsertBuffer() from recycling it under us.  The lock is taken per
+ * page: walsender reads go up to walsender_max_send_size, and inserters that
+ * cross a page boundary must not wait behind a copy of several megabytes.
+ */
+Size XLogReadFromBuffers(char *buf, XLogRecPtr startptr, Size count)
+{
+    XLogRecPtr ptr = startptr;
+    Size nbytes = count;
+    char *dst = buf;
+    errno_t errorno = EOK;
+
+    if (count == 0 || RecoveryInProgress()) {
+        return 0;
+    }
+
+    while (nbytes > 0) {
+        uint32 idx = XLogRecPtrToBufIdx(ptr);
+        Size offset = ptr % XLOG_BLCKSZ;
+        Size npagebytes = Min(nbytes, XLOG_BLCKSZ - offset);
+        XLogRecPtr expectedEndPtr = ptr - offset + XLOG_BLCKSZ;
+
+        LWLockAcquire(WALBufMappingLock, LW_SHARED);
+        if (t_thrd.shemem_ptr_cxt.XLogCtl->xlblocks[idx] != expectedEndPtr) {
+            LWLockRelease(WALBufMappingLock);
+            break;
+        }
+
+        errorno = memcpy_s(dst, npagebytes, t_thrd.shemem_ptr_cxt.XLogCtl->pages + idx * (Size)XLOG_BLCKSZ + offset,
+                           npagebytes);
+        securec_check(errorno, "", "");
+        LWLockRelease(WALBufMappingLock);
+
+        dst += npagebytes;
+        ptr += npagebytes;
+        nbytes -= npagebytes;
+    }
+
+    return count - nbytes;
+}
+
 /*
  * Converts a "usable byte position" to XLogRecPtr. A usable byte position
  * is the position starting from the beginning of WAL, excluding all WAL
@@ -3263,6 +3313,35 @@ static void XLogFlushCore(XLogRecPtr writeRqstPtr)
     WakeupWalSemaphore(&g_instance.wal_cxt.walFlushWaitLock->l.sem);
 }
 
+static inline uint64 XLogFlushMovingAvg(uint64 avg, uint64 sample)
+{
+    return (avg == 0) ? sample : (avg * 7 + sample) / 8;
+}
+
+/*
+ * How long the walwriter may hold a flush waiting for more records to be copied.
+ *
+ * Holding for w lets about w / recordInterval more commits share one flush, at
+ * the price of up to w extra commit latency. There is nothing to gain once
+ * records arrive slower than a flush completes, and past half a flush latency
+ * the next flush would batch them anyway, so the window is 0 at low rates and
+ * half the observed flush latency at high rates. Without any samples yet the
+ * static wal_flush_timeout applies.
+ */
+static uint64 XLogAdaptiveFlushWindow(void)
+{
+    uint64 flushLatency = g_instance.wal_cxt.flushLatencyAvg;
+    uint64 recordInterval = g_instance.wal_cxt.recordIntervalAvg;
+
+    if (flushLatency == 0) {
+        return (uint64)g_instance.attr.attr_storage.wal_flush_timeout;
+    }
+    if (recordInterval >= flushLatency) {
+        return 0;
+    }
+    return flushLatency / 2;
+}
+
 /*
  * Flush xlog, but without specifying exactly where to flush to.
  *
@@ -3352,6 +3431,8 @@ bool XLogBackgroundFlush(void)
     uint64 averageXlogFlushBytes = (totalXlogIterTimes == 0) ? 0 : totalXlogIterBytes / totalXlogIterTimes;
     uint64 curAverageXlogFlushBytes = (averageXlogFlushBytes == 0) ? XLOG_FLUSH_SIZE_INIT :
                                       (averageXlogFlushBytes / PAGE_SIZE_BYTES + 1) * PAGE_SIZE_BYTES;
+    uint64 flushWindow = g_instance.attr.attr_storage.wal_flush_adaptive ?
+                         XLogAdaptiveFlushWindow() : (uint64)g_instance.attr.attr_storage.wal_flush_timeout;
     do {
         curr_entry_ptr = next_entry_ptr;
         curr_entry_idx = next_entry_idx;
@@ -3383,7 +3464,7 @@ bool XLogBackgroundFlush(void)
          */
         if (next_entry_ptr->status == WAL_NOT_COPIED) {
             if (((curr_entry_ptr->endLSN - startLSN) > curAverageXlogFlushBytes) ||
-                (GetCurrentTimestamp() - stTime >= (uint64)g_instance.attr.attr_storage.wal_flush_timeout)) {
+                (GetCurrentTimestamp() - stTime >= flushWindow)) {
                 break;
             }
             pg_usleep(g_instance.attr.attr_storage.wal_flush_delay);
@@ -3441,7 +3522,35 @@ bool XLogBackgroundFlush(void)
     }
 #endif
 
+    uint64 flushStart = GetCurrentTimestamp();
     XLogFlushCore(WriteRqstPtr);
+    uint64 flushEnd = GetCurrentTimestamp();
+
+    /*
+     * Feed the adaptive window: the flush latency, and the mean interval between
+     * records copied since the previous flush, capped so that an idle period
+     * does not keep the window closed for long once load comes back.
+     */
+    g_instance.wal_cxt.flushLatencyAvg = XLogFlushMovingAvg(g_instance.wal_cxt.flushLatencyAvg,
+                                                            flushEnd - flushStart);
+    if (g_instance.wal_cxt.lastBackgroundFlushTime != 0) {
+        uint64 interval = (flushStart - (uint64)g_instance.wal_cxt.lastBackgroundFlushTime) / entry_count;
+        g_instance.wal_cxt.recordIntervalAvg = XLogFlushMovingAvg(g_instance.wal_cxt.recordIntervalAvg,
+            Min(interval, (uint64)ONE_SECOND_TO_MICROSECOND));
+    }
+    g_instance.wal_cxt.lastBackgroundFlushTime = (TimestampTz)flushEnd;
+
+    if (g_instance.wal_cxt.xlogFlushStats->statSwitch) {
+        XlogFlushStatistics *stats = g_instance.wal_cxt.xlogFlushStats;
+        Log2HistAdd(stats->batchSizeHist, WAL_FLUSH_HIST_BUCKETS, entry_count);
+        Log2HistAdd(stats->waitTimeHist, WAL_FLUSH_HIST_BUCKETS, flushStart - stTime);
+        if (flushEnd - (uint64)stats->lastHistReportTime >= XLOG_FLUSH_HIST_REPORT_INTERVAL) {
+            Log2HistReport(LOG, stats->batchSizeHist, WAL_FLUSH_HIST_BUCKETS,
+                           "walwriter flush batch size(entries) histogram");
+            Log2HistReport(LOG, stats->waitTimeHist, WAL_FLUSH_HIST_BUCKETS, "walwriter flush wait time(us) histogram");
+            stats->lastHistReportTime = (TimestampTz)flushEnd;
+        }
+    }
 
 #ifndef ENABLE_MULTIPLE_NODES
 #ifdef USE_ASSERT_CHECKING
@@ -6682,6 +6791,23 @@ void XLOGShmemInit(void)
     allocptr = (char *)TYPEALIGN(XLOG_BLCKSZ, allocptr);
     t_thrd.shemem_ptr_cxt.XLogCtl->pages = allocptr;
 
+#ifdef __USE_NUMA
+    /*
+     * Every inserter on every node copies into the page ring, so spread its
+     * pages over all nodes instead of leaving them on the node that happens to
+     * touch them first. Must be done before the memset below.
+     */
+    if (nNumaNodes > 1) {
+        Size pageSize = (Size)sysconf(_SC_PAGESIZE);
+        char *ringBegin = (char *)TYPEALIGN(pageSize, allocptr);
+        char *ringEnd = (char *)TYPEALIGN_DOWN(pageSize,
+            allocptr + (Size)XLOG_BLCKSZ * g_instance.attr.attr_storage.XLOGbuffers);
+        if (ringEnd > ringBegin) {
+            numa_interleave_memory(ringBegin, ringEnd - ringBegin, numa_all_nodes_ptr);
+        }
+    }
+#endif
+
     /* The memory of the memset sometimes exceeds 2 GB. so, memset_s cannot be used. */
     MemSet(t_thrd.shemem_ptr_cxt.XLogCtl->pages, 0, (Size)XLOG_BLCKSZ * g_instance.attr.attr_storage.XLOGbuffers);
 
@@ -746,10 +746,10 @@ XLogRedoAction XLogReadBufferForRedoExtended(XLogReaderState *record, uint8 bloc
         uint16 hole_offset;
         uint16 hole_length;
         imagedata = XLogRecGetBlockImage(record, block_id, &hole_offset, &hole_length);
-        if (NULL == imagedata)
+        if (NULL == imagedata ||
+            !RestoreBlockImage(imagedata, hole_offset, hole_length, (char *)bufferinfo->pageinfo.page))
             ereport(ERROR, (errcode(ERRCODE_DATA_EXCEPTION),
                             errmsg("XLogReadBufferForRedoExtended failed to restore block image")));
-        RestoreBlockImage(imagedata, hole_offset, hole_length, (char *)bufferinfo->pageinfo.page);
         XlogUpdateFullPageWriteLsn(bufferinfo->pageinfo.page, bufferinfo->lsn);
         if (readmethod == WITH_NORMAL_CACHE) {
             MarkBufferDirty(bufferinfo->buf);
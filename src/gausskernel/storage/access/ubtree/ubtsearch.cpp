@@ -480,19 +480,12 @@ int32 UBTreeCompare(Relation rel, BTScanInsert key, Page page, OffsetNumber offn
         datum = index_getattr(itup, scankey->sk_attno, itupdesc, &isNull);
 
         if (likely((!(scankey->sk_flags & SK_ISNULL)) && !isNull)) {
-            /* btint4cmp */
-            if (scankey->sk_func.fn_oid == BTINT4CMP_OID) {
-                if ((int32)datum != (int32)scankey->sk_argument) {
-                    result = ((int32)datum > (int32)scankey->sk_argument) ? 1 : -1;
-                } else {
-                    continue;
-                }
-            } else {
+            if (!_bt_inline_compare(scankey, datum, &result)) {
                 result = DatumGetInt32(
                     FunctionCall2Coll(&scankey->sk_func, scankey->sk_collation, datum, scankey->sk_argument));
-                if (result == 0)
-                    continue;
             }
+            if (result == 0)
+                continue;
 
             if (!(scankey->sk_flags & SK_BT_DESC))
                 result = -result;
@@ -4415,9 +4415,14 @@ void UHeapResetPreparedUndo()
 
     /* We've filled up half of the undo_buffers. Unlock the Undo buffers we have locked
      * then unpin all the undo buffers in the undo_buffer array.
+     *
+     * The most recently cached buffer holds the zone's insert position, and the
+     * next undo record of a bulk UPDATE/DELETE almost always lands on it, so keep
+     * that one pinned instead of looking it up again in the shared buffer pool.
      */
     if (t_thrd.ustore_cxt.undo_buffer_idx >= ((MAX_UNDO_BUFFERS / 2) - 1)) {
-        for (int i = 0; i < t_thrd.ustore_cxt.undo_buffer_idx; i++) {
+        int last = t_thrd.ustore_cxt.undo_buffer_idx - 1;
+        for (int i = 0; i < last; i++) {
             ResourceOwnerForgetBuffer(t_thrd.utils_cxt.TopTransactionResourceOwner,
                 t_thrd.ustore_cxt.undo_buffers[i].buf);
 
@@ -4428,7 +4433,10 @@ void UHeapResetPreparedUndo()
             t_thrd.ustore_cxt.undo_buffers[i].inUse = false;
         }
 
-        t_thrd.ustore_cxt.undo_buffer_idx = 0;
+        t_thrd.ustore_cxt.undo_buffers[0] = t_thrd.ustore_cxt.undo_buffers[last];
+        t_thrd.ustore_cxt.undo_buffers[0].inUse = false;
+        t_thrd.ustore_cxt.undo_buffers[0].zero = false;
+        t_thrd.ustore_cxt.undo_buffer_idx = 1;
     } else {
         for (int i = 0; i < t_thrd.ustore_cxt.undo_buffer_idx; i++) {
             if (BufferIsValid(t_thrd.ustore_cxt.undo_buffers[i].buf)) {
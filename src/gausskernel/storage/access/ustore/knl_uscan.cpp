@@ -69,6 +69,32 @@ static void UHeapGetPagePrune(UHeapScanDesc scan, Buffer buffer)
     }
 }
 
+/*
+ * Fill tdFrozen[] with the TD slots of a page whose changes every snapshot sees.
+ *
+ * UHeapTupleFetch treats a slot whose xid precedes globalFrozenXid as frozen,
+ * and a frozen tuple is visible unless it was deleted or non-inplace updated,
+ * whatever the snapshot.  Working that out once per slot instead of once per
+ * tuple lets UHeapGetPage skip the TD lookup and snapshot checks for most
+ * tuples of a page that has settled.  Returns false if the page has more slots
+ * than we track.
+ */
+static bool UHeapPageGetFrozenTDSlots(Page dp, bool *tdFrozen)
+{
+    UHeapPageTDData *tdPtr = (UHeapPageTDData *)PageGetTDPointer(dp);
+    int tdCount = UPageGetTDSlotCount(dp);
+    TransactionId frozenXid = pg_atomic_read_u64(&g_instance.undo_cxt.globalFrozenXid);
+
+    if (tdCount > UHEAP_MAX_TD || !TransactionIdIsValid(frozenXid)) {
+        return false;
+    }
+    for (int i = 0; i < tdCount; i++) {
+        TransactionId xid = tdPtr->td_info[i].xactid;
+        tdFrozen[i] = TransactionIdIsValid(xid) && TransactionIdPrecedes(xid, frozenXid);
+    }
+    return true;
+}
+
 /* Check sequential scan descriptor for partial sequential scan fallback conditions, return valid lastVar */
 static inline AttrNumber UHeapCheckScanDesc(const TableScanDesc sscan)
 {
@@ -180,6 +206,10 @@ bool UHeapGetPage(TableScanDesc sscan, BlockNumber page, bool* has_cur_xact_writ
     RowPtr *nextTup;
     OffsetNumber lineoff;
     RowPtr *lpp;
+    int tdCount = UPageGetTDSlotCount(dp);
+    bool tdFrozen[UHEAP_MAX_TD];
+    bool frozenFastPath = snapshot->satisfies == SNAPSHOT_MVCC && !u_sess->exec_cxt.isFlashBack &&
+        UHeapPageGetFrozenTDSlots(dp, tdFrozen);
 
     for (lineoff = FirstOffsetNumber, lpp = UPageGetRowPtr(dp, lineoff); lineoff <= lines; lineoff++, lpp++) {
         if (RowPtrIsNormal(lpp) || RowPtrIsDeleted(lpp)) {
@@ -194,9 +224,25 @@ bool UHeapGetPage(TableScanDesc sscan, BlockNumber page, bool* has_cur_xact_writ
 
             ItemPointerSet(&tid, page, lineoff);
 
-            /* last five params optional, last two params are for UHeapGetTuplePartial */
-            bool valid = UHeapTupleFetch(scan->rs_base.rs_rd, buffer, lineoff, snapshot, &resulttup, NULL, false, NULL,
-                NULL, NULL, lastVar, boolArr, has_cur_xact_write);
+            bool valid;
+            int tdSlot = RowPtrIsNormal(lpp) ? UHeapTupleHeaderGetTDSlot((UHeapDiskTuple)UPageGetRowData(dp, lpp)) :
+                RowPtrGetTDSlot(lpp);
+            if (frozenFastPath &&
+                (tdSlot == UHEAPTUP_SLOT_FROZEN || (tdSlot <= tdCount && tdFrozen[tdSlot - 1]))) {
+                /* All changes to this row are visible; it is gone iff the last one removed it. */
+                uint16 flag = RowPtrIsNormal(lpp) ? ((UHeapDiskTuple)UPageGetRowData(dp, lpp))->flag : 0;
+                valid = RowPtrIsNormal(lpp) &&
+                    ((flag & UHEAP_INPLACE_UPDATED) != 0 || (flag & (UHEAP_UPDATED | UHEAP_DELETED)) == 0);
+                resulttup = NULL;
+                if (valid) {
+                    resulttup = UHeapGetTuplePartial(scan->rs_base.rs_rd, buffer, lineoff, lastVar, boolArr);
+                    UHeapTupleCopyBaseFromPage(resulttup, dp);
+                }
+            } else {
+                /* last five params optional, last two params are for UHeapGetTuplePartial */
+                valid = UHeapTupleFetch(scan->rs_base.rs_rd, buffer, lineoff, snapshot, &resulttup, NULL, false, NULL,
+                    NULL, NULL, lastVar, boolArr, has_cur_xact_write);
+            }
 
             if (resulttup != NULL)
                 Assert(resulttup->tupTableType == UHEAP_TUPLE);
@@ -41,6 +41,7 @@
 #include "utils/dynahash.h"
 #include "utils/postinit.h"
 #include "utils/gs_bitmap.h"
+#include "utils/timestamp.h"
 #include "pgstat.h"
 
 #define TRANS_PARTITION_LINEAR_SPARE_TIME(degree) \
@@ -60,6 +61,11 @@ const int FORCE_RECYCLE_RETRY_TIMES = 5;
 const float FORCE_RECYCLE_PUSH_PERCENT = 0.2;
 const long SLOT_BUFFER_CACHE_SIZE = 16384;
 const int UNDO_RECYCLE_TIMEOUT_DELTA = 50;
+/* Sample undo usage at most once per second for the growth projection. */
+const long UNDO_GROWTH_SAMPLE_INTERVAL_MS = 1000;
+/* Warn, and stop backing off, when the limit is projected within this horizon. */
+const int64 UNDO_EXHAUST_WARN_SECONDS = 300;
+const int UNDO_EXHAUST_WARN_INTERVAL_MS = 60000;
 
 static uint64 g_recycleLoops = 0;
 static int g_forceRecycleSize = 0;
@@ -465,6 +471,58 @@ static bool NeedForceRecycle(void)
     return false;
 }
 
+/*
+ * Track how fast undo space grows net of what the recycler reclaims, and
+ * project when it will hit the force-recycle limit.  Returns true when that
+ * is close enough that the recycler should keep polling instead of backing off.
+ */
+static bool UpdateUndoSpaceProjection(void)
+{
+    static TimestampTz lastSampleTime = 0;
+    static int64 lastUsedSize = 0;
+    static TimestampTz lastWarnTime = 0;
+
+    TimestampTz now = GetCurrentTimestamp();
+    int64 usedSize = (int64)pg_atomic_read_u32(&g_instance.undo_cxt.undoTotalSize) +
+        (int64)g_instance.undo_cxt.undoMetaSize;
+    int64 limitSize = (int64)(u_sess->attr.attr_storage.undo_space_limit_size * FORCE_RECYCLE_PERCENT);
+
+    if (lastSampleTime == 0) {
+        lastSampleTime = now;
+        lastUsedSize = usedSize;
+        return false;
+    }
+    if (!TimestampDifferenceExceeds(lastSampleTime, now, UNDO_GROWTH_SAMPLE_INTERVAL_MS)) {
+        return g_instance.undo_cxt.undoExhaustSeconds >= 0 &&
+            g_instance.undo_cxt.undoExhaustSeconds < UNDO_EXHAUST_WARN_SECONDS;
+    }
+
+    int64 elapsedMs = (now - lastSampleTime) / USECS_PER_MSEC;
+    int64 rate = (usedSize - lastUsedSize) * MSECS_PER_SEC / Max(elapsedMs, 1);
+    int64 avgRate = (g_instance.undo_cxt.undoGrowthRate * 7 + rate) / 8;
+    int64 exhaustSeconds = -1;
+    if (avgRate > 0) {
+        exhaustSeconds = (limitSize > usedSize) ? (limitSize - usedSize) / avgRate : 0;
+    }
+    g_instance.undo_cxt.undoGrowthRate = avgRate;
+    g_instance.undo_cxt.undoExhaustSeconds = exhaustSeconds;
+    lastSampleTime = now;
+    lastUsedSize = usedSize;
+
+    bool underPressure = exhaustSeconds >= 0 && exhaustSeconds < UNDO_EXHAUST_WARN_SECONDS;
+    if (underPressure && TimestampDifferenceExceeds(lastWarnTime, now, UNDO_EXHAUST_WARN_INTERVAL_MS)) {
+        ereport(WARNING, (errmodule(MOD_UNDO),
+            errmsg(UNDOFORMAT("undo space is projected to reach its recycle limit in %ld s: "
+                "used %ld blocks, limit %ld blocks, net growth %ld blocks/s, globalRecycleXid %lu."),
+                exhaustSeconds, usedSize, limitSize, avgRate,
+                pg_atomic_read_u64(&g_instance.undo_cxt.globalRecycleXid)),
+            errhint("Long-running transactions hold back undo recycling; "
+                "consider increasing undo_space_limit_size.")));
+        lastWarnTime = now;
+    }
+    return underPressure;
+}
+
 static TransactionId GetForceRecycleXid(TransactionId oldestXmin, int retry)
 {
     TransactionId forceRecycleXid = InvalidTransactionId;
@@ -751,8 +809,13 @@ void UndoRecycleMain()
                     pg_atomic_write_u64(&g_instance.undo_cxt.globalRecycleXid, oldestXidHavingUndo);
                 }
             }
+            bool underPressure = UpdateUndoSpaceProjection();
             if (!recycled) {
-                nonRecycled += UNDO_RECYCLE_TIMEOUT_DELTA;
+                if (underPressure) {
+                    nonRecycled = UNDO_RECYCLE_TIMEOUT_DELTA;
+                } else {
+                    nonRecycled += UNDO_RECYCLE_TIMEOUT_DELTA;
+                }
                 WaitRecycleThread(nonRecycled);
             } else {
                 nonRecycled = 0;
@@ -15,6 +15,9 @@
  */
 #include "postgres.h"
 #include "knl/knl_variable.h"
+#ifdef __USE_NUMA
+#include <numa.h>
+#endif
 #include "gs_bbox.h"
 #include "storage/buf/bufmgr.h"
 #include "storage/buf/buf_internals.h"
@@ -59,6 +62,38 @@ const int PAGE_QUEUE_SLOT_MULTI_NBUFFERS = 5;
  *		shared refcount isn't increased if a individual backend pins a buffer
  *		multiple times. Check the PrivateRefCount infrastructure in bufmgr.c.
  */
+#ifdef __USE_NUMA
+static void BindRangeToNumaNode(char *addr, Size len, int node, Size page_size)
+{
+    char *begin = (char *)TYPEALIGN(page_size, addr);
+    char *end = (char *)TYPEALIGN_DOWN(page_size, addr + len);
+
+    if (end > begin) {
+        numa_tonode_memory(begin, end - begin, node);
+    }
+}
+
+/*
+ * Place every NUMA partition of the normal shared buffers, both the blocks and
+ * the descriptors, on its own node. Must run before the memory is touched.
+ */
+static void BindBufferPoolToNumaNodes(void)
+{
+    Size page_size = (Size)sysconf(_SC_PAGESIZE);
+
+    for (int node = 0; node < BUFFER_NUMA_NODE_NUM; node++) {
+        int start = BufferNumaPartitionStart(node);
+        int size = BufferNumaPartitionSize(node);
+
+        BindRangeToNumaNode(t_thrd.storage_cxt.BufferBlocks + (Size)start * BLCKSZ, (Size)size * BLCKSZ,
+                            node, page_size);
+        BindRangeToNumaNode((char *)&t_thrd.storage_cxt.BufferDescriptors[start],
+                            (Size)size * sizeof(BufferDescPadded), node, page_size);
+    }
+    ereport(LOG, (errmsg("shared buffers are partitioned over %d NUMA nodes", BUFFER_NUMA_NODE_NUM)));
+}
+#endif
+
 /*
  * Initialize shared buffer pool
  *
@@ -144,6 +179,12 @@ void InitBufferPool(void)
     } else {
         int i;
 
+#ifdef __USE_NUMA
+        if (ENABLE_BUFFER_NUMA_PARTITION) {
+            BindBufferPoolToNumaNodes();
+        }
+#endif
+
         /*
          * Initialize all the buffer headers.
          */
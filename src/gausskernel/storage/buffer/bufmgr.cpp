@@ -373,6 +373,33 @@ static volatile BufferDesc* PageListBufferAlloc(SMgrRelation smgr, char relpersi
 #endif
 static bool ConditionalStartBufferIO(BufferDesc* buf, bool forInput);
 
+#if defined(USE_PREFETCH) && defined(USE_POSIX_FADVISE)
+/*
+ * BufferIsResident -- check whether a block is in the shared buffer pool
+ */
+static bool BufferIsResident(SMgrRelation smgr, ForkNumber forkNum, BlockNumber blockNum)
+{
+    BufferTag new_tag;          /* identity of requested block */
+    uint32 new_hash;            /* hash value for newTag */
+    LWLock *new_partition_lock; /* buffer partition lock for it */
+    int buf_id;
+
+    /* create a tag so we can lookup the buffer */
+    INIT_BUFFERTAG(new_tag, smgr->smgr_rnode.node, forkNum, blockNum);
+
+    /* determine its hash code and partition lock ID */
+    new_hash = BufTableHashCode(&new_tag);
+    new_partition_lock = BufMappingPartitionLock(new_hash);
+
+    /* see if the block is in the buffer pool already */
+    (void)LWLockAcquire(new_partition_lock, LW_SHARED);
+    buf_id = BufTableLookup(&new_tag, new_hash);
+    LWLockRelease(new_partition_lock);
+
+    return buf_id >= 0;
+}
+#endif /* USE_PREFETCH && USE_POSIX_FADVISE */
+
 /*
  * PrefetchBuffer -- initiate asynchronous read of a block of a relation
  *
@@ -398,25 +425,8 @@ void PrefetchBuffer(Relation reln, ForkNumber forkNum, BlockNumber blockNum)
         }
     }
 
-    BufferTag new_tag;          /* identity of requested block */
-    uint32 new_hash;            /* hash value for newTag */
-    LWLock *new_partition_lock; /* buffer partition lock for it */
-    int buf_id;
-
-    /* create a tag so we can lookup the buffer */
-    INIT_BUFFERTAG(new_tag, reln->rd_smgr->smgr_rnode.node, forkNum, blockNum);
-
-    /* determine its hash code and partition lock ID */
-    new_hash = BufTableHashCode(&new_tag);
-    new_partition_lock = BufMappingPartitionLock(new_hash);
-
-    /* see if the block is in the buffer pool already */
-    (void)LWLockAcquire(new_partition_lock, LW_SHARED);
-    buf_id = BufTableLookup(&new_tag, new_hash);
-    LWLockRelease(new_partition_lock);
-
     /* If not in buffers, initiate prefetch */
-    if (buf_id < 0) {
+    if (!BufferIsResident(reln->rd_smgr, forkNum, blockNum)) {
         smgrprefetch(reln->rd_smgr, forkNum, blockNum);
     }
 
@@ -434,6 +444,74 @@ void PrefetchBuffer(Relation reln, ForkNumber forkNum, BlockNumber blockNum)
 #endif /* USE_PREFETCH && USE_POSIX_FADVISE */
 }
 
+/*
+ * PrefetchBufferRange -- initiate asynchronous read of nblocks consecutive
+ * blocks of a relation, starting at startBlock.
+ *
+ * Blocks already in the buffer pool are skipped, and every run of missing
+ * blocks is handed to the storage manager as a single request, so a scan that
+ * knows its upcoming blocks pays one system call per run instead of one per block.
+ */
+void PrefetchBufferRange(Relation reln, ForkNumber forkNum, BlockNumber startBlock, BlockNumber nblocks)
+{
+#if defined(USE_PREFETCH) && defined(USE_POSIX_FADVISE)
+    Assert(RelationIsValid(reln));
+    Assert(BlockNumberIsValid(startBlock));
+
+    if (RelationUsesLocalBuffers(reln)) {
+        for (BlockNumber i = 0; i < nblocks; i++) {
+            PrefetchBuffer(reln, forkNum, startBlock + i);
+        }
+        return;
+    }
+
+    /* Open it at the smgr level if not already done */
+    RelationOpenSmgr(reln);
+
+    BlockNumber run_start = startBlock;
+    BlockNumber run_len = 0;
+    for (BlockNumber blk = startBlock; blk < startBlock + nblocks; blk++) {
+        if (!BufferIsResident(reln->rd_smgr, forkNum, blk)) {
+            if (run_len == 0) {
+                run_start = blk;
+            }
+            run_len++;
+            continue;
+        }
+        if (run_len > 0) {
+            smgrprefetchrange(reln->rd_smgr, forkNum, run_start, run_len);
+            run_len = 0;
+        }
+    }
+    if (run_len > 0) {
+        smgrprefetchrange(reln->rd_smgr, forkNum, run_start, run_len);
+    }
+#endif /* USE_PREFETCH && USE_POSIX_FADVISE */
+}
+
+/*
+ * PrefetchSharedBuffer -- initiate asynchronous read of a shared block
+ * identified only at the smgr level.
+ *
+ * Used by recovery, which knows the blocks referenced by upcoming WAL records
+ * but has no relcache entry for them.  Segment-page relations are skipped: their
+ * logical block numbers do not map onto file offsets without a segment lookup.
+ */
+void PrefetchSharedBuffer(SMgrRelation smgr, ForkNumber forkNum, BlockNumber blockNum)
+{
+#if defined(USE_PREFETCH) && defined(USE_POSIX_FADVISE)
+    Assert(BlockNumberIsValid(blockNum));
+
+    if (IsSegmentFileNode(smgr->smgr_rnode.node)) {
+        return;
+    }
+
+    if (!BufferIsResident(smgr, forkNum, blockNum)) {
+        smgrprefetch(smgr, forkNum, blockNum);
+    }
+#endif /* USE_PREFETCH && USE_POSIX_FADVISE */
+}
+
 /*
  * @Description: ConditionalStartBufferIO: conditionally begin and Asynchronous Prefetch or
  * WriteBack I/O on this buffer.
@@ -736,9 +814,9 @@ static volatile BufferDesc *PageListBufferAlloc(SMgrRelation smgr, char relpersi
     buf_state &= ~(BM_VALID | BM_DIRTY | BM_JUST_DIRTIED | BM_CHECKPOINT_NEEDED | BM_IO_ERROR | BM_PERMANENT);
     if ((relpersistence == RELPERSISTENCE_PERMANENT) ||
         ((relpersistence == RELPERSISTENCE_TEMP) && STMT_RETRY_ENABLED)) {
-        buf_state |= BM_TAG_VALID | BM_PERMANENT | BUF_USAGECOUNT_ONE;
+        buf_state |= BM_TAG_VALID | BM_PERMANENT | BUFFER_INITIAL_USAGECOUNT;
     } else {
-        buf_state |= BM_TAG_VALID | BUF_USAGECOUNT_ONE;
+        buf_state |= BM_TAG_VALID | BUFFER_INITIAL_USAGECOUNT;
     }
     UnlockBufHdr(buf, buf_state);
 
@@ -2726,7 +2804,8 @@ static BufferDesc *BufferAlloc(SMgrRelation smgr, char relpersistence, ForkNumbe
      * Clearing BM_VALID here is necessary, clearing the dirtybits is just
      * paranoia.  We also reset the usage_count since any recency of use of
      * the old content is no longer relevant.  (The usage_count starts out at
-     * 1 so that the buffer can survive one clock-sweep pass.)
+     * 1 so that the buffer can survive one clock-sweep pass, or at 0 under the
+     * 2Q replacement policy, where the page must be re-referenced to be kept.)
      *
      * Make sure BM_PERMANENT is set for buffers that must be written at every
      * checkpoint.  Unlogged buffers only need to be written at shutdown
@@ -2738,9 +2817,9 @@ static BufferDesc *BufferAlloc(SMgrRelation smgr, char relpersistence, ForkNumbe
                    BUF_USAGECOUNT_MASK);
     if (relpersistence == RELPERSISTENCE_PERMANENT || fork_num == INIT_FORKNUM ||
         ((relpersistence == RELPERSISTENCE_TEMP) && STMT_RETRY_ENABLED)) {
-        buf_state |= BM_TAG_VALID | BM_PERMANENT | BUF_USAGECOUNT_ONE;
+        buf_state |= BM_TAG_VALID | BM_PERMANENT | BUFFER_INITIAL_USAGECOUNT;
     } else {
-        buf_state |= BM_TAG_VALID | BUF_USAGECOUNT_ONE;
+        buf_state |= BM_TAG_VALID | BUFFER_INITIAL_USAGECOUNT;
     }
 
     UnlockBufHdr(buf, buf_state);
@@ -32,6 +32,14 @@
 
 #define INT_ACCESS_ONCE(var) ((int)(*((volatile int *)&(var))))
 
+/*
+ * Per NUMA node clock hand, padded to avoid false sharing between nodes.
+ */
+typedef struct BufferStrategyNumaHand {
+    pg_atomic_uint32 nextVictimBuffer;
+    char pad[PG_CACHE_LINE_SIZE - sizeof(pg_atomic_uint32)];
+} BufferStrategyNumaHand;
+
 /*
  * The shared freelist control information.
  */
@@ -58,6 +66,12 @@ typedef struct BufferStrategyControl {
      * StrategyNotifyBgWriter.
      */
     int bgwprocno;
+
+    /*
+     * Clock hands of the NUMA buffer partitions, only used when
+     * ENABLE_BUFFER_NUMA_PARTITION. Each hand sweeps its own partition.
+     */
+    BufferStrategyNumaHand numaHands[MAX_BUFFER_NUMA_NODES];
 } BufferStrategyControl;
 
 typedef struct {
@@ -80,6 +94,7 @@ void PageListBackWrite(uint32* bufList, int32 n,
     int32* bufs_written = NULL,       /* opt written count returned */
     int32* bufs_reusable = NULL);     /* opt reusable count returned */
 static BufferDesc* get_buf_from_candidate_list(BufferAccessStrategy strategy, uint32* buf_state);
+static BufferDesc* get_buf_from_numa_partition(BufferAccessStrategy strategy, uint32* buf_state, int node);
 
 static void perform_delay(StrategyDelayStatus *status)
 {
@@ -159,6 +174,86 @@ static inline uint32 ClockSweepTick(int max_nbuffer_can_use)
     return victim;
 }
 
+/*
+ * StrategySpareReferencedBuffer - 2Q ageing step of the clock sweep.
+ *
+ * Under the 2Q replacement policy an unpinned buffer that has been referenced
+ * since it was loaded (usage count > 0) is not evicted; its usage count is
+ * decremented instead so that it drops back to probation unless touched again.
+ * Returns true, with the buffer header unlocked, if the buffer was spared.
+ */
+static inline bool StrategySpareReferencedBuffer(BufferDesc *buf, uint32 buf_state)
+{
+    if (!ENABLE_BUFFER_POLICY_2Q || BUF_STATE_GET_REFCOUNT(buf_state) != 0 ||
+        BUF_STATE_GET_USAGECOUNT(buf_state) == 0) {
+        return false;
+    }
+    buf_state -= BUF_USAGECOUNT_ONE;
+    UnlockBufHdr(buf, buf_state);
+    (void)pg_atomic_fetch_add_u64(&g_instance.ckpt_cxt_ctl->get_buf_num_usage_spared, 1);
+    return true;
+}
+
+/*
+ * StrategyCurrentNumaNode - NUMA node whose buffer partition the caller should use first.
+ */
+static inline int StrategyCurrentNumaNode(void)
+{
+    if (t_thrd.proc == NULL) {
+        return 0;
+    }
+    return t_thrd.proc->nodeno % BUFFER_NUMA_NODE_NUM;
+}
+
+/*
+ * NumaClockSweepTick - Move the clock hand of one NUMA buffer partition ahead
+ * and return the id of the buffer now under it.
+ *
+ * Unlike ClockSweepTick we don't track complete passes here: StrategySyncStart
+ * only looks at the global hand, which keeps sweeping the whole pool.
+ */
+static inline uint32 NumaClockSweepTick(int node)
+{
+    uint32 start = (uint32)BufferNumaPartitionStart(node);
+    uint32 size = (uint32)BufferNumaPartitionSize(node);
+    uint32 victim = pg_atomic_fetch_add_u32(&t_thrd.storage_cxt.StrategyControl->numaHands[node].nextVictimBuffer, 1);
+
+    return start + victim % size;
+}
+
+/*
+ * get_buf_from_numa_partition - run one clock sweep pass over the buffer
+ * partition of the given NUMA node. Returns NULL if no buffer of the partition
+ * is usable, the caller then falls back to sweeping the whole pool.
+ */
+static BufferDesc* get_buf_from_numa_partition(BufferAccessStrategy strategy, uint32* buf_state, int node)
+{
+    BufferDesc *buf = NULL;
+    uint32 local_buf_state = 0;
+    int try_counter = BufferNumaPartitionSize(node);
+
+    while (try_counter-- > 0) {
+        buf = GetBufferDescriptor(NumaClockSweepTick(node));
+        if (!retryLockBufHdr(buf, &local_buf_state)) {
+            continue;
+        }
+        if (StrategySpareReferencedBuffer(buf, local_buf_state)) {
+            continue;
+        }
+        if (BUF_STATE_GET_REFCOUNT(local_buf_state) == 0 && !(local_buf_state & BM_IS_META) &&
+            (backend_can_flush_dirty_page() || !(local_buf_state & BM_DIRTY))) {
+            if (strategy != NULL) {
+                AddBufferToRing(strategy, buf);
+            }
+            *buf_state = local_buf_state;
+            (void)pg_atomic_fetch_add_u64(&g_instance.ckpt_cxt_ctl->get_buf_num_clock_sweep, 1);
+            return buf;
+        }
+        UnlockBufHdr(buf, local_buf_state);
+    }
+    return NULL;
+}
+
 /*
  * StrategyGetBuffer
  *
@@ -258,6 +353,17 @@ BufferDesc* StrategyGetBuffer(BufferAccessStrategy strategy, uint32* buf_state)
         }
     }
 
+    /*
+     * With NUMA partitioned buffers, first sweep the partition local to our
+     * node; the global sweep below then steals buffers from remote nodes.
+     */
+    if (ENABLE_BUFFER_NUMA_PARTITION && !am_standby) {
+        buf = get_buf_from_numa_partition(strategy, buf_state, StrategyCurrentNumaNode());
+        if (buf != NULL) {
+            return buf;
+        }
+    }
+
 retry:
     /* Nothing on the freelist, so run the "clock sweep" algorithm */
     if (am_standby)
@@ -282,6 +388,11 @@ retry:
         }
 
         retry_lock_status.retry_times = 0;
+        if (StrategySpareReferencedBuffer(buf, local_buf_state)) {
+            /* we changed the buffer state, so the pool isn't exhausted yet */
+            try_counter = max_buffer_can_use;
+            continue;
+        }
         if (BUF_STATE_GET_REFCOUNT(local_buf_state) == 0 && !(local_buf_state & BM_IS_META) &&
             (backend_can_flush_dirty_page() || !(local_buf_state & BM_DIRTY))) {
             /* Found a usable buffer */
@@ -448,6 +559,10 @@ void StrategyInitialize(bool init)
 
         /* No pending notification */
         t_thrd.storage_cxt.StrategyControl->bgwprocno = -1;
+
+        for (int i = 0; i < MAX_BUFFER_NUMA_NODES; i++) {
+            pg_atomic_init_u32(&t_thrd.storage_cxt.StrategyControl->numaHands[i].nextVictimBuffer, 0);
+        }
     } else {
         Assert(!init);
     }
@@ -727,38 +842,51 @@ static BufferDesc* get_buf_from_candidate_list(BufferAccessStrategy strategy, ui
 
     list_id = beentry->st_tid > 0 ? (beentry->st_tid % list_num) : (beentry->st_sessionid % list_num);
 
-    for (int i = 0; i < list_num; i++) {
-        /* the pagewriter sub thread store normal buffer pool, sub thread starts from 1 */
-        int thread_id = (list_id + i) % list_num + 1;
-        Assert(thread_id > 0 && thread_id <= list_num);
-        while (candidate_buf_pop(&g_instance.ckpt_cxt_ctl->pgwr_procs.writer_proc[thread_id].normal_list, &buf_id)) {
-            Assert(buf_id < SegmentBufferStartID);
-            buf = GetBufferDescriptor(buf_id);
-            local_buf_state = LockBufHdr(buf);
-
-            if (g_instance.ckpt_cxt_ctl->candidate_free_map[buf_id]) {
-                g_instance.ckpt_cxt_ctl->candidate_free_map[buf_id] = false;
-                enable_available = BUF_STATE_GET_REFCOUNT(local_buf_state) == 0 && !(local_buf_state & BM_IS_META);
-                need_push_dirst_list = need_scan_dirty && dirty_list_num < CANDIDATE_DIRTY_LIST_LEN &&
-                        free_space_enough(buf_id);
-                if (enable_available) {
-                    if (NEED_CONSIDER_USECOUNT && BUF_STATE_GET_USAGECOUNT(local_buf_state) != 0) {
-                        local_buf_state -= BUF_USAGECOUNT_ONE;
-                    } else if (!(local_buf_state & BM_DIRTY)) {
-                        if (strategy != NULL) {
-                            AddBufferToRing(strategy, buf);
-                        }
-                        *buf_state = local_buf_state;
-                        if (candidate_dirty_list != NULL) {
-                            pfree(candidate_dirty_list);
+    /*
+     * With NUMA partitioned buffers, scan the candidate lists whose buffers
+     * live on our node first and only then steal from the remote ones.
+     */
+    int scan_passes = ENABLE_BUFFER_NUMA_PARTITION ? 2 : 1;
+    int local_node = StrategyCurrentNumaNode();
+
+    for (int pass = 0; pass < scan_passes; pass++) {
+        for (int i = 0; i < list_num; i++) {
+            /* the pagewriter sub thread store normal buffer pool, sub thread starts from 1 */
+            int thread_id = (list_id + i) % list_num + 1;
+            Assert(thread_id > 0 && thread_id <= list_num);
+            CandidateList *list = &g_instance.ckpt_cxt_ctl->pgwr_procs.writer_proc[thread_id].normal_list;
+            if (scan_passes > 1 && (BufferIdGetNumaNode(list->buf_id_start) == local_node) != (pass == 0)) {
+                continue;
+            }
+            while (candidate_buf_pop(list, &buf_id)) {
+                Assert(buf_id < SegmentBufferStartID);
+                buf = GetBufferDescriptor(buf_id);
+                local_buf_state = LockBufHdr(buf);
+
+                if (g_instance.ckpt_cxt_ctl->candidate_free_map[buf_id]) {
+                    g_instance.ckpt_cxt_ctl->candidate_free_map[buf_id] = false;
+                    enable_available = BUF_STATE_GET_REFCOUNT(local_buf_state) == 0 && !(local_buf_state & BM_IS_META);
+                    need_push_dirst_list = need_scan_dirty && dirty_list_num < CANDIDATE_DIRTY_LIST_LEN &&
+                            free_space_enough(buf_id);
+                    if (enable_available) {
+                        if (CANDIDATE_CONSIDER_USECOUNT && BUF_STATE_GET_USAGECOUNT(local_buf_state) != 0) {
+                            local_buf_state -= BUF_USAGECOUNT_ONE;
+                        } else if (!(local_buf_state & BM_DIRTY)) {
+                            if (strategy != NULL) {
+                                AddBufferToRing(strategy, buf);
+                            }
+                            *buf_state = local_buf_state;
+                            if (candidate_dirty_list != NULL) {
+                                pfree(candidate_dirty_list);
+                            }
+                            return buf;
+                        } else if (need_push_dirst_list) {
+                            candidate_dirty_list[dirty_list_num++] = buf_id;
                         }
-                        return buf;
-                    } else if (need_push_dirst_list) {
-                        candidate_dirty_list[dirty_list_num++] = buf_id;
                     }
                 }
+                UnlockBufHdr(buf, local_buf_state);
             }
-            UnlockBufHdr(buf, local_buf_state);
         }
     }
 
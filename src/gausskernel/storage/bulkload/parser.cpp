@@ -30,6 +30,7 @@
 #include "securec.h"
 #include <string>
 #include "storage/gds_utils.h"
+#include "utils/bytescan.h"
 
 #ifdef GDS_SERVER
 #include "storage/parser.h"
@@ -543,6 +544,10 @@ inline static ParserResult CSVReadLine(CSVParser* self, LineBuffer& buf)
     int begin_index = self->cur;
     int raw_buf_ptr = self->cur_need_flush;
 
+    ByteScanSet plainSet;
+    char stopChars[4] = {'\n', '\r', quotec, escapec};
+    ByteScanSetInit(&plainSet, stopChars, (escapec != '\0') ? 4 : 3, false);
+
     /*
      * Flush already parsed lines to LineBuffer
      */
@@ -611,6 +616,20 @@ inline static ParserResult CSVReadLine(CSVParser* self, LineBuffer& buf)
             continue;
         }
 
+        /*
+         * Skip the run of bytes that can neither quote, escape nor end the
+         * line.  Not right after a \r though, the byte following it decides
+         * whether the line ends there.
+         */
+        if (!*in_cr) {
+            int plainLen = ByteScanPlain(&plainSet, raw_buffer + raw_buf_ptr, self->used_len - raw_buf_ptr);
+            if (plainLen > 0) {
+                raw_buf_ptr += plainLen;
+                *last_was_esc = false;
+                continue;
+            }
+        }
+
         c = raw_buffer[raw_buf_ptr++];
 
         // is escape char
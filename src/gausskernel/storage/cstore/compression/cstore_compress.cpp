@@ -752,12 +752,55 @@ int StringCoder::CompressInner(CompressionArg1& in, CompressionArg2& out)
 template int StringCoder::CompressInner<true>(CompressionArg1&, CompressionArg2&);
 template int StringCoder::CompressInner<false>(CompressionArg1&, CompressionArg2&);
 
+/*
+ * zlib must beat lz4 by this percent on the sampling CU before a middle
+ * compression column switches to it, since zlib decompresses slower.
+ */
+#define ZLIB_ADOPT_GAIN_PERCENT 20
+
 // compress directly using zlib/lz4 methods
 int StringCoder::CompressWithoutDict(_in_ char* inBuf, _in_ int inBufSize, _in_ int compressing_modes,
                                      _out_ char* outBuf, _in_ int outBufSize, _out_ int& mode)
 {
     int8 compression = heaprel_get_compression_from_modes(compressing_modes);
     int8 compresslevel = heaprel_get_compresslevel_from_modes(compressing_modes);
+
+    if (compression != COMPRESS_MIDDLE || (!m_adopt_zlib && !m_sampling)) {
+        return CompressWithoutDictInner(inBuf, inBufSize, compression, compresslevel, outBuf, outBufSize, mode);
+    }
+
+    /* the sampling CU showed zlib pays off for this column */
+    if (m_adopt_zlib) {
+        return CompressWithoutDictInner(inBuf, inBufSize, COMPRESS_HIGH, 0, outBuf, outBufSize, mode);
+    }
+
+    /* sampling CU: try both codecs, and keep zlib only if it is clearly smaller */
+    int lz4Mode = 0;
+    int lz4Size = CompressWithoutDictInner(inBuf, inBufSize, compression, compresslevel, outBuf, outBufSize, lz4Mode);
+    if (lz4Mode == 0) {
+        lz4Size = inBufSize;
+    }
+
+    int zlibMode = 0;
+    char* zlibBuf = (char*)palloc(outBufSize);
+    int zlibSize = CompressWithoutDictInner(inBuf, inBufSize, COMPRESS_HIGH, 0, zlibBuf, outBufSize, zlibMode);
+    if (zlibMode != 0 && (int64)zlibSize * 100 < (int64)lz4Size * (100 - ZLIB_ADOPT_GAIN_PERCENT)) {
+        errno_t rc = memcpy_s(outBuf, outBufSize, zlibBuf, zlibSize);
+        securec_check(rc, "", "");
+        pfree(zlibBuf);
+        mode |= zlibMode;
+        return zlibSize;
+    }
+    pfree(zlibBuf);
+
+    mode |= lz4Mode;
+    return (lz4Mode != 0) ? lz4Size : 0;
+}
+
+int StringCoder::CompressWithoutDictInner(_in_ char* inBuf, _in_ int inBufSize, _in_ int8 compression,
+                                          _in_ int8 compresslevel, _out_ char* outBuf, _in_ int outBufSize,
+                                          _out_ int& mode)
+{
     int boundSize = 0;
     int outSize = 0;
     int tempMode = 0;
@@ -2573,6 +2616,7 @@ void compression_options::reset(void)
     m_adopt_numeric2int_int64_rle = true;
     m_adopt_dict = true;
     m_adopt_rle = true;
+    m_adopt_zlib = false;
 }
 
 /*
@@ -2596,6 +2640,7 @@ void compression_options::set_common_flags(uint32 modes)
 {
     m_adopt_dict = ((modes & CU_DicEncode) != 0);
     m_adopt_rle = ((modes & CU_RLECompressed) != 0);
+    m_adopt_zlib = ((modes & CU_ZlibCompressed) != 0);
 }
 
 #ifdef ENABLE_UT
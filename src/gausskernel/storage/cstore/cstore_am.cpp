@@ -115,6 +115,11 @@ CStore::CStore()
       m_load_finish(false),
       m_scanPosInCU(NULL),
       m_RCFuncs(NULL),
+      m_RFNum(0),
+      m_RFColSeq(NULL),
+      m_RFTypes(NULL),
+      m_RFIndex(NULL),
+      m_RFArray(NULL),
       m_fillVectorByTids(NULL),
       m_fillVectorLateRead(NULL),
       m_colFillFunArrary(NULL),
@@ -326,6 +331,67 @@ void CStore::InitRoughCheckEnv(CStoreScanState* state)
             m_RCFuncs[i] = GetRoughCheckFunc(attrs[colIdx]->atttypid, scanKey[i].cs_strategy, scanKey[i].cs_collation);
         }
     }
+
+    // Initialize runtime filters. Only integer columns are supported because
+    // their CU min/max are stored as raw values and compare cheaply.
+    Plan* plan = state->ps.plan;
+    int nfilters = list_length(plan->var_list);
+    if (nfilters > 0 && state->ps.state->es_bloom_filter.bfarray != NULL &&
+        list_length(plan->filterIndexList) == nfilters) {
+        List* accessedVarNos = state->ps.ps_ProjInfo->pi_acessedVarNumbers;
+
+        m_RFColSeq = (int*)palloc(sizeof(int) * nfilters);
+        m_RFTypes = (Oid*)palloc(sizeof(Oid) * nfilters);
+        m_RFIndex = (int*)palloc(sizeof(int) * nfilters);
+        m_RFArray = state->ps.state->es_bloom_filter.bfarray;
+        m_RFNum = 0;
+
+        for (int i = 0; i < nfilters; i++) {
+            Var* var = (Var*)list_nth(plan->var_list, i);
+            if (!IsA(var, Var) || var->varattno <= 0 ||
+                (var->vartype != INT2OID && var->vartype != INT4OID && var->vartype != INT8OID))
+                continue;
+
+            int seq = 0;
+            ListCell* lc = NULL;
+            foreach (lc, accessedVarNos) {
+                if (lfirst_int(lc) == (int)var->varattno)
+                    break;
+                seq++;
+            }
+            if (lc == NULL || seq >= m_colNum)
+                continue;
+
+            m_RFColSeq[m_RFNum] = seq;
+            m_RFTypes[m_RFNum] = var->vartype;
+            m_RFIndex[m_RFNum] = list_nth_int(plan->filterIndexList, i);
+            m_RFNum++;
+        }
+    }
+}
+
+static inline int64 RuntimeFilterMinMaxValue(Oid typeOid, const char* minmax)
+{
+    switch (typeOid) {
+        case INT2OID:
+            return *(int16*)minmax;
+        case INT4OID:
+            return *(int32*)minmax;
+        default:
+            return *(int64*)minmax;
+    }
+}
+
+static inline int64 RuntimeFilterDatumValue(Oid typeOid, Datum value)
+{
+    switch (typeOid) {
+        case INT2OID:
+            return DatumGetInt16(value);
+        case INT4OID:
+            return DatumGetInt32(value);
+        default:
+            return DatumGetInt64(value);
+    }
 }
 
 void CStore::InitScan(CStoreScanState* state, Snapshot snapshot)
@@ -404,6 +470,10 @@ CStore::~CStore()
     m_CUDescInfo = NULL;
     m_perScanMemCnxt = NULL;
     m_RCFuncs = NULL;
+    m_RFColSeq = NULL;
+    m_RFTypes = NULL;
+    m_RFIndex = NULL;
+    m_RFArray = NULL;
     m_CUDescIdx = NULL;
     m_colFillFunArrary = NULL;
     m_cuStorage = NULL;
@@ -1176,6 +1246,16 @@ bool CStore::RoughCheck(CStoreScanKey scanKey, int nkeys, int cuDescIdx)
         int seq = scanKey[j].cs_attno;
         CUDesc* cudesc = &(m_CUDescInfo[seq]->cuDescArray[cuDescIdx]);
         bool isNullKey = scanKey[j].cs_flags & SK_ISNULL;
+        /*
+         * A strict operator never returns true for a NULL input, so a CU whose
+         * values are all NULL cannot satisfy a non-null key on that column.
+         * Such CUs are dropped here from the CU descriptor alone, before any
+         * of the column data is loaded or decompressed.
+         */
+        if (cudesc->IsNullCU() && !isNullKey && scanKey[j].cs_func.fn_strict) {
+            hitCU = false;
+            break;
+        }
         if ((cudesc->IsNullCU() && !isNullKey) || cudesc->IsNoMinMaxCU())
             continue;
         if (isNullKey)
@@ -1185,9 +1265,52 @@ bool CStore::RoughCheck(CStoreScanKey scanKey, int nkeys, int cuDescIdx)
         if (!hitCU)
             break;
     }
+
+    if (hitCU && m_RFNum > 0)
+        hitCU = RuntimeFilterCheck(cuDescIdx);
+
     return hitCU;
 }
 
+/*
+ * Check one CU against the runtime filters built by hash joins above this scan.
+ * The hash join only pushes a filter once its build side has been loaded, so a
+ * missing filter just means the CU cannot be judged yet. Hash join keys never
+ * match NULL, so an all-NULL CU is skipped, and a CU is also skipped when its
+ * min/max range is outside the build side's range. For a CU holding a single
+ * value, the bloom filter itself is probed.
+ */
+bool CStore::RuntimeFilterCheck(int cuDescIdx)
+{
+    for (int i = 0; i < m_RFNum; i++) {
+        filter::BloomFilter* bf = m_RFArray[m_RFIndex[i]];
+        if (bf == NULL || !bf->hasMinMax())
+            continue;
+
+        /* The build side may be another integer type, e.g. int4 = int8 */
+        Oid bfType = bf->getDataType();
+        if (bfType != INT2OID && bfType != INT4OID && bfType != INT8OID)
+            continue;
+
+        CUDesc* cudesc = &(m_CUDescInfo[m_RFColSeq[i]]->cuDescArray[cuDescIdx]);
+        if (cudesc->IsNullCU())
+            return false;
+        if (cudesc->IsNoMinMaxCU())
+            continue;
+
+        Oid typeOid = m_RFTypes[i];
+        int64 cuMin = RuntimeFilterMinMaxValue(typeOid, cudesc->cu_min);
+        int64 cuMax = RuntimeFilterMinMaxValue(typeOid, cudesc->cu_max);
+        if (cuMax < RuntimeFilterDatumValue(bfType, bf->getMin()) ||
+            cuMin > RuntimeFilterDatumValue(bfType, bf->getMax()))
+            return false;
+
+        if (cuMin == cuMax && !bf->includeLong(cuMin))
+            return false;
+    }
+    return true;
+}
+
 void CStore::RoughCheckIfNeed(_in_ CStoreScanState* state)
 {
     int nkeys = state->csss_NumScanKeys;
@@ -1202,7 +1325,7 @@ void CStore::RoughCheckIfNeed(_in_ CStoreScanState* state)
         return;
     }
 
-    if (likely(nkeys == 0 || scanKey == NULL || m_colNum == 0)) {
+    if (likely(((nkeys == 0 || scanKey == NULL) && m_RFNum == 0) || m_colNum == 0)) {
         /* when no where condition, we also need set m_lastNumCUDescIdx and m_NumCUDescIdx for prefetch once */
         ADIO_RUN()
         {
@@ -1248,7 +1371,7 @@ void CStore::RoughCheckIfNeed(_in_ CStoreScanState* state)
             RCInfo* rcPtr = &(planstate->instrument->rcInfo);
 
             if (!hitCU) {
-                int seq = scanKey[0].cs_attno;
+                int seq = (nkeys > 0) ? scanKey[0].cs_attno : m_RFColSeq[0];
                 CUDesc *cudesc = &(m_CUDescInfo[seq]->cuDescArray[i]);
                 planstate->instrument->nfiltered1 += cudesc->row_count;
 
@@ -2692,55 +2815,42 @@ template <int attlen>
 void CStore::FillVectorLateRead(
     _in_ int colIdx, _in_ ScalarVector* tids, _in_ CUDesc* cuDescPtr, _out_ ScalarVector* vec)
 {
-    ScalarValue* tidVals = tids->m_vals;
-    ItemPointer tidPtr = NULL;
-
-    uint32 tmpCuId = InValidCUID;
-    uint32 tmpOffset = 0;
-
-    int pos = 0;
+    /*
+     * tids only holds rows that FillTidForLateRead found alive and the quals
+     * kept, so there is no need to consult the delete mask again here (the
+     * normal CU path below never did).
+     */
+    int nrows = tids->m_rows;
 
     // Case 1: It is full of NULL value
     if (cuDescPtr->IsNullCU()) {
-        for (int rowCnt = 0; rowCnt < tids->m_rows; ++rowCnt) {
-            tidPtr = (ItemPointer)(tidVals + rowCnt);
-            tmpCuId = ItemPointerGetBlockNumber(tidPtr);
-            tmpOffset = ItemPointerGetOffsetNumber(tidPtr) - 1;
-            if (this->IsDeadRow(cuDescPtr->cu_id, tmpOffset)) {
-                continue;
-            }
-            vec->SetNull(pos);
-            pos++;
+        for (int rowCnt = 0; rowCnt < nrows; ++rowCnt) {
+            vec->SetNull(rowCnt);
         }
 
-        vec->m_rows = pos;
+        vec->m_rows = nrows;
         return;
     }
 
     // Case 2: It is full of the same value
     if (cuDescPtr->IsSameValCU()) {
-        for (int rowCnt = 0; rowCnt < tids->m_rows; ++rowCnt) {
-            tidPtr = (ItemPointer)(tidVals + rowCnt);
-            tmpCuId = ItemPointerGetBlockNumber(tidPtr);
-            tmpOffset = ItemPointerGetOffsetNumber(tidPtr) - 1;
-            if (this->IsDeadRow(cuDescPtr->cu_id, tmpOffset)) {
-                continue;
+        if (attlen > 0 && attlen <= 8) {
+            Datum cuMin = *(Datum*)(cuDescPtr->cu_min);
+            for (int rowCnt = 0; rowCnt < nrows; ++rowCnt) {
+                vec->m_vals[rowCnt] = cuMin;
             }
-
-            if (attlen > 0 && attlen <= 8) {
-                Datum cuMin = *(Datum*)(cuDescPtr->cu_min);
-                vec->m_vals[pos] = cuMin;
-            } else if (attlen == 12 || attlen == 16) {
-                Datum cuMin = PointerGetDatum(cuDescPtr->cu_min);
-                vec->AddVar(cuMin, pos);
+        } else {
+            Datum cuMin;
+            // Convert string into varattrib_1b once for the whole batch
+            // It is safe because len < MIN_MAX_LEN
+            char tmpStr[MIN_MAX_LEN + VARHDRSZ];
+            if (attlen == 12 || attlen == 16) {
+                cuMin = PointerGetDatum(cuDescPtr->cu_min);
             } else {
-                Datum cuMin = PointerGetDatum(cuDescPtr->cu_min + 1);
+                cuMin = PointerGetDatum(cuDescPtr->cu_min + 1);
                 Size len = (Size)(unsigned char)cuDescPtr->cu_min[0];
                 Assert(len < MIN_MAX_LEN);
 
-                // Convert string into varattrib_1b
-                // It is safe because len < MIN_MAX_LEN
-                char tmpStr[MIN_MAX_LEN + VARHDRSZ];
                 if (attlen == -1) {
                     SET_VARSIZE_SHORT(tmpStr, len + VARHDRSZ_SHORT);
                     errno_t rc =
@@ -2748,17 +2858,18 @@ void CStore::FillVectorLateRead(
                     securec_check(rc, "\0", "\0");
                     cuMin = PointerGetDatum(tmpStr);
                 }
-
-                vec->AddVar(cuMin, pos);
             }
-            pos++;
+            for (int rowCnt = 0; rowCnt < nrows; ++rowCnt) {
+                vec->AddVar(cuMin, rowCnt);
+            }
         }
 
-        vec->m_rows = pos;
+        vec->m_rows = nrows;
         return;
     }
 
     // Case 3: It is a normal CU
+    int pos = 0;
     int slotId = CACHE_BLOCK_INVALID_IDX;
     CSTORESCAN_TRACE_START(GET_CU_DATA_LATER_READ);
     CU* cuPtr = this->GetCUData(cuDescPtr, colIdx, attlen, slotId);
@@ -703,6 +703,8 @@ bool CU::CompressData(_out_ char* outBuf, _in_ int nVals, _in_ int16 compress_mo
             /* input hints about both RLE and DICTIONARY encoding */
             strCoder.m_adopt_rle = ref_filter->m_adopt_rle;
             strCoder.m_adopt_dict = ref_filter->m_adopt_dict;
+            strCoder.m_adopt_zlib = ref_filter->m_adopt_zlib;
+            strCoder.m_sampling = !ref_filter->m_sampling_fihished;
             compressOutSize = strCoder.Compress(input, output);
         }
     }
@@ -2228,6 +2228,9 @@ static int FileAsyncSubmitIO(io_context_t aio_context, dlistType dList, int dLis
     int insufficientTimes = 0;
 
     u_sess->storage_cxt.AsyncSubmitIOCount = 0;
+    for (int i = 0; i < dListCount; i++) {
+        AioStampSubmitTime(&dList[i]->aiocb);
+    }
     do {
         Assert(dListCount > submitCount);
         retCount =
@@ -4377,7 +4377,7 @@ void CreateSharedRingBuffer(void)
  */
 static void IncrRefCount(snapxid_t* s)
 {
-    t_thrd.proc->snap_refcnt_bitmap |= 1 << (SNAPXID_INDEX(s) % 64);
+    t_thrd.proc->snap_refcnt_bitmap |= (uint64)1 << (SNAPXID_INDEX(s) % 64);
     pg_write_barrier();
 }
 
@@ -4386,7 +4386,7 @@ static void IncrRefCount(snapxid_t* s)
  */
 static void DecrRefCount(snapxid_t* s)
 {
-    t_thrd.proc->snap_refcnt_bitmap &= ~(1 << (SNAPXID_INDEX(s) % 64));
+    t_thrd.proc->snap_refcnt_bitmap &= ~((uint64)1 << (SNAPXID_INDEX(s) % 64));
     pg_write_barrier();
 }
 
@@ -4395,7 +4395,7 @@ static void DecrRefCount(snapxid_t* s)
  */
 static int IsZeroRefCount(snapxid_t* s)
 {
-    uint64 bitmap = 1 << (SNAPXID_INDEX(s) % 64);
+    uint64 bitmap = (uint64)1 << (SNAPXID_INDEX(s) % 64);
     for (int i = 0; i < g_instance.proc_array_idx->numProcs; i++) {
         if (g_instance.proc_base_all_procs[g_instance.proc_array_idx->pgprocnos[i]]->snap_refcnt_bitmap & bitmap) {
             return 0;
@@ -4454,7 +4454,11 @@ static void SetNextSnapXid()
 {
     if (g_snap_buffer != NULL) {
         g_snap_current = g_snap_next;
-        pg_write_barrier();
+        /*
+         * Full barrier: the reference counts checked below must be read after
+         * the new current pointer is visible, see GetCurrentSnapXid().
+         */
+        pg_memory_barrier();
         g_snap_assigned = true;
         snapxid_t* ret = (snapxid_t*)g_snap_current;
         size_t idx = SNAPXID_INDEX(ret);
@@ -4487,9 +4491,22 @@ loop:
  */
 static snapxid_t* GetCurrentSnapXid()
 {
-    snapxid_t* x = (snapxid_t*)g_snap_current;
-    IncrRefCount(x);
-    return x;
+    for (;;) {
+        snapxid_t* x = (snapxid_t*)g_snap_current;
+        IncrRefCount(x);
+
+        /*
+         * SetNextSnapXid() may have moved on and taken x as the next slot to
+         * fill before our reference became visible. It only does that once x
+         * is no longer current, so x is safe to read if it is still current
+         * (or current again) after we hold the reference.
+         */
+        pg_memory_barrier();
+        if (x == (snapxid_t*)g_snap_current) {
+            return x;
+        }
+        DecrRefCount(x);
+    }
 }
 
 /*
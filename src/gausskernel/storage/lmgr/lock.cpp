@@ -2450,11 +2450,22 @@ static bool FastPathGrantRelationLock(const FastPathTag &tag, LOCKMODE lockmode)
     uint32 f;
     uint32 unused_slot = FP_LOCK_SLOTS_PER_BACKEND;
 
-    /* Scan for existing entry for this relid, remembering empty slot. */
+    /*
+     * Scan for existing entry for this relid, remembering the first empty
+     * slot.  Filling slots from the front keeps the used ones together, so
+     * that with a large fast-path array most words are skipped whole.
+     */
     for (f = 0; f < FP_LOCK_SLOTS_PER_BACKEND; f++) {
-        if (FAST_PATH_GET_BITS(t_thrd.proc, f) == 0)
-            unused_slot = f;
-        else if (FAST_PATH_TAG_EQUALS(t_thrd.proc->fpRelId[f], tag)) {
+        if (FAST_PATH_LOCKBIT_IS_EMPTY(t_thrd.proc, f)) {
+            if (unused_slot == FP_LOCK_SLOTS_PER_BACKEND)
+                unused_slot = f;
+            f += FP_LOCK_SLOTS_PER_LOCKBIT - 1;
+            continue;
+        }
+        if (FAST_PATH_GET_BITS(t_thrd.proc, f) == 0) {
+            if (unused_slot == FP_LOCK_SLOTS_PER_BACKEND)
+                unused_slot = f;
+        } else if (FAST_PATH_TAG_EQUALS(t_thrd.proc->fpRelId[f], tag)) {
             Assert(!FAST_PATH_CHECK_LOCKMODE(t_thrd.proc, f, lockmode));
             FAST_PATH_SET_LOCKMODE(t_thrd.proc, f, lockmode);
             return true;
@@ -2485,6 +2496,10 @@ static bool FastPathUnGrantRelationLock(const FastPathTag &tag, LOCKMODE lockmod
 
     t_thrd.storage_cxt.FastPathLocalUseCount = 0;
     for (f = 0; f < FP_LOCK_SLOTS_PER_BACKEND; f++) {
+        if (FAST_PATH_LOCKBIT_IS_EMPTY(t_thrd.proc, f)) {
+            f += FP_LOCK_SLOTS_PER_LOCKBIT - 1;
+            continue;
+        }
         if (FAST_PATH_TAG_EQUALS(t_thrd.proc->fpRelId[f], tag) && FAST_PATH_CHECK_LOCKMODE(t_thrd.proc, f, lockmode)) {
             Assert(!result);
             FAST_PATH_CLEAR_LOCKMODE(t_thrd.proc, f, lockmode);
@@ -2525,6 +2540,11 @@ static bool FastPathTransferRelationLocks(LockMethod lockMethodTable, const LOCK
         for (f = 0; f < FP_LOCK_SLOTS_PER_BACKEND; f++) {
             uint32 lockmode;
 
+            if (FAST_PATH_LOCKBIT_IS_EMPTY(proc, f)) {
+                f += FP_LOCK_SLOTS_PER_LOCKBIT - 1;
+                continue;
+            }
+
             /* Look for an allocated slot matching the given relid. */
             if (!FAST_PATH_TAG_EQUALS(tag, proc->fpRelId[f]) || FAST_PATH_GET_BITS(proc, f) == 0)
                 continue;
@@ -2574,6 +2594,11 @@ static PROCLOCK *FastPathGetRelationLockEntry(LOCALLOCK *locallock)
     for (f = 0; f < FP_LOCK_SLOTS_PER_BACKEND; f++) {
         uint32 lockmode;
 
+        if (FAST_PATH_LOCKBIT_IS_EMPTY(t_thrd.proc, f)) {
+            f += FP_LOCK_SLOTS_PER_LOCKBIT - 1;
+            continue;
+        }
+
         /* Look for an allocated slot matching the given relid. */
         if (!FAST_PATH_TAG_EQUALS(tag, t_thrd.proc->fpRelId[f]) || FAST_PATH_GET_BITS(t_thrd.proc, f) == 0)
             continue;
@@ -2715,6 +2740,11 @@ VirtualTransactionId *GetLockConflicts(const LOCKTAG *locktag, LOCKMODE lockmode
             for (f = 0; f < FP_LOCK_SLOTS_PER_BACKEND; f++) {
                 uint32 lockmask;
 
+                if (FAST_PATH_LOCKBIT_IS_EMPTY(proc, f)) {
+                    f += FP_LOCK_SLOTS_PER_LOCKBIT - 1;
+                    continue;
+                }
+
                 /* Look for an allocated slot matching the given relid. */
                 if (!FAST_PATH_TAG_EQUALS(tag, proc->fpRelId[f]))
                     continue;
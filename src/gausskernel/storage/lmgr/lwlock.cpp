@@ -853,35 +853,39 @@ static bool LWLockAttemptLock(LWLock *lock, LWLockMode mode)
         }
 
         /*
-         * Attempt to swap in the state we are expecting. If we didn't see
-         * lock to be free, that's just the old value. If we saw it as free,
-         * we'll attempt to mark it acquired. The reason that we always swap
-         * in the value is that this doubles as a memory barrier. We could try
-         * to be smarter and only swap in values if we saw the lock as free,
-         * but benchmark haven't shown it as beneficial so far.
-         *
-         * Retry if the value changed since we last looked at it.
+         * If the lock is held in a conflicting mode, report that right away
+         * instead of swapping the unchanged value back in. A compare & exchange
+         * takes the cache line exclusive even when it writes nothing new, and
+         * with many waiters hammering a hot lock that steals the line from the
+         * holder again and again, while it tries to release. No barrier is
+         * needed on this path: callers that go on to sleep queue themselves
+         * first, which sets LW_FLAG_HAS_WAITERS with an atomic operation, and
+         * then look at the lock once more.
+         */
+        if (!lock_free) {
+            return true; /* someobdy else has the lock */
+        }
+
+        /*
+         * Attempt to mark the lock acquired. Retry if the value changed since
+         * we last looked at it.
          */
         if (pg_atomic_compare_exchange_u32(&lock->state, &old_state, desired_state)) {
-            if (lock_free) {
-                /* ENABLE_THREAD_CHECK only, Must acquire vector clock info from other
-                 * thread after got the lock */
-                if (desired_state & LW_VAL_EXCLUSIVE) {
-                    TsAnnotateRWLockAcquired(&lock->rwlock, 1);
-                } else {
-                    TsAnnotateRWLockAcquired(&lock->rwlock, 0);
-                }
+            /* ENABLE_THREAD_CHECK only, Must acquire vector clock info from other
+             * thread after got the lock */
+            if (desired_state & LW_VAL_EXCLUSIVE) {
+                TsAnnotateRWLockAcquired(&lock->rwlock, 1);
+            } else {
+                TsAnnotateRWLockAcquired(&lock->rwlock, 0);
+            }
 
-                /* Great! Got the lock. */
+            /* Great! Got the lock. */
 #ifdef LOCK_DEBUG
-                if (mode == LW_EXCLUSIVE) {
-                    lock->owner = t_thrd.proc;
-                }
-#endif
-                return false;
-            } else {
-                return true; /* someobdy else has the lock */
+            if (mode == LW_EXCLUSIVE) {
+                lock->owner = t_thrd.proc;
             }
+#endif
+            return false;
         }
     }
 }
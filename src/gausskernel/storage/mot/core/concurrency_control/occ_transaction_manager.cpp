@@ -380,6 +380,20 @@ final:
     return rc;
 }
 
+bool OccTransactionManager::PreAbortWriteCheck(const Access* access)
+{
+    if (!m_preAbort || access == nullptr) {
+        return true;
+    }
+
+    // Rows inserted by this transaction have no committed version to compare with
+    if (access->m_type != RD && access->m_type != RD_FOR_UPDATE && access->m_type != WR) {
+        return true;
+    }
+
+    return CheckVersion(access);
+}
+
 void OccTransactionManager::RollbackInserts(TxnManager* txMan)
 {
     return txMan->UndoInserts();
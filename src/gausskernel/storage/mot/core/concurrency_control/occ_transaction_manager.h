@@ -81,6 +81,17 @@ public:
      */
     RC ValidateOcc(TxnManager* tx);
 
+    /**
+     * @brief Checks, when a row is about to be updated or deleted, whether a
+     * concurrent transaction has already committed a newer version of it.
+     * @detail Such a transaction can never pass commit validation, so with
+     * pre-abort enabled it is failed right away instead of running the rest of
+     * its body first.
+     * @param access The access item of the row.
+     * @return True if the transaction may go on.
+     */
+    bool PreAbortWriteCheck(const Access* access);
+
     RC LockHeaders(TxnManager* txMan, uint32_t& numSentinelsLock);
 
     RC LockRows(TxnManager* txMan, uint32_t& numRowsLock);
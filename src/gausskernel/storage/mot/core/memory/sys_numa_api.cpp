@@ -62,6 +62,9 @@
 #define CPU_LONGS(x) (CPU_BYTES(x) / sizeof(long))
 
 #define HOW_MANY(x, y) (((x) + ((y)-1)) / (y))
+
+/* Size of a transparent huge page on the platforms we run on */
+#define THP_SIZE_BYTES (2 * 1024 * 1024)
 #define BITS_PER_LONG (8 * sizeof(unsigned long))
 #define BITS_PER_INT (8 * sizeof(unsigned int))
 #define LONGS_PER_BITS(n) HOW_MANY(n, BITS_PER_LONG)
@@ -295,6 +298,16 @@ static void* MotSysNumaMapAligned(size_t size, size_t align)
         }
     }
 
+#ifdef MADV_HUGEPAGE
+    // Chunk-aligned mappings are fully covered by huge pages, so ask for them even when transparent huge pages are
+    // only enabled on request (madvise mode). This saves TLB misses all over the row and index memory.
+    if (align % THP_SIZE_BYTES == 0 && size % THP_SIZE_BYTES == 0) {
+        if (madvise(mem, size, MADV_HUGEPAGE) != 0) {
+            MOT_LOG_DEBUG("madvise(MADV_HUGEPAGE) failed for %zu bytes at %p (%d)", size, mem, errno);
+        }
+    }
+#endif
+
     return mem;
 }
 
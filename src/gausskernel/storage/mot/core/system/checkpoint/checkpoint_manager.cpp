@@ -469,6 +469,12 @@ void CheckpointManager::FillTasksQueue()
         return;
     }
     GetTableManager()->AddTablesToList(m_tasksList);
+
+    // Hand out the biggest tables first, so that a large table picked up late does not keep a single worker
+    // busy long after all the others are done.
+    m_tasksList.sort([](const Table* lhs, const Table* rhs) {
+        return (uint64_t)lhs->GetRowCount() * lhs->GetTupleSize() > (uint64_t)rhs->GetRowCount() * rhs->GetTupleSize();
+    });
     m_numCpTasks = m_tasksList.size();
     m_mapfileInfo.clear();
     MOT_LOG_DEBUG("CheckpointManager::fillTasksQueue:: got %d tasks", m_tasksList.size());
@@ -95,10 +95,7 @@ bool CheckpointWorkerPool::Write(Buffer* buffer, Row* row, int fd)
             return false;
         }
 
-        if (CheckpointUtils::FlushFile(fd)) {
-            MOT_LOG_ERROR("CheckpointWorkerPool::write - failed to flush [%d]", fd);
-            return false;
-        }
+        // No fdatasync here, FinishFile syncs the whole segment before the checkpoint can complete
         buffer->Reset();
     }
     CheckpointUtils::EntryHeader entryHeader;
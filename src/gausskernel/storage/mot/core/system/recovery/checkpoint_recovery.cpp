@@ -23,6 +23,7 @@
  */
 
 #include <thread>
+#include <algorithm>
 #include "mot_engine.h"
 #include "checkpoint_recovery.h"
 #include "checkpoint_utils.h"
@@ -32,6 +33,51 @@
 namespace MOT {
 DECLARE_LOGGER(CheckpointRecovery, Recovery);
 
+/**
+ * @class CheckpointSegmentReader
+ * @brief Reads the entries of a checkpoint data file through a large buffer, instead of issuing three read()
+ * calls for every row.
+ */
+class CheckpointSegmentReader {
+public:
+    CheckpointSegmentReader(int fd, char* buf, size_t size) : m_fd(fd), m_buf(buf), m_size(size), m_len(0), m_pos(0)
+    {}
+
+    /**
+     * @brief Reads the next len bytes of the file.
+     * @return The number of bytes read, less than len on EOF or error.
+     */
+    size_t Read(char* data, size_t len)
+    {
+        size_t done = 0;
+        while (done < len) {
+            if (m_pos == m_len) {
+                size_t bytesRead = CheckpointUtils::ReadFile(m_fd, m_buf, m_size);
+                if (bytesRead == (size_t)-1 || bytesRead == 0) {
+                    break;
+                }
+                m_len = bytesRead;
+                m_pos = 0;
+            }
+            size_t chunk = std::min(len - done, m_len - m_pos);
+            errno_t erc = memcpy_s(data + done, len - done, m_buf + m_pos, chunk);
+            securec_check(erc, "\0", "\0");
+            m_pos += chunk;
+            done += chunk;
+        }
+        return done;
+    }
+
+private:
+    int m_fd;
+    char* m_buf;
+    size_t m_size;
+    size_t m_len;
+    size_t m_pos;
+};
+
+static constexpr size_t CHECKPOINT_RECOVERY_READ_BUFFER_SIZE = 1024 * 1024;
+
 bool CheckpointRecovery::Recover()
 {
     MOT::MOTEngine* engine = MOT::MOTEngine::GetInstance();
@@ -465,9 +511,18 @@ bool CheckpointRecovery::RecoverTableRows(
         return false;
     }
 
+    char* readBuffer = (char*)malloc(CHECKPOINT_RECOVERY_READ_BUFFER_SIZE);
+    if (readBuffer == nullptr) {
+        MOT_LOG_ERROR("CheckpointRecovery::RecoverTableRows: failed to allocate read buffer");
+        CheckpointUtils::CloseFile(fd);
+        status = RC_MEMORY_ALLOCATION_ERROR;
+        return false;
+    }
+    CheckpointSegmentReader segReader(fd, readBuffer, CHECKPOINT_RECOVERY_READ_BUFFER_SIZE);
+
     CheckpointUtils::EntryHeader entry;
     for (uint64_t i = 0; i < fileHeader.m_numOps; i++) {
-        reader = CheckpointUtils::ReadFile(fd, (char*)&entry, sizeof(CheckpointUtils::EntryHeader));
+        reader = segReader.Read((char*)&entry, sizeof(CheckpointUtils::EntryHeader));
         if (reader != sizeof(CheckpointUtils::EntryHeader)) {
             MOT_LOG_ERROR(
                 "CheckpointRecovery::RecoverTableRows: failed to read entry header (elem: %lu / %lu), reader %lu",
@@ -489,7 +544,7 @@ bool CheckpointRecovery::RecoverTableRows(
             break;
         }
 
-        reader = CheckpointUtils::ReadFile(fd, keyData, entry.m_keyLen);
+        reader = segReader.Read(keyData, entry.m_keyLen);
         if (reader != entry.m_keyLen) {
             MOT_LOG_ERROR(
                 "CheckpointRecovery::RecoverTableRows: failed to read entry key (elem: %lu / %lu), reader %lu",
@@ -500,7 +555,7 @@ bool CheckpointRecovery::RecoverTableRows(
             break;
         }
 
-        reader = CheckpointUtils::ReadFile(fd, entryData, entry.m_dataLen);
+        reader = segReader.Read(entryData, entry.m_dataLen);
         if (reader != entry.m_dataLen) {
             MOT_LOG_ERROR(
                 "CheckpointRecovery::RecoverTableRows: failed to read entry data (elem: %lu / %lu), reader %lu",
@@ -531,6 +586,7 @@ bool CheckpointRecovery::RecoverTableRows(
         if (entry.m_csn > maxCsn)
             maxCsn = entry.m_csn;
     }
+    free(readBuffer);
     CheckpointUtils::CloseFile(fd);
 
     MOT_LOG_DEBUG("[%u] CheckpointRecovery::RecoverTableRows table %u:%u, %lu rows recovered (%s)",
@@ -417,8 +417,13 @@ uint32_t RecoveryOps::RecoverLogOperationUpdate(TxnManager* txn, uint8_t* data,
         updated_columns_it.Next();
     }
 
-    txn->UpdateLastRowState(MOT::AccessType::WR);
+    status = txn->UpdateLastRowState(MOT::AccessType::WR, false);
     txn->DestroyTxnKey(key);
+    if (status != RC_OK) {
+        MOT_REPORT_ERROR(MOT_ERROR_INTERNAL, "Recovery Manager Update Row", "failed to update row state, tableId: %lu",
+            tableId);
+        return 0;
+    }
     if (((RecoveryManager*)GetRecoveryManager())->m_logStats != nullptr)
         ((RecoveryManager*)GetRecoveryManager())->m_logStats->IncUpdate(tableId);
     return sizeof(OperationCode) + sizeof(uint32_t) + sizeof(tableId) + sizeof(exId) + sizeof(keyLength) + keyLength +
@@ -680,7 +685,10 @@ void RecoveryOps::UpdateRow(TxnManager* txn, uint64_t tableId, uint64_t exId, ch
             if (row->IsAbsentRow()) {
                 row->UnsetAbsentRow();
             }
-            txn->UpdateLastRowState(MOT::AccessType::WR);
+            status = txn->UpdateLastRowState(MOT::AccessType::WR, false);
+            if (status != RC_OK) {
+                MOT_REPORT_ERROR(MOT_ERROR_INTERNAL, "updateRow", "failed to update row state, tableId: %lu", tableId);
+            }
         } else {
             // Row CSN is newer. Error!!!
             txn->DestroyTxnKey(key);
@@ -45,16 +45,16 @@ void TxnManager::RemoveTableFromStat(Table* t)
     m_accessMgr->RemoveTableFromStat(t);
 }
 
-void TxnManager::UpdateRow(Row* row, const int attr_id, double attr_value)
+RC TxnManager::UpdateRow(Row* row, const int attr_id, double attr_value)
 {
     row->SetValue(attr_id, attr_value);
-    UpdateLastRowState(AccessType::WR);
+    return UpdateLastRowState(AccessType::WR);
 }
 
-void TxnManager::UpdateRow(Row* row, const int attr_id, uint64_t attr_value)
+RC TxnManager::UpdateRow(Row* row, const int attr_id, uint64_t attr_value)
 {
     row->SetValue(attr_id, attr_value);
-    UpdateLastRowState(AccessType::WR);
+    return UpdateLastRowState(AccessType::WR);
 }
 
 InsItem* TxnManager::GetNextInsertItem(Index* index)
@@ -140,9 +140,14 @@ RC TxnManager::DeleteLastRow()
     return rc;
 }
 
-RC TxnManager::UpdateLastRowState(AccessType state)
+RC TxnManager::UpdateLastRowState(AccessType state, bool preAbortCheck)
 {
-    return m_accessMgr->UpdateRowState(state, m_accessMgr->GetLastAccess());
+    Access* access = m_accessMgr->GetLastAccess();
+    if (preAbortCheck && !m_occManager.PreAbortWriteCheck(access)) {
+        MOT_LOG_DEBUG("Row was changed by a concurrent transaction, aborting early");
+        return RC_SERIALIZATION_FAILURE;
+    }
+    return m_accessMgr->UpdateRowState(state, access);
 }
 
 bool TxnManager::IsUpdatedInCurrStmt()
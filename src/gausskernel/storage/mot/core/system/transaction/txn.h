@@ -348,9 +348,12 @@ public:
     /**
      * @brief Updates the state of the last row accessed in the local cache.
      * @param state The new row state.
+     * @param preAbortCheck Whether to fail early if a concurrent transaction
+     * already committed a newer version of the row. Recovery replays committed
+     * history and must pass false.
      * @return Return code denoting the execution result.
      */
-    RC UpdateLastRowState(AccessType state);
+    RC UpdateLastRowState(AccessType state, bool preAbortCheck = true);
 
     void CommitSecondaryItems();
 
@@ -369,9 +372,10 @@ public:
      * @param row The row to update.
      * @param attr_id The column identifier.
      * @param attr_value The new field value.
+     * @return Return code denoting the execution result.
      */
-    void UpdateRow(Row* row, const int attr_id, double attr_value);
-    void UpdateRow(Row* row, const int attr_id, uint64_t attr_value);
+    RC UpdateRow(Row* row, const int attr_id, double attr_value);
+    RC UpdateRow(Row* row, const int attr_id, uint64_t attr_value);
 
     /**
      * @brief Retrieves the latest epoch seen by this transaction.
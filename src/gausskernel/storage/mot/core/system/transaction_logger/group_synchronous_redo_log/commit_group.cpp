@@ -78,7 +78,6 @@ void CommitGroup::LogGroup()
     ILogger* logger = m_handler->GetLogger();
     logger->AddToLog(m_groupData, m_groupSize);
     logger->FlushLog();
-    m_commited = true;
     MOT_LOG_DEBUG("group committed. num entries: %d, handler id: %d", m_groupSize, m_handlerId);
 }
 
@@ -120,8 +119,11 @@ void CommitGroup::WaitMember()
 
 void CommitGroup::CommitInternal()
 {
-    std::unique_lock<std::mutex> lock(m_commitMutex);
+    // The group is already closed, so a new one fills up while this one is written and synced. Do the I/O outside
+    // m_commitMutex, members of this group reaching WaitMember would otherwise block on the mutex for all of it.
     LogGroup();
+    std::unique_lock<std::mutex> lock(m_commitMutex);
+    m_commited = true;
     lock.unlock();
     m_groupCommitedCV.notify_all();
 }
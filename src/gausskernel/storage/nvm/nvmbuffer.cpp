@@ -48,6 +48,18 @@ static inline bool BypassDram()
     return ((double)gs_random() / (double)MAX_RANDOM_VALUE) > g_instance.attr.attr_storage.nvm_attr.bypassDram;
 }
 
+/*
+ * Only pages that keep being hit while they sit in NVM are worth the copy
+ * to DRAM.  Every NVM pin bumps the usage count and the NVM clock sweep
+ * decays it, so it already tells how often the page is used lately.
+ */
+static const uint32 NVM_PROMOTE_USAGE_COUNT = 3;
+
+static inline bool NvmBufferIsHot(BufferDesc *buf)
+{
+    return BUF_STATE_GET_USAGECOUNT(pg_atomic_read_u32(&buf->state)) >= NVM_PROMOTE_USAGE_COUNT;
+}
+
 static BufferLookupEnt* NvmBufTableLookup(BufferTag *tag, uint32 hashcode)
 {
     return (BufferLookupEnt *)buf_hash_operate<HASH_FIND>(t_thrd.storage_cxt.SharedBufHash, tag, hashcode, NULL);
@@ -332,8 +344,8 @@ restart:
                 return nvmBuf;
             }
 
-            /* Haven't pinned the buffer ever */
-            if (BypassDram()) {
+            /* Haven't pinned the buffer ever, leave cold pages in NVM */
+            if (!NvmBufferIsHot(nvmBuf) || BypassDram()) {
                 /* want to return nvm buffer directly */
                 valid = NvmPinBuffer(nvmBuf, &migrate);
 
@@ -852,7 +864,15 @@ static BufferDesc *NvmStrategyGetBuffer(uint32* buf_state)
 
         local_buf_state = LockBufHdr(buf);
 
-        if (BUF_STATE_GET_REFCOUNT(local_buf_state) == 0 && !(local_buf_state & BM_IS_META) &&
+        /*
+         * A recently used buffer gets another round: decay its usage count,
+         * as StrategyGetBuffer does, so the count ages out pages that stop
+         * being hit and NvmBufferIsHot() sees recent use only.
+         */
+        if (BUF_STATE_GET_REFCOUNT(local_buf_state) == 0 && BUF_STATE_GET_USAGECOUNT(local_buf_state) != 0) {
+            local_buf_state -= BUF_USAGECOUNT_ONE;
+            try_counter = NVM_BUFFER_NUM * RETRY_COUNT;
+        } else if (BUF_STATE_GET_REFCOUNT(local_buf_state) == 0 && !(local_buf_state & BM_IS_META) &&
             (backend_can_flush_dirty_page() || !(local_buf_state & BM_DIRTY))) {
             *buf_state = local_buf_state;
             (void)pg_atomic_fetch_add_u64(&g_instance.ckpt_cxt_ctl->nvm_get_buf_num_clock_sweep, 1);
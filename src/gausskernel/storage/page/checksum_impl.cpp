@@ -16,6 +16,11 @@
 #include "knl/knl_variable.h"
 #include "storage/checksum_impl.h"
 
+#if defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#define CHECKSUM_USE_NEON
+#endif
+
 #define CSI_DT_TWO 2
 
 void ChecksumForZeroPadding(uint32 *sums, const uint32 *dataArr, uint32 currentLeft);
@@ -26,6 +31,41 @@ static inline uint32 pg_checksum_init(uint32 seed, uint32 value)
     return seed;
 }
 
+/*
+ * Feed "rows" rows of N_SUMS words into the partial checksums.  The N_SUMS
+ * lanes are independent, so on NEON the partial sums are kept in vector
+ * registers across the whole loop, four lanes per register.
+ */
+static inline void ChecksumRows(uint32* sums, const uint32* dataArr, uint32 rows)
+{
+#if defined(CHECKSUM_USE_NEON)
+    const uint32x4_t prime = vdupq_n_u32(FNV_PRIME);
+    uint32x4_t acc[N_SUMS / 4];
+
+    for (int k = 0; k < N_SUMS / 4; k++) {
+        acc[k] = vld1q_u32(sums + 4 * k);
+    }
+    for (uint32 i = 0; i < rows; i++) {
+        for (int k = 0; k < N_SUMS / 4; k++) {
+            uint32x4_t tmp = veorq_u32(acc[k], vld1q_u32(dataArr + 4 * k));
+            acc[k] = veorq_u32(vmulq_u32(tmp, prime), vshrq_n_u32(tmp, 17));
+        }
+        dataArr += N_SUMS;
+    }
+    for (int k = 0; k < N_SUMS / 4; k++) {
+        vst1q_u32(sums + 4 * k, acc[k]);
+    }
+#else
+    for (uint32 i = 0; i < rows; i++) {
+        for (uint32 j = 0; j < N_SUMS; j += CSI_DT_TWO) {
+            CHECKSUM_COMP(sums[j], dataArr[j]);
+            CHECKSUM_COMP(sums[j + 1], dataArr[j + 1]);
+        }
+        dataArr += N_SUMS;
+    }
+#endif
+}
+
 uint32 DataBlockChecksum(char* data, uint32 size, bool zeroing)
 {
     uint32 sums[N_SUMS];
@@ -67,13 +107,9 @@ uint32 DataBlockChecksum(char* data, uint32 size, bool zeroing)
     dataArr += N_SUMS;
 
     /* main checksum calculation */
-    for (i = 1; i < size / alignSize; i++) {
-        for (j = 0; j < N_SUMS; j += step) {
-            CHECKSUM_COMP(sums[j], dataArr[j]);
-            CHECKSUM_COMP(sums[j + 1], dataArr[j + 1]);
-        }
-        dataArr += N_SUMS;
-    }
+    i = (size / alignSize > 1) ? size / alignSize : 1;
+    ChecksumRows(sums, dataArr, i - 1);
+    dataArr += N_SUMS * (i - 1);
 
     /* checksum for zero padding */
     currentLeft -= alignSize * (i - 1);
@@ -114,7 +150,7 @@ uint32 pg_checksum_block(char* data, uint32 size)
     uint32 sums[N_SUMS];
     uint32* dataArr = (uint32*)data;
     uint32 result = 0;
-    uint32 i, j;
+    uint32 rows, j;
 
 #ifndef ROACH_COMMON
     /* ensure that the size is compatible with the algorithm */
@@ -130,13 +166,8 @@ uint32 pg_checksum_block(char* data, uint32 size)
     dataArr += N_SUMS;
 
     /* main checksum calculation */
-    for (i = 1; i < size / (sizeof(uint32) * N_SUMS); i++) {
-        for (j = 0; j < N_SUMS; j += step) {
-            CHECKSUM_COMP(sums[j], dataArr[j]);
-            CHECKSUM_COMP(sums[j + 1], dataArr[j + 1]);
-        }
-        dataArr += N_SUMS;
-    }
+    rows = size / (sizeof(uint32) * N_SUMS);
+    ChecksumRows(sums, dataArr, (rows > 0) ? rows - 1 : 0);
 
     /* finally add in two rounds of zeroes for additional mixing */
     for (j = 0; j < N_SUMS; j++) {
@@ -72,6 +72,22 @@ ParallelReorderBufferTXN *ParallelReorderBufferGetOldestTXN(ParallelReorderBuffe
     return txn;
 }
 
+/*
+ * Deform a decoded tuple in one pass.  Fetching the columns one by one with
+ * heap_getattr walks the tuple from its start again for every column that
+ * follows a null or variable-length one.
+ */
+static void DeformDecodedTuple(HeapTuple tuple, TupleDesc tupdesc, Datum **values, bool **isnull)
+{
+    *values = (Datum *)palloc(tupdesc->natts * sizeof(Datum));
+    *isnull = (bool *)palloc(tupdesc->natts * sizeof(bool));
+    if (tuple->tupTableType == HEAP_TUPLE) {
+        heap_deform_tuple(tuple, tupdesc, *values, *isnull);
+    } else {
+        UHeapDeformTuple((UHeapTuple)tuple, tupdesc, *values, *isnull);
+    }
+}
+
 void tuple_to_stringinfo(StringInfo s, TupleDesc tupdesc, HeapTuple tuple, bool skip_nulls)
 {
     if ((tuple->tupTableType == HEAP_TUPLE) && (HEAP_TUPLE_IS_COMPRESSED(tuple->t_data) ||
@@ -79,6 +95,10 @@ void tuple_to_stringinfo(StringInfo s, TupleDesc tupdesc, HeapTuple tuple, bool
         return;
     }
 
+    Datum *values = NULL;
+    bool *nulls = NULL;
+    DeformDecodedTuple(tuple, tupdesc, &values, &nulls);
+
     /* print all columns individually */
     for (int natt = 0; natt < tupdesc->natts; natt++) {
         Form_pg_attribute attr; /* the attribute itself */
@@ -95,12 +115,8 @@ void tuple_to_stringinfo(StringInfo s, TupleDesc tupdesc, HeapTuple tuple, bool
 
         typid = attr->atttypid;
 
-        /* get Datum from tuple */
-        if (tuple->tupTableType == HEAP_TUPLE) {
-            origval = heap_getattr(tuple, natt + 1, tupdesc, &isnull);
-        } else {
-            origval = uheap_getattr((UHeapTuple)tuple, natt + 1, tupdesc, &isnull);
-        }
+        origval = values[natt];
+        isnull = nulls[natt];
 
         if (isnull && skip_nulls) {
             continue;
@@ -138,6 +154,8 @@ void tuple_to_stringinfo(StringInfo s, TupleDesc tupdesc, HeapTuple tuple, bool
             PrintLiteral(s, typid, OidOutputFunctionCall(typoutput, val));
         }
     }
+    pfree(values);
+    pfree(nulls);
 }
 
 /*
@@ -291,6 +309,10 @@ static void TupleToJsoninfo(
         return;
     }
 
+    Datum *values = NULL;
+    bool *nulls = NULL;
+    DeformDecodedTuple(tuple, tupdesc, &values, &nulls);
+
     /* print all columns individually */
     for (int natt = 0; natt < tupdesc->natts; natt++) {
         Form_pg_attribute attr = tupdesc->attrs[natt]; /* the attribute itself */
@@ -299,15 +321,8 @@ static void TupleToJsoninfo(
         }
 
         Oid typid = attr->atttypid; /* type of current attribute */
-        Datum origval = 0;      /* possibly toasted Datum */
-
-        /* get Datum from tuple */
-        bool isnull = false; /* column is null? */
-        if (tuple->tupTableType == HEAP_TUPLE) {
-            origval = heap_getattr(tuple, natt + 1, tupdesc, &isnull);
-        } else {
-            origval = uheap_getattr((UHeapTuple)tuple, natt + 1, tupdesc, &isnull);
-        }
+        Datum origval = values[natt]; /* possibly toasted Datum */
+        bool isnull = nulls[natt];    /* column is null? */
         if (isnull && skip_nulls) {
             continue;
         }
@@ -347,6 +362,8 @@ static void TupleToJsoninfo(
         cJSON* col_val = cJSON_CreateString(val_str->data);
         cJSON_AddItemToArray(cols_val, col_val);
     }
+    pfree(values);
+    pfree(nulls);
 }
 
 /* parallel logical decoding callback with decode style: json */
@@ -485,6 +502,10 @@ static void AppendTuple(StringInfo s, TupleDesc tupdesc, HeapTuple tuple, bool s
     if (AppendInvalidations(s, tupdesc, tuple)) {
         return;
     }
+    Datum *values = NULL;
+    bool *nulls = NULL;
+    DeformDecodedTuple(tuple, tupdesc, &values, &nulls);
+
     int curPos = s->len;
     uint16 attrNum = 0;
     pq_sendint16(s, (uint16)(tupdesc->natts));
@@ -495,13 +516,8 @@ static void AppendTuple(StringInfo s, TupleDesc tupdesc, HeapTuple tuple, bool s
         }
 
         Oid typid = attr->atttypid;
-        bool isnull = false;
-        Datum origval = 0;
-        if (tuple->tupTableType == HEAP_TUPLE) {
-            origval = heap_getattr(tuple, natt + 1, tupdesc, &isnull);
-        } else {
-            origval = uheap_getattr((UHeapTuple)tuple, natt + 1, tupdesc, &isnull);
-        }
+        bool isnull = nulls[natt];
+        Datum origval = values[natt];
         if (isnull && skipNulls) {
             continue;
         }
@@ -527,6 +543,8 @@ static void AppendTuple(StringInfo s, TupleDesc tupdesc, HeapTuple tuple, bool s
             appendStringInfoString(s, data);
         }
     }
+    pfree(values);
+    pfree(nulls);
     attrNum = ntohs(attrNum);
     errno_t rc = memcpy_s(s->data + curPos, sizeof(uint16), &attrNum, sizeof(uint16));
     securec_check(rc, "", "");
@@ -794,14 +812,6 @@ logicalLog* getIUDLogicalLog(ParallelReorderBufferChange* change, ParallelLogica
         logChange = GetLogicalLog(worker);
         return logChange;
     }
-    /*
-     * Do not decode private tables, otherwise there will be security problems.
-     */
-    if (is_role_independent(FindRoleid(reloid))) {
-        logChange = GetLogicalLog(worker);
-        return logChange;
-    }
-
     relation = RelationIdGetRelation(reloid);
     if (relation == NULL) {
         ereport(DEBUG1, (errmsg("could open relation descriptor %s",
@@ -810,7 +820,18 @@ logicalLog* getIUDLogicalLog(ParallelReorderBufferChange* change, ParallelLogica
         return logChange;
     }
 
-    if (CSTORE_NAMESPACE == get_rel_namespace(RelationGetRelid(relation))) {
+    /*
+     * Do not decode private tables, otherwise there will be security problems.
+     * Owner and namespace come from the relcache entry, no need to look up
+     * pg_class again for every change.
+     */
+    if (is_role_independent(relation->rd_rel->relowner)) {
+        RelationClose(relation);
+        logChange = GetLogicalLog(worker);
+        return logChange;
+    }
+
+    if (CSTORE_NAMESPACE == RelationGetNamespace(relation)) {
         RelationClose(relation);
         logChange = GetLogicalLog(worker);
         return logChange;
@@ -1430,11 +1430,11 @@ void ReorderBufferCommit(ReorderBuffer *rb, TransactionId xid, XLogRecPtr commit
                     /*
                      * Do not decode private tables, otherwise there will be security problems.
                      */
-                    if (is_role_independent(FindRoleid(reloid))) {
+                    if (is_role_independent(relation->rd_rel->relowner)) {
                         continue;
                     }
 
-                    if (CSTORE_NAMESPACE == get_rel_namespace(RelationGetRelid(relation))) {
+                    if (CSTORE_NAMESPACE == RelationGetNamespace(relation)) {
                         continue;
                     }
 
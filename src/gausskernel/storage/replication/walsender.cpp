@@ -121,6 +121,14 @@ extern char *expand_dynamic_library_name(const char *name);
 extern bool PMstateIsRun(void);
 
 #define NAPTIME_PER_CYCLE 100 /* max sleep time between cycles (100ms) */
+
+/*
+ * WAL shipping compression backs off when it saves less than 1/8 of the
+ * data: the next 1, 2, 4 ... up to 256 messages are sent uncompressed
+ * before trying again.
+ */
+#define WAL_COMPRESS_MIN_SAVING_SHIFT 3
+#define WAL_COMPRESS_MAX_BACKOFF 256
 bool WalSegmemtRemovedhappened = false;
 volatile bool bSyncStat = false;
 volatile bool bSyncStatStatBefore = false;
@@ -4634,8 +4642,8 @@ static void WalSndShutdown(void)
 
 /*
  * Read 'count' bytes from WAL into 'buf', starting at location 'startptr'.
- * XXX probably this should be improved to suck data directly from the
- * WAL buffers when possible. Will open, and keep open, one WAL segment
+ * Recently flushed WAL is copied straight from the WAL buffers; what has
+ * already left them is read from the segment files. Will open, and keep open, one WAL segment
  * stored in the global file descriptor sendFile. This means if XLogRead is used
  * once, there will always be one descriptor left open until the process ends, but never
  * more than one.
@@ -4646,6 +4654,17 @@ static void XLogRead(char *buf, XLogRecPtr startptr, Size count)
     XLogRecPtr recptr;
     Size nbytes;
     XLogSegNo segno;
+    Size bufbytes;
+
+    /* Most of the time a caught-up sender finds all of it in the WAL buffers */
+    bufbytes = XLogReadFromBuffers(buf, startptr, count);
+    if (bufbytes == count) {
+        WalSegmemtRemovedhappened = false;
+        return;
+    }
+    buf += bufbytes;
+    XLByteAdvance(startptr, bufbytes);
+    count -= bufbytes;
 
 retry:
     p = buf;
@@ -5270,7 +5289,15 @@ void XLogCompression(int* compressedSize, XLogRecPtr startPtr, Size nbytes)
             (int)WS_MAX_SEND_SIZE);
         compressedBuf = t_thrd.walsender_cxt.compressBuf;
     }
-    
+
+    /* Recent WAL did not compress well, don't spend CPU on it for now */
+    if (t_thrd.walsender_cxt.compressSkip > 0) {
+        t_thrd.walsender_cxt.compressSkip--;
+        t_thrd.walsender_cxt.output_xlog_message[0] = 'w';
+        XLogRead(t_thrd.walsender_cxt.output_xlog_message + 1 + sizeof(WalDataMessageHeader), startPtr, nbytes);
+        return;
+    }
+
     XLogRead(xlogReadBuf, startPtr, nbytes);
     *compressedSize = LZ4_compress_default(xlogReadBuf, compressedBuf, nbytes, LZ4_compressBound(nbytes));
     if (*compressedSize > g_instance.attr.attr_storage.MaxSendSize * 1024) {
@@ -5297,6 +5324,19 @@ void XLogCompression(int* compressedSize, XLogRecPtr startPtr, Size nbytes)
     errorno = memcpy_s(t_thrd.walsender_cxt.output_xlog_message + 1 + sizeof(WalDataMessageHeader),
         *compressedSize, compressedBuf, *compressedSize);
     securec_check(errorno, "\0", "\0");
+
+    if ((Size)*compressedSize > nbytes - (nbytes >> WAL_COMPRESS_MIN_SAVING_SHIFT)) {
+        t_thrd.walsender_cxt.compressSkip = t_thrd.walsender_cxt.compressBackoff;
+        t_thrd.walsender_cxt.compressBackoff =
+            Min(t_thrd.walsender_cxt.compressBackoff * 2, WAL_COMPRESS_MAX_BACKOFF);
+        ereport(DEBUG2, ((errmodule(MOD_REDO), errcode(ERRCODE_LOG),
+            errmsg("[XLOG_COMPRESS] poor compression ratio at %X/%X (%ld -> %d), "
+                   "sending the next %d messages uncompressed",
+                   (uint32)(startPtr >> 32), (uint32)startPtr, nbytes, *compressedSize,
+                   t_thrd.walsender_cxt.compressSkip))));
+    } else {
+        t_thrd.walsender_cxt.compressBackoff = 1;
+    }
     ereport(DEBUG4, ((errmodule(MOD_REDO), errcode(ERRCODE_LOG),
         errmsg("[XLOG_COMPRESS] xlog compression working! startPtr %X/%X, origSize %ld, compressedSize %d",
         (uint32)(startPtr >> 32), (uint32)startPtr, nbytes, *compressedSize))));
@@ -29,6 +29,53 @@ char* CfsHeaderPagerCheckStatusList[] = {"verified success.",
 void CfsRecycleChunk(SMgrRelation reln, ForkNumber forknum);
 void CfsShrinkerShmemListPush(const RelFileNode &rnode, ForkNumber forknum, char parttype);
 
+/*
+ * The chunks of a page rewritten a few times end up near each other but not
+ * in order.  Reading the whole range that holds them in one call is cheaper
+ * than one read per run of adjacent chunks, as long as the range is not
+ * much larger than the page itself.
+ */
+#define CFS_MAX_CHUNK_SPAN_PAGES 2
+
+static bool CfsChunksAreScattered(const CfsExtentAddress *cfsExtentAddress, int chunkSize, uint16 *minChunk,
+                                  uint16 *maxChunk)
+{
+    int runs = 1;
+
+    *minChunk = cfsExtentAddress->chunknos[0];
+    *maxChunk = cfsExtentAddress->chunknos[0];
+    for (auto i = 1; i < cfsExtentAddress->nchunks; i++) {
+        if (cfsExtentAddress->chunknos[i] != cfsExtentAddress->chunknos[i - 1] + 1) {
+            runs++;
+        }
+        *minChunk = Min(*minChunk, cfsExtentAddress->chunknos[i]);
+        *maxChunk = Max(*maxChunk, cfsExtentAddress->chunknos[i]);
+    }
+    return runs > 1 && (*maxChunk - *minChunk + 1) * chunkSize <= CFS_MAX_CHUNK_SPAN_PAGES * BLCKSZ;
+}
+
+/* Read chunks minChunk .. maxChunk at once and gather the page's chunks in order */
+static bool CfsReadChunkSpan(File fd, const CfsExtentAddress *cfsExtentAddress, int chunkSize, off_t startOffset,
+                             uint16 minChunk, uint16 maxChunk, char *compressedBuffer)
+{
+    int spanSize = (maxChunk - minChunk + 1) * chunkSize;
+    char *spanBuffer = (char *)palloc(spanSize);
+    off_t seekPos = OffsetOfPageCompressChunk((uint16)chunkSize, minChunk) + startOffset;
+    int nbytes = FilePRead(fd, spanBuffer, spanSize, seekPos, (uint32)WAIT_EVENT_DATA_FILE_READ);
+    if (nbytes != spanSize) {
+        pfree(spanBuffer);
+        return false;
+    }
+
+    for (auto i = 0; i < cfsExtentAddress->nchunks; i++) {
+        errno_t rc = memcpy_s(compressedBuffer + (long)chunkSize * i, chunkSize,
+                              spanBuffer + (long)chunkSize * (cfsExtentAddress->chunknos[i] - minChunk), chunkSize);
+        securec_check(rc, "\0", "\0");
+    }
+    pfree(spanBuffer);
+    return true;
+}
+
 int CfsReadPage(SMgrRelation reln, ForkNumber forknum, BlockNumber logicBlockNumber, char *buffer,
                    CFS_STORAGE_TYPE type)
 {
@@ -67,18 +114,12 @@ int CfsReadPage(SMgrRelation reln, ForkNumber forknum, BlockNumber logicBlockNum
     auto startOffset = location.extentStart * BLCKSZ;
     char *compressedBuffer = (char *) palloc(chunkSize * cfsExtentAddress->nchunks);
     char *bufferPos = compressedBuffer;
+    uint16 minChunk;
+    uint16 maxChunk;
 
-    for (auto i = 0; i < cfsExtentAddress->nchunks; i++) {
-        bufferPos = compressedBuffer + (long)chunkSize * i;
-        off_t seekPos = OffsetOfPageCompressChunk((uint16)chunkSize, cfsExtentAddress->chunknos[i]) + startOffset;
-        uint8 start = (uint8)i;
-        while (i < cfsExtentAddress->nchunks - 1 &&
-               cfsExtentAddress->chunknos[i + 1] == cfsExtentAddress->chunknos[i] + 1) {
-            i++;
-        }
-        int readAmount = (int)(chunkSize * ((int)(i - (int)start) + 1));
-        int nbytes = FilePRead(location.fd, bufferPos, readAmount, seekPos, (uint32)WAIT_EVENT_DATA_FILE_READ);
-        if (nbytes != readAmount) {
+    if (CfsChunksAreScattered(cfsExtentAddress, chunkSize, &minChunk, &maxChunk)) {
+        if (!CfsReadChunkSpan(location.fd, cfsExtentAddress, chunkSize, startOffset, minChunk, maxChunk,
+                              compressedBuffer)) {
             rc = memset_s(buffer, BLCKSZ, 0, BLCKSZ);
             securec_check(rc, "\0", "\0");
 
@@ -86,6 +127,27 @@ int CfsReadPage(SMgrRelation reln, ForkNumber forknum, BlockNumber logicBlockNum
             pfree(compressedBuffer);
             return -1;
         }
+    } else {
+        for (auto i = 0; i < cfsExtentAddress->nchunks; i++) {
+            bufferPos = compressedBuffer + (long)chunkSize * i;
+            off_t seekPos =
+                OffsetOfPageCompressChunk((uint16)chunkSize, cfsExtentAddress->chunknos[i]) + startOffset;
+            uint8 start = (uint8)i;
+            while (i < cfsExtentAddress->nchunks - 1 &&
+                   cfsExtentAddress->chunknos[i + 1] == cfsExtentAddress->chunknos[i] + 1) {
+                i++;
+            }
+            int readAmount = (int)(chunkSize * ((int)(i - (int)start) + 1));
+            int nbytes = FilePRead(location.fd, bufferPos, readAmount, seekPos, (uint32)WAIT_EVENT_DATA_FILE_READ);
+            if (nbytes != readAmount) {
+                rc = memset_s(buffer, BLCKSZ, 0, BLCKSZ);
+                securec_check(rc, "\0", "\0");
+
+                pca_buf_free_page(ctrl, location, false);
+                pfree(compressedBuffer);
+                return -1;
+            }
+        }
     }
 
     if (cfsExtentAddress->nchunks == (BLCKSZ / chunkSize)) {
@@ -115,6 +115,7 @@ static MdfdVec *_fdvec_alloc(void);
 static char *_mdfd_segpath(const SMgrRelation reln, ForkNumber forknum, BlockNumber segno);
 static MdfdVec *_mdfd_openseg(SMgrRelation reln, ForkNumber forkno, BlockNumber segno, int oflags);
 static MdfdVec *_mdfd_getseg(SMgrRelation reln, ForkNumber forkno, BlockNumber blkno, bool skipFsync, ExtensionBehavior behavior);
+static MdfdVec *_mdfd_getseg_existing(SMgrRelation reln, ForkNumber forknum, BlockNumber blkno);
 static BlockNumber _mdnblocks(SMgrRelation reln, ForkNumber forknum, const MdfdVec *seg);
 static void register_dirty_segment(SMgrRelation reln, ForkNumber forknum, const MdfdVec *seg);
 static void register_unlink_segment(RelFileNodeBackend rnode, ForkNumber forknum, BlockNumber segno);
@@ -822,13 +823,26 @@ void mdprefetch(SMgrRelation reln, ForkNumber forknum, BlockNumber blocknum)
 {
 #ifdef USE_PREFETCH
     if (IS_COMPRESSED_MAINFORK(reln, forknum)) {
+        /* redo prefetch must not fail on relations dropped later in the WAL */
+        if (t_thrd.xlog_cxt.InRecovery) {
+            return;
+        }
         CfsMdPrefetch(reln, forknum, blocknum, false, COMMON_STORAGE);
         return;
     }
     off_t seekpos;
     MdfdVec *v = NULL;
 
-    v = _mdfd_getseg(reln, forknum, blocknum, false, EXTENSION_FAIL);
+    /*
+     * During recovery the block may belong to a file or segment that does not
+     * exist (yet, or any more); _mdfd_getseg would create it, which is redo's
+     * business, not a prefetch hint's.
+     */
+    if (t_thrd.xlog_cxt.InRecovery) {
+        v = _mdfd_getseg_existing(reln, forknum, blocknum);
+    } else {
+        v = _mdfd_getseg(reln, forknum, blocknum, false, EXTENSION_FAIL);
+    }
     if (v == NULL) {
         return;
     }
@@ -840,6 +854,44 @@ void mdprefetch(SMgrRelation reln, ForkNumber forknum, BlockNumber blocknum)
     (void)FilePrefetch(v->mdfd_vfd, seekpos, BLCKSZ, WAIT_EVENT_DATA_FILE_PREFETCH);
 #endif /* USE_PREFETCH */
 }
+
+/*
+ *	mdprefetchrange() -- Initiate asynchronous read of a run of consecutive blocks
+ *
+ * Like mdwriteback(), the run is split at segment boundaries only, so that each
+ * piece costs a single posix_fadvise() call instead of one call per block.
+ */
+void mdprefetchrange(SMgrRelation reln, ForkNumber forknum, BlockNumber blocknum, BlockNumber nblocks)
+{
+#ifdef USE_PREFETCH
+    if (IS_COMPRESSED_MAINFORK(reln, forknum)) {
+        for (BlockNumber i = 0; i < nblocks; i++) {
+            CfsMdPrefetch(reln, forknum, blocknum + i, false, COMMON_STORAGE);
+        }
+        return;
+    }
+
+    while (nblocks > 0) {
+        BlockNumber nprefetch = Min(nblocks, (BlockNumber)RELSEG_SIZE - (blocknum % ((BlockNumber)RELSEG_SIZE)));
+        off_t seekpos;
+        MdfdVec *v = NULL;
+
+        v = _mdfd_getseg(reln, forknum, blocknum, false, EXTENSION_FAIL);
+        if (v == NULL) {
+            return;
+        }
+
+        seekpos = (off_t)BLCKSZ * (blocknum % ((BlockNumber)RELSEG_SIZE));
+
+        Assert(seekpos + (off_t)BLCKSZ * nprefetch <= (off_t)BLCKSZ * RELSEG_SIZE);
+
+        (void)FilePrefetch(v->mdfd_vfd, seekpos, (int)(BLCKSZ * nprefetch), WAIT_EVENT_DATA_FILE_PREFETCH);
+
+        nblocks -= nprefetch;
+        blocknum += nprefetch;
+    }
+#endif /* USE_PREFETCH */
+}
 /*
  * mdwriteback() -- Tell the kernel to write pages back to storage.
  *
@@ -1805,6 +1857,32 @@ static MdfdVec *_mdfd_openseg(SMgrRelation reln, ForkNumber forknum, BlockNumber
     return v;
 }
 
+/*
+ *  _mdfd_getseg_existing() -- Find the segment holding the specified block,
+ *      without creating missing files or segments.
+ *
+ * Returns NULL if the relation or the segment does not exist on disk.
+ */
+static MdfdVec *_mdfd_getseg_existing(SMgrRelation reln, ForkNumber forknum, BlockNumber blkno)
+{
+    MdfdVec *v = mdopen(reln, forknum, EXTENSION_RETURN_NULL);
+    BlockNumber targetseg = blkno / ((BlockNumber)RELSEG_SIZE);
+
+    if (v == NULL) {
+        return NULL;
+    }
+    for (BlockNumber nextsegno = 1; nextsegno <= targetseg; nextsegno++) {
+        if (v->mdfd_chain == NULL) {
+            v->mdfd_chain = _mdfd_openseg(reln, forknum, nextsegno, 0);
+            if (v->mdfd_chain == NULL) {
+                return NULL;
+            }
+        }
+        v = v->mdfd_chain;
+    }
+    return v;
+}
+
 /*
  *  _mdfd_getseg() -- Find the segment of the relation holding the
  *      specified block.
@@ -33,6 +33,8 @@
 #include "storage/smgr/segment.h"
 #include "postmaster/pagerepair.h"
 
+#include <linux/falloc.h>
+
 static const mode_t SEGMENT_FILE_MODE = S_IWUSR | S_IRUSR;
 
 static int dv_open_file(char *filename, uint32 flags, int mode);
@@ -401,6 +403,24 @@ void df_open_files(SegLogicFile *sf)
     df_open_target_files(sf, 0);
 }
 
+/*
+ * ftruncate only makes the new range of a data file a hole, so every first
+ * write into it still allocates blocks in the filesystem, while concurrent
+ * inserts are filling the new extents.  With enable_fast_allocate, reserve
+ * the whole range right away instead.  This is only an optimization:
+ * filesystems without fallocate support keep the sparse file.
+ */
+static void df_preallocate(int fd, off_t offset, off_t len, const char *filename)
+{
+    if (!u_sess->attr.attr_sql.enable_fast_allocate || len <= 0) {
+        return;
+    }
+    if (fallocate(fd, FALLOC_FL_KEEP_SIZE, offset, len) != 0) {
+        ereport(LOG, (errmodule(MOD_SEGMENT_PAGE),
+            errmsg("fallocate file %s failed during df_extend due to %s", filename, strerror(errno))));
+    }
+}
+
 /*
  * Extend logic file once. Each time we extend at most DF_FILE_SLICE_SIZE.
  */
@@ -430,6 +450,7 @@ void df_extend_internal(SegLogicFile *sf)
                     errmsg("ftuncate file %s failed during df_extend due to %s", filename, strerror(errno)),
                     errdetail("file path: %s", sf->filename)));
         }
+        df_preallocate(new_fd, 0, DF_FILE_EXTEND_STEP_SIZE, filename);
 
         sf->segfiles[new_sliceno] = {.fd = new_fd, .sliceno = new_sliceno};
         sf->file_num++;
@@ -445,10 +466,12 @@ void df_extend_internal(SegLogicFile *sf)
 
         SegmentCheck(new_size <= DF_FILE_SLICE_SIZE);
 
+        char *filename = slice_filename(sf->filename, sf->file_num - 1);
         if (ftruncate(fd, new_size) != 0) {
-            char *filename = slice_filename(sf->filename, sf->file_num - 1);
             ereport(ERROR, (errmsg("ftuncate file %s failed during df_extend due to %s", filename, strerror(errno))));
         }
+        df_preallocate(fd, last_file_size, new_size - last_file_size, filename);
+        pfree(filename);
 
         sf->total_blocks += (new_size - last_file_size) / BLCKSZ;
     }
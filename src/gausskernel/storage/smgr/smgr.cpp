@@ -663,6 +663,25 @@ void smgrprefetch(SMgrRelation reln, ForkNumber forknum, BlockNumber blocknum)
     (*(smgrsw[reln->smgr_which].smgr_prefetch))(reln, forknum, blocknum);
 }
 
+/*
+ *	smgrprefetchrange() -- Initiate asynchronous read of nblocks consecutive
+ *	blocks of a relation.
+ *
+ * Only md knows how to issue the whole run at once, the other storage
+ * managers get one smgr_prefetch call per block.
+ */
+void smgrprefetchrange(SMgrRelation reln, ForkNumber forknum, BlockNumber blocknum, BlockNumber nblocks)
+{
+    if (reln->smgr_which == MD_MANAGER) {
+        mdprefetchrange(reln, forknum, blocknum, nblocks);
+        return;
+    }
+
+    for (BlockNumber i = 0; i < nblocks; i++) {
+        (*(smgrsw[reln->smgr_which].smgr_prefetch))(reln, forknum, blocknum + i);
+    }
+}
+
 /*
  *	smgrasyncread() -- Initiate asynchronous read of the specified blocks
  *	of a relation.
@@ -40,6 +40,10 @@
 
 class BatchCUData;
 
+namespace filter {
+class BloomFilter;
+}
+
 // If we load all CUDesc, the memory will be huge,
 // So we define this data structure defining the load CUDesc information
 //
@@ -273,6 +277,7 @@ private:  // private methods.
     bool NeedLoadCUDesc(int32 &cudesc_idx);
     void IncLoadCuDescIdx(int &idx) const;
     bool RoughCheck(CStoreScanKey scanKey, int nkeys, int cuDescIdx);
+    bool RuntimeFilterCheck(int cuDescIdx);
 
     void FillColMinMax(CUDesc *cuDescPtr, ScalarVector *vec, int pos);
 
@@ -330,6 +335,15 @@ private:
     // 
     RoughCheckFunc *m_RCFuncs;
 
+    // Runtime filters pushed down from hash joins above this scan.
+    // They are checked against CU min/max once the build side is ready.
+    //
+    int m_RFNum;
+    int *m_RFColSeq;
+    Oid *m_RFTypes;
+    int *m_RFIndex;
+    filter::BloomFilter **m_RFArray;
+
     typedef int (CStore::*m_colFillFun)(int seq, CUDesc *cuDescPtr, ScalarVector *vec);
 
     typedef struct {
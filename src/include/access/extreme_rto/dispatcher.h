@@ -33,6 +33,7 @@
 #include "access/xlogreader.h"
 #include "nodes/pg_list.h"
 #include "storage/proc.h"
+#include "storage/smgr/smgr.h"
 #include "access/redo_statistic.h"
 #include "access/extreme_rto/redo_item.h"
 #include "access/extreme_rto/page_redo.h"
@@ -64,6 +65,8 @@ typedef struct ReadPipeline {
 
 #define MAX_ALLOC_SEGNUM (4) /* 16* 4 */
 
+#define REDO_PREFETCH_REL_CACHE_SIZE (16)
+
 typedef enum {
     WORKER_STATE_STOP = 0,
     WORKER_STATE_RUN,
@@ -176,6 +179,8 @@ typedef struct {
     volatile bool recoveryStop;
     volatile XLogRedoNumStatics xlogStatics[RM_NEXT_ID][MAX_XLOG_INFO_NUM];
     RedoTimeCost *startupTimeCost;
+    SMgrRelation prefetchRels[REDO_PREFETCH_REL_CACHE_SIZE]; /* smgr handles owned by redo prefetch */
+    uint32 prefetchRelNext;                                   /* next prefetchRels slot to reuse */
 } LogDispatcher;
 
 typedef struct {
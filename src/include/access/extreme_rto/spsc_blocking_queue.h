@@ -34,9 +34,17 @@
 namespace extreme_rto {
 typedef void (*CallBackFunc)();
 
+/* Elements handed over per publish of the write head, one cache line of pointers. */
+#define SPSC_QUEUE_PUT_BATCH (PG_CACHE_LINE_SIZE / sizeof(void *))
+
 struct SPSCBlockingQueue {
+    /* the indexes are written by different threads, keep them on their own cache lines */
     pg_atomic_uint32 writeHead; /* Array index for the next write. */
+    char pad1[PG_CACHE_LINE_SIZE - sizeof(pg_atomic_uint32)];
     pg_atomic_uint32 readTail;  /* Array index for the next read. */
+    char pad2[PG_CACHE_LINE_SIZE - sizeof(pg_atomic_uint32)];
+    pg_atomic_uint64 fullWaitCnt;  /* times the producer found the queue full */
+    pg_atomic_uint64 emptyWaitCnt; /* times the consumer slept on an empty queue */
     uint32 capacity;            /* Queue capacity, must be power of 2. */
     uint32 mask;                /* Bit mask for computing index. */
     pg_atomic_uint32 maxUsage;
@@ -50,6 +58,7 @@ SPSCBlockingQueue *SPSCBlockingQueueCreate(uint32 capacity, CallBackFunc func =
 void SPSCBlockingQueueDestroy(SPSCBlockingQueue *queue);
 
 bool SPSCBlockingQueuePut(SPSCBlockingQueue *queue, void *element);
+bool SPSCBlockingQueuePutN(SPSCBlockingQueue *queue, void **elements, uint32 n);
 void *SPSCBlockingQueueTake(SPSCBlockingQueue *queue);
 bool SPSCBlockingQueueIsEmpty(SPSCBlockingQueue *queue);
 void *SPSCBlockingQueueTop(SPSCBlockingQueue *queue);
@@ -21,6 +21,7 @@
 #include "access/sdir.h"
 #include "access/xlogreader.h"
 #include "catalog/pg_index.h"
+#include "catalog/pg_proc.h"
 #include "lib/stringinfo.h"
 #include "storage/buf/bufmgr.h"
 #include "utils/tuplesort.h"
@@ -1115,6 +1116,41 @@ extern BTStack _bt_search(
 extern Buffer _bt_moveright(Relation rel, Buffer buf, int keysz, ScanKey scankey, bool nextkey, bool forupdate, BTStack stack, int access);
 extern OffsetNumber _bt_binsrch(Relation rel, Buffer buf, int keysz, ScanKey scankey, bool nextkey);
 extern int32 _bt_compare(Relation rel, int keysz, ScanKey scankey, Page page, OffsetNumber offnum);
+
+/*
+ * Compare a non-null index datum with a non-null scan key argument without
+ * going through fmgr, for the integer-like opclasses that dominate point
+ * lookups.  The result has the sign of cmp(datum, argument), before any
+ * SK_BT_DESC adjustment.  Returns false if the comparison proc is not one
+ * we can inline.
+ */
+static inline bool _bt_inline_compare(ScanKey scankey, Datum datum, int32* result)
+{
+    switch (scankey->sk_func.fn_oid) {
+        case BTINT4CMP_OID:
+        case DATECMPFUNCOID: {
+            int32 a = DatumGetInt32(datum);
+            int32 b = DatumGetInt32(scankey->sk_argument);
+
+            *result = (a > b) ? 1 : ((a == b) ? 0 : -1);
+            return true;
+        }
+        case BTINT8CMP_OID:
+#ifdef HAVE_INT64_TIMESTAMP
+        case TIMESTAMPCMPFUNCOID:
+        case TIMESTAMPTZCMPFUNCOID:
+#endif
+        {
+            int64 a = DatumGetInt64(datum);
+            int64 b = DatumGetInt64(scankey->sk_argument);
+
+            *result = (a > b) ? 1 : ((a == b) ? 0 : -1);
+            return true;
+        }
+        default:
+            return false;
+    }
+}
 extern bool _bt_first(IndexScanDesc scan, ScanDirection dir);
 extern bool _bt_next(IndexScanDesc scan, ScanDirection dir);
 extern Buffer _bt_walk_left(Relation rel, Buffer buf);
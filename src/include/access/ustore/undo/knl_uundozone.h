@@ -304,17 +304,17 @@ public:
 private:
     static const uint32 UNDO_ZONE_ATTACHED = 1;
     static const uint32 UNDO_ZONE_DETACHED = 0;
+    /*
+     * Fields advanced by the attached thread on every transaction and the ones
+     * advanced by the undo recycler are kept on separate cache lines, so the
+     * recycler sweeping all zones does not keep stealing the line the owner is
+     * allocating from.  The trailing pad does the same for the next zone object.
+     */
     pg_atomic_uint32 attached_;
     UndoSlotBuffer buf_;
     UndoSlotOffset allocateTSlotPtr_;
-    UndoSlotOffset recycleTSlotPtr_;
-    UndoSlotPtr frozenSlotPtr_;
     UndoLogOffset insertURecPtr_;
-    UndoLogOffset discardURecPtr_;
-    UndoLogOffset forceDiscardURecPtr_;
     UndoPersistence pLevel_;
-    TransactionId recycleXid_;
-    TransactionId frozenXid_;
     ThreadId attachPid_;
     /* Need Lock undo zone before alloc, preventing from checkpoint. */
     LWLock *lock_;
@@ -324,6 +324,16 @@ private:
     bool dirty_;
     /* Zone id. */
     int zid_;
+    char ownerPad_[PG_CACHE_LINE_SIZE];
+
+    /* Advanced by the undo recycler. */
+    UndoSlotOffset recycleTSlotPtr_;
+    UndoSlotPtr frozenSlotPtr_;
+    UndoLogOffset discardURecPtr_;
+    UndoLogOffset forceDiscardURecPtr_;
+    TransactionId recycleXid_;
+    TransactionId frozenXid_;
+    char recyclerPad_[PG_CACHE_LINE_SIZE];
 }; // class UndoZone
 
 class UndoZoneGroup {
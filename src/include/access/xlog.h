@@ -101,6 +101,13 @@ typedef enum {
 #endif
 } RecoveryTargetType;
 
+/* Compression of full-page images, see BKPIMAGE_COMPRESS_* */
+typedef enum WalFpiCompression {
+    WAL_FPI_COMPRESSION_OFF = 0,
+    WAL_FPI_COMPRESSION_LZ4,
+    WAL_FPI_COMPRESSION_ZSTD
+} WalFpiCompression;
+
 /* WAL levels */
 typedef enum WalLevel {
     WAL_LEVEL_MINIMAL = 0,
@@ -607,6 +614,9 @@ typedef struct XLogCtlData {
 } XLogCtlData;
 
 /* Xlog flush statistics*/
+/* log2 buckets of the walwriter flush batch size (entries) and hold time (us) histograms */
+#define WAL_FLUSH_HIST_BUCKETS 16
+
 struct XlogFlushStats{
     bool statSwitch;
     uint64 writeTimes;
@@ -623,6 +633,9 @@ struct XlogFlushStats{
     uint64 avgSyncTime;
     uint64 currOpenXlogSegNo;
     TimestampTz lastRestTime;
+    uint64 batchSizeHist[WAL_FLUSH_HIST_BUCKETS];
+    uint64 waitTimeHist[WAL_FLUSH_HIST_BUCKETS];
+    TimestampTz lastHistReportTime;
 };
 
 extern XLogSegNo GetNewestXLOGSegNo(const char* workingPath);
@@ -637,6 +650,7 @@ extern void XLogMultiFileInit(int advance_xlog_file_num);
 extern XLogRecPtr XLogInsertRecord(struct XLogRecData* rdata, XLogRecPtr fpw_lsn);
 extern void XLogWaitFlush(XLogRecPtr recptr);
 extern void XLogWaitBufferInit(XLogRecPtr recptr);
+extern Size XLogReadFromBuffers(char* buf, XLogRecPtr startptr, Size count);
 extern void UpdateMinRecoveryPoint(XLogRecPtr lsn, bool force);
 extern bool XLogBackgroundFlush(void);
 extern bool XLogNeedsFlush(XLogRecPtr RecPtr);
@@ -83,7 +83,7 @@ extern bool DecodeXLogRecord(XLogReaderState* state, XLogRecord* record, char**
 #define XLogRecHasBlockRef(decoder, block_id) ((decoder)->blocks[block_id].in_use)
 #define XLogRecHasBlockImage(decoder, block_id) ((decoder)->blocks[block_id].has_image)
 
-extern void RestoreBlockImage(const char* bkp_image, uint16 hole_offset, uint16 hole_length, char* page);
+extern bool RestoreBlockImage(const char* bkp_image, uint16 hole_offset, uint16 hole_length, char* page);
 extern char* XLogRecGetBlockData(XLogReaderState* record, uint8 block_id, Size* len);
 extern bool allocate_recordbuf(XLogReaderState* state, uint32 reclength);
 extern bool XlogFileIsExisted(const char* workingPath, XLogRecPtr inputLsn, TimeLineID timeLine);
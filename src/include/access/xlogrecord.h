@@ -110,6 +110,18 @@ typedef struct XLogRecordBlockImageHeader {
 
 #define SizeOfXLogRecordBlockImageHeader sizeof(XLogRecordBlockImageHeader)
 
+/*
+ * A compressed image keeps the layout above: hole_offset carries the
+ * compression method in its high bits, which are never set for a real hole
+ * offset, and the whole page, hole zeroed, is stored compressed in
+ * BLCKSZ - hole_length bytes. Readers that only size the payload thus need no
+ * change; RestoreBlockImage() decompresses it.
+ */
+#define BKPIMAGE_COMPRESS_LZ4 0x4000
+#define BKPIMAGE_COMPRESS_ZSTD 0x8000
+#define BKPIMAGE_COMPRESS_MASK (BKPIMAGE_COMPRESS_LZ4 | BKPIMAGE_COMPRESS_ZSTD)
+#define BKPIMAGE_IS_COMPRESSED(hole_offset) (((hole_offset) & BKPIMAGE_COMPRESS_MASK) != 0)
+
 /*
  * Maximum size of the header for a block reference. This is used to size a
  * temporary buffer for constructing the header.
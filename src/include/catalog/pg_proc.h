@@ -185,6 +185,10 @@ typedef FormData_pg_proc *Form_pg_proc;
 #define TINTERVALOUTFUNCOID 247
 #define TIMENOWFUNCOID 250
 #define BTINT4CMP_OID 351
+#define BTINT8CMP_OID 842
+#define DATECMPFUNCOID 1092
+#define TIMESTAMPTZCMPFUNCOID 1314
+#define TIMESTAMPCMPFUNCOID 2045
 #define RTRIM1FUNCOID 401
 #define NAME2TEXTFUNCOID 406
 #define HASHINT4OID 450
@@ -126,6 +126,15 @@ public:
      */
     static llvm::Function* SortAggMatchKeyCodeGen(VecAggState* node);
 
+    /*
+     * @Brief		: Codegeneration for sort aggregation.
+     * @Description	: Generate the match_key function of SortAggRunner and
+     *				  register it to the MCJIT, so that the jitted function
+     *				  is used in BatchMatchAndAgg.
+     * @in node		: VecAggState, the sort aggregation node.
+     */
+    static void SortAggCodeGen(VecAggState* node);
+
     /*
      * @Description	: Code generation for bpchareq function called by
      *				  match_key function in Sort Aggregation.
@@ -31,6 +31,12 @@
 #include "math.h"
 #include "float.h"
 
+#if defined(__x86_64__) && defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
 #define MATRIX_CACHE 16
 
 typedef struct Matrix {
@@ -188,6 +194,66 @@ void matrix_gram_schmidt(Matrix *matrix, int32_t const num_vectors);
 // ///////////////////////////////////////////////////////////////////////////
 // inline
 
+/*
+ * Vector kernels shared by the matrix operations below. Two 128-bit
+ * accumulators are kept so that consecutive additions do not wait on each
+ * other; the order of the additions differs from a plain loop, hence the
+ * last bits of a sum may too.
+ */
+inline float8 matrix_dot_kernel(const float8 *p1, const float8 *p2, size_t count)
+{
+    float8 result = 0.0;
+    size_t i = 0;
+
+#if defined(__x86_64__) && defined(__SSE2__)
+    __m128d sum0 = _mm_setzero_pd();
+    __m128d sum1 = _mm_setzero_pd();
+    for (; i + 4 <= count; i += 4) {
+        sum0 = _mm_add_pd(sum0, _mm_mul_pd(_mm_loadu_pd(p1 + i), _mm_loadu_pd(p2 + i)));
+        sum1 = _mm_add_pd(sum1, _mm_mul_pd(_mm_loadu_pd(p1 + i + 2), _mm_loadu_pd(p2 + i + 2)));
+    }
+    sum0 = _mm_add_pd(sum0, sum1);
+    sum0 = _mm_add_sd(sum0, _mm_unpackhi_pd(sum0, sum0));
+    result = _mm_cvtsd_f64(sum0);
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+    float64x2_t sum0 = vdupq_n_f64(0.0);
+    float64x2_t sum1 = vdupq_n_f64(0.0);
+    for (; i + 4 <= count; i += 4) {
+        sum0 = vfmaq_f64(sum0, vld1q_f64(p1 + i), vld1q_f64(p2 + i));
+        sum1 = vfmaq_f64(sum1, vld1q_f64(p1 + i + 2), vld1q_f64(p2 + i + 2));
+    }
+    result = vaddvq_f64(vaddq_f64(sum0, sum1));
+#endif
+
+    for (; i < count; i++)
+        result += p1[i] * p2[i];
+
+    return result;
+}
+
+/* p1 += factor * p2 */
+inline void matrix_axpy_kernel(float8 *p1, const float8 *p2, float8 factor, size_t count)
+{
+    size_t i = 0;
+
+#if defined(__x86_64__) && defined(__SSE2__)
+    __m128d f = _mm_set1_pd(factor);
+    for (; i + 4 <= count; i += 4) {
+        _mm_storeu_pd(p1 + i, _mm_add_pd(_mm_loadu_pd(p1 + i), _mm_mul_pd(f, _mm_loadu_pd(p2 + i))));
+        _mm_storeu_pd(p1 + i + 2, _mm_add_pd(_mm_loadu_pd(p1 + i + 2), _mm_mul_pd(f, _mm_loadu_pd(p2 + i + 2))));
+    }
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+    float64x2_t f = vdupq_n_f64(factor);
+    for (; i + 4 <= count; i += 4) {
+        vst1q_f64(p1 + i, vfmaq_f64(vld1q_f64(p1 + i), f, vld1q_f64(p2 + i)));
+        vst1q_f64(p1 + i + 2, vfmaq_f64(vld1q_f64(p1 + i + 2), f, vld1q_f64(p2 + i + 2)));
+    }
+#endif
+
+    for (; i < count; i++)
+        p1[i] += factor * p2[i];
+}
+
 inline int matrix_expected_size(int rows, int columns)
 {
     Assert(rows > 0);
@@ -395,28 +461,22 @@ inline void matrix_mult_vector(const Matrix *matrix, const Matrix *vector, Matri
     Assert(matrix->columns == vector->rows);
 
     if (matrix->transposed) {
+        // the data has not been physically transposed, so each column of the
+        // transposed matrix is contiguous: accumulate them scaled by the vector
+        const float8 *pm = matrix->data;
         float8 *pd = result->data;
-        // loop assumes that the data has not been physically transposed
-        for (int r = 0; r < matrix->rows; r++) {
-            const float8 *pm = matrix->data + r;
-            const float8 *pv = vector->data;
-            float8 x = 0.0;
-            for (int c = 0; c < matrix->columns; c++) {
-                x += *pm * *pv++;
-                pm += matrix->rows;
-            }
-            *pd++ = x;
+        for (int r = 0; r < matrix->rows; r++)
+            pd[r] = 0.0;
+        for (int c = 0; c < matrix->columns; c++) {
+            matrix_axpy_kernel(pd, pm, vector->data[c], matrix->rows);
+            pm += matrix->rows;
         }
     } else {
         const float8 *pm = matrix->data;
         float8 *pd = result->data;
         for (int r = 0; r < matrix->rows; r++) {
-            const float8 *pv = vector->data;
-            size_t count = matrix->columns;
-            float8 x = 0.0;
-            while (count-- > 0)
-                x += *pv++ * *pm++;
-            *pd++ = x;
+            *pd++ = matrix_dot_kernel(pm, vector->data, matrix->columns);
+            pm += matrix->columns;
         }
     }
 }
@@ -479,11 +539,7 @@ inline void matrix_mult_scalar_add(Matrix *m1, const Matrix *m2, const float8 fa
     Assert(!m2->transposed);
     Assert(m1->rows == m2->rows);
     Assert(m1->columns == m2->columns);
-    size_t count = m1->rows * m1->columns;
-    float8 *p1 = m1->data;
-    const float8 *p2 = m2->data;
-    while (count-- > 0)
-        *p1++ += factor * *p2++;
+    matrix_axpy_kernel(m1->data, m2->data, factor, m1->rows * m1->columns);
 }
 
 inline void matrix_subtract(Matrix *m1, const Matrix *m2)
@@ -511,14 +567,7 @@ inline float8 matrix_dot(const Matrix *v1, const Matrix *v2)
     Assert(v1->columns == 1);
     Assert(v2->columns == 1);
 
-    size_t count = v1->rows;
-    const float8 *p1 = v1->data;
-    const float8 *p2 = v2->data;
-    float8 result = 0;
-    while (count-- > 0)
-        result += *p1++ * *p2++;
-
-    return result;
+    return matrix_dot_kernel(v1->data, v2->data, v1->rows);
 }
 
 inline void matrix_square(Matrix *matrix)
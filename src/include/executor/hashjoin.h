@@ -180,6 +180,19 @@ typedef struct HashJoinTableData {
     int spreadNum;          /* auto spread times */
     int64* spill_size;
     uint64 spill_count;     /* times of spilling to disk */
+
+    /*
+     * Bit filter over the hash values of the tuples in the main buckets of
+     * the current batch, checked before a probe touches the bucket chain.
+     * NULL when the table is too small to need it or once it has proven
+     * not to reject enough probes (hashFilterEnabled is then false).
+     */
+    uint64* hashFilter;
+    Size hashFilterSize;      /* bytes in hashFilter, counted in spaceUsed */
+    int hashFilterShift;      /* turns a mixed hash value into a filter bit */
+    bool hashFilterEnabled;   /* false once the filter has been given up */
+    uint64 hashFilterProbes;  /* probes checked against the filter */
+    uint64 hashFilterRejects; /* probes answered by the filter alone */
 } HashJoinTableData;
 
 #endif /* HASHJOIN_H */
@@ -62,6 +62,7 @@ ExecHBucketInsertT(ModifyTableState* state, TupleTableSlot *slot,
     List** partition_list);
 
 extern void ExecCheckPlanOutput(Relation resultRel, List* targetList);
+extern void ExecCheckTIDVisible(Relation targetrel, EState* estate, Relation rel, ItemPointer tid);
 
 extern void ExecComputeStoredGenerated(ResultRelInfo *resultRelInfo, EState *estate, TupleTableSlot *slot,
     Tuple oldtuple, CmdType cmdtype);
@@ -194,6 +194,7 @@ extern void slot_getallattrsfast(TupleTableSlot *slot, int maxIdx);
 extern void heap_slot_getsomeattrs(TupleTableSlot* slot, int attnum);
 extern bool heap_slot_attisnull(TupleTableSlot* slot, int attnum);
 extern void heap_slot_formbatch(TupleTableSlot* slot, struct VectorBatch* batch, int cur_rows, int attnum);
+extern void heap_slots_formbatch(TupleTableSlot** slots, struct VectorBatch* batch, int rows, int natts);
 
 #endif /* !FRONTEND_PARSER */
 #endif /* TUPTABLE_H */
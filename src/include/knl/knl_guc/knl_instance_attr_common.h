@@ -60,6 +60,8 @@ typedef struct knl_instance_attr_common {
     int MaxDataNodes;
     int max_changes_in_memory;
     int max_cached_tuplebufs;
+    int thread_pool_steal_threshold;
+    int thread_pool_latency_weight;
 #ifdef USE_BONJOUR
     char* bonjour_name;
 #endif
@@ -100,6 +100,7 @@ typedef struct knl_instance_attr_storage {
     bool enableIncrementalCheckpoint;
     bool enable_double_write;
     bool enable_delta_store;
+    bool enable_huge_pages;
     bool enableWalLsnCheck;
     bool gucMostAvailableSync;
     bool enable_ustore;
@@ -138,6 +139,7 @@ typedef struct knl_instance_attr_storage {
     int real_recovery_parallelism;
     int batch_redo_num;
     int remote_read_mode;
+    int buffer_replacement_policy;
     int advance_xlog_file_num;
     int gtm_option;
     int max_undo_workers;
@@ -163,6 +165,9 @@ typedef struct knl_instance_attr_storage {
     char* xlog_lock_file_path;
     int wal_flush_timeout;
     int wal_flush_delay;
+    bool wal_flush_adaptive;
+    bool enable_redo_prefetch;
+    int wal_fpi_compression;
     int max_logical_replication_workers;
     char *redo_bind_cpu_attr;
     int max_active_gtt;
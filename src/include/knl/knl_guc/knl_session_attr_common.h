@@ -49,6 +49,7 @@ typedef struct knl_session_attr_common {
     bool Log_disconnections;
     bool ExitOnAnyError;
     bool omit_encoding_error;
+    bool session_latency_critical;
     bool log_parser_stats;
     bool log_planner_stats;
     bool log_executor_stats;
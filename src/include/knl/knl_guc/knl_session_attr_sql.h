@@ -72,6 +72,7 @@ typedef struct knl_session_attr_sql {
     bool enable_mergejoin;
     bool enable_hashjoin;
     bool enable_index_nestloop;
+    bool enable_memoize;
     bool under_explain;
     bool enable_nodegroup_debug;
     bool enable_partitionwise;
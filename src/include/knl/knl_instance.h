@@ -545,6 +545,7 @@ typedef struct knl_g_ckpt_context {
     volatile uint64 get_buf_num_clock_sweep;
     volatile uint64 nvm_get_buf_num_clock_sweep;
     volatile uint64 seg_get_buf_num_clock_sweep;
+    volatile uint64 get_buf_num_usage_spared; /* referenced buffers spared by the 2Q clock sweep */
 
     /* checkpoint view information */
     ckpt_view_struct ckpt_view;
@@ -907,6 +908,10 @@ typedef struct knl_g_undo_context {
     int64                    maxChainSize;
     uint32                   undo_chain_visited_count;
     uint32                   undoCountThreshold;
+    /* Net undo space growth in blocks per second, smoothed by the recycler. */
+    int64                    undoGrowthRate;
+    /* Seconds until undo reaches its force-recycle limit at that rate, -1 if not growing. */
+    int64                    undoExhaustSeconds;
     pg_atomic_uint64         globalFrozenXid;
     /* Oldest transaction id which is having undo. */
     pg_atomic_uint64         globalRecycleXid;
@@ -986,6 +991,10 @@ typedef struct knl_g_wal_context {
     DemoteMode upgradeSwitchMode;
     uint64 totalXlogIterBytes;
     uint64 totalXlogIterTimes;
+    /* moving averages driving the adaptive flush window, in microseconds */
+    uint64 flushLatencyAvg;
+    uint64 recordIntervalAvg;
+    TimestampTz lastBackgroundFlushTime;
     XlogFlushStatistics* xlogFlushStats;
 } knl_g_wal_context;
 
@@ -994,6 +994,14 @@ typedef struct knl_u_plancache_context {
      */
     void *explored_plan_info;
     HTAB *generic_roots;
+
+    /*
+     * candidate plan last picked by FindMatchedPlan and the selectivity
+     * region it was picked for; PortalDefineQuery hands the region to the
+     * portal running that plan.
+     */
+    void *matched_plan;
+    uint32 matched_region;
 } knl_u_plancache_context;
 
 typedef struct knl_u_typecache_context {
@@ -222,6 +222,9 @@ typedef struct RedoWorkerTimeCountsInfo {
     RedoTimeCost *time_cost;
 }RedoWorkerTimeCountsInfo;
 
+/* Number of entries in the per-thread xid status cache, must be a power of 2 */
+#define XID_STATUS_CACHE_SIZE 64
+
 typedef struct knl_t_xact_context {
     /* var in transam.cpp */
     typedef uint64 CommitSeqNo;
@@ -254,6 +257,18 @@ typedef struct knl_t_xact_context {
     CLogXidStatus cachedFetchXidStatus;
     XLogRecPtr cachedCommitLSN;
 
+    /*
+     * Behind the single-item cache, a small direct-mapped cache of final
+     * statuses, so that scans over tuples written by a handful of interleaved
+     * transactions do not keep going back to the shared CLOG buffers.
+     */
+    typedef struct XidStatusCacheEnt {
+        TransactionId xid;
+        CLogXidStatus status;
+        XLogRecPtr lsn;
+    } XidStatusCacheEnt;
+    XidStatusCacheEnt xidStatusCache[XID_STATUS_CACHE_SIZE];
+
     /* var in multixact.cpp*/
     struct mXactCacheEnt* MXactCache;
     MemoryContext MXactContext;
@@ -2430,6 +2445,12 @@ typedef struct knl_t_walsender_context {
     /* Read data from WAL into xlogReadBuf, then compress it to compressBuf */
     char *xlogReadBuf;
     char *compressBuf;
+    /*
+     * Messages to send uncompressed before compression is tried again, and the
+     * length of the next such window, see XLogCompression.
+     */
+    int compressSkip;
+    int compressBackoff;
 
     /* flag set in WalSndCheckTimeout */
     bool isWalSndSendTimeoutMessage;
@@ -2063,14 +2063,19 @@ typedef struct JoinState {
  *		NeedNewOuter	   true if need new outer tuple on next call
  *		MatchedOuter	   true if found a join match for current outer tuple
  *		NullInnerTupleSlot prepared null tuple for left outer joins
+ *		Cache			   cached inner scan results (enable_memoize)
  * ----------------
  */
+/* private in nodeNestloop.cpp: */
+typedef struct NestLoopCacheData* NestLoopCache;
+
 typedef struct NestLoopState {
     JoinState js; /* its first field is NodeTag */
     bool nl_NeedNewOuter;
     bool nl_MatchedOuter;
     bool nl_MaterialAll;
     TupleTableSlot* nl_NullInnerTupleSlot;
+    NestLoopCache nl_Cache; /* inner results by parameter value, or NULL */
 } NestLoopState;
 
 /* ----------------
@@ -2287,6 +2292,7 @@ typedef struct SortState {
     int spaceTypeId;      /* space type for explain */
     long spaceUsed;       /* space used for explain */
     int64* space_size;    /* spill size for temp table */
+    FmgrInfo* presortedEqfunctions; /* equality fns for presorted columns, or NULL */
 } SortState;
 
 /* ---------------------
@@ -2386,6 +2392,8 @@ typedef struct WindowAggState {
     struct WindowObjectData* agg_winobj; /* winobj for aggregate fetches */
     int64 aggregatedbase;                /* start row for current aggregates */
     int64 aggregatedupto;                /* rows before this one are aggregated */
+    bool agg_invertible;                 /* all aggregates can drop rows leaving the frame */
+    int agg_invptr;                      /* read pointer # for rows leaving the frame, or -1 */
 
     int frameOptions;       /* frame_clause options, see WindowDef */
     ExprState* startOffset; /* expression for starting bound offset */
@@ -1107,6 +1107,8 @@ typedef struct Sort {
     Oid* sortOperators;     /* OIDs of operators to sort them by */
     Oid* collations;        /* OIDs of collations */
     bool* nullsFirst;       /* NULLS FIRST/LAST directions */
+    int numPresorted;       /* leading sort columns the input is already
+                             * ordered on, see ExecSort */
 #ifdef PGXC
     bool srt_start_merge;  /* No need to create the sorted runs. The
                             * underlying plan provides those runs. Merge
@@ -1190,6 +1192,7 @@ typedef struct Agg {
     bool is_dummy;        /* just for coop analysis, if true, agg node does nothing */
     uint32 skew_optimize; /* skew optimize method for agg */
     bool   unique_check;  /* we will report an error when meet duplicate in unique check mode */
+    bool upper_combine;   /* lower stage of a two-phase agg: an upper Agg on the same groups combines our output */
 } Agg;
 
 /* ----------------
@@ -39,23 +39,37 @@ public:
 
     void InitGlobals();
 
-    void refreshParameterIfNecessary();
 private:
-
-    unsigned long ExecInsert(Relation rel, ResultRelInfo* resultRelInfo);
-
-    struct InsertFusionGlobalVariable {
+    /* how to compute the values of one inserted row */
+    struct InsertFusionRowTarget {
         /* for func/op expr calculation */
         FuncExprInfo* m_targetFuncNodes;
-        
+
         int m_targetFuncNum;
-        
+
+        ParamLoc* m_paramLoc; /* location of params, include paramId and the column it fills */
+
         int m_targetParamNum;
 
         int m_targetConstNum;
 
         ConstLoc* m_targetConstLoc;
     };
+
+    void InitRowTarget(InsertFusionRowTarget* row, List* targetList);
+
+    void refreshParameterIfNecessary(const InsertFusionRowTarget* row);
+
+    unsigned long ExecInsert(Relation rel, ResultRelInfo* resultRelInfo);
+
+    struct InsertFusionGlobalVariable {
+        /* one entry for a single row insert, or one for each row of a VALUES list */
+        InsertFusionRowTarget* m_rowTargets;
+
+        int m_rowNum;
+
+        bool m_upsertNothing; /* DUPLICATE KEY UPDATE NOTHING, skip rows that conflict */
+    };
     InsertFusionGlobalVariable* m_c_global;
 
     struct InsertFusionLocaleVariable {
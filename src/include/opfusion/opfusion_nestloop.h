@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * ---------------------------------------------------------------------------------------
+ *
+ * opfusion_nestloop.h
+ *        Declaration of nestloop index join operator for bypass executor.
+ *
+ * IDENTIFICATION
+ *        src/include/opfusion/opfusion_nestloop.h
+ *
+ * ---------------------------------------------------------------------------------------
+ */
+
+#ifndef SRC_INCLUDE_OPFUSION_OPFUSION_NESTLOOP_H_
+#define SRC_INCLUDE_OPFUSION_OPFUSION_NESTLOOP_H_
+
+#include "opfusion/opfusion.h"
+#include "opfusion/opfusion_indexscan.h"
+
+class NestLoopIndexFusion : public OpFusion {
+public:
+    NestLoopIndexFusion(MemoryContext context, CachedPlanSource* psrc, List* plantree_list, ParamListInfo params);
+
+    ~NestLoopIndexFusion(){};
+
+    bool execute(long max_rows, char* completionTag);
+
+    void InitLocals(ParamListInfo params);
+
+    void InitGlobals();
+
+private:
+    /* inner scan key filled from an outer column for each outer row */
+    struct NestParamLoc {
+        AttrNumber outerAttno;
+        int scanKeyIndx;
+    };
+
+    struct NestLoopFusionGlobalVariable {
+        NestParamLoc* m_nestParamLoc;
+        int m_nestParamNum;
+        bool* m_fromInner; /* output column comes from inner side, length is m_tupDesc->natts */
+    };
+
+    NestLoopFusionGlobalVariable* m_c_global;
+
+    struct NestLoopFusionLocaleVariable {
+        IndexScanFusion* m_inner; /* outer side is m_local.m_scan */
+    };
+
+    NestLoopFusionLocaleVariable m_c_local;
+};
+
+#endif /* SRC_INCLUDE_OPFUSION_OPFUSION_NESTLOOP_H_ */
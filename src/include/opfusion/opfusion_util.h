@@ -52,6 +52,7 @@ enum FusionType {
     DELETE_FUSION,
     AGG_INDEX_FUSION,
     SORT_INDEX_FUSION,
+    NESTLOOP_INDEX_FUSION,
 
     MOT_JIT_SELECT_FUSION,
     MOT_JIT_MODIFY_FUSION,
@@ -104,6 +105,8 @@ enum FusionType {
 
     NOBYPASS_JUST_VAR_ALLOWED_IN_SORT,
 
+    NOBYPASS_NESTLOOP_NOT_INDEX_JOIN,
+
     NOBYPASS_ZERO_PARTITION,
     NOBYPASS_MULTI_PARTITION,
     NOBYPASS_EXP_NOT_SUPPORT_IN_PARTITION,
@@ -257,6 +260,7 @@ FusionType getInsertFusionType(List *stmt_list, ParamListInfo params);
 FusionType getUpdateFusionType(List *stmt_list, ParamListInfo params);
 FusionType getDeleteFusionType(List *stmt_list, ParamListInfo params);
 void tpslot_free_heaptuple(TupleTableSlot *reslot);
+List *GetValuesRowTargetList(List *targetList, ValuesScan *scan, List *row);
 void InitPartitionByScanFusion(Relation rel, Relation *fakRel, Partition *part, EState *estate, const ScanFusion *scan);
 Relation InitBucketRelation(int2 bucketid, Relation rel, Partition part);
 void ExecDoneStepInFusion(EState *estate);
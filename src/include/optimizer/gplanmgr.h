@@ -116,6 +116,7 @@ extern bool ChooseAdaptivePlan(CachedPlanSource *plansource, ParamListInfo bound
 extern CachedPlan *GetCustomPlan(CachedPlanSource *plansource, ParamListInfo boundParams, List **qlist);
 extern PlanManager *PMGR_CreatePlanManager(MemoryContext parent_cxt, char* stmt_name, GplanSelectionMethod method);
 void PMGR_ReleasePlanManager(CachedPlanSource *plansource);
+extern void PMGR_RecordPlanExecution(CachedPlan *plan, uint32 region, uint64 exec_usecs);
 CachedPlan *GetAdaptGenericPlan(CachedPlanSource *plansource,
                                         ParamListInfo boundParams,
                                         List **qlist);
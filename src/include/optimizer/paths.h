@@ -167,6 +167,7 @@ extern void construct_pathkeys(PlannerInfo *root, List *tlist, List *activeWindo
                    List *groupClause, bool canonical);
 extern PathKeysComparison compare_pathkeys(List* keys1, List* keys2);
 extern bool pathkeys_contained_in(List* keys1, List* keys2);
+extern int pathkeys_common_prefix(List* keys1, List* keys2);
 extern Path* get_cheapest_path_for_pathkeys(
     List* paths, List* pathkeys, Relids required_outer, CostSelector cost_criterion);
 extern Path* get_cheapest_fractional_path_for_pathkeys(
@@ -30,6 +30,7 @@
 #include "storage/buf/buf_internals.h"
 #include "storage/smgr/relfilenode.h"
 #include "storage/smgr/smgr.h"
+#include "portability/instr_time.h"
 #include <libaio.h>
 
 /*
@@ -92,6 +93,22 @@ typedef struct AioDispatchCUDesc {
     AioCUDesc_t cuDesc;
 } AioDispatchCUDesc_t;
 
+/*
+ * Submit time of an AIO request in microseconds. It travels in the otherwise
+ * unused iocb data field, which the kernel hands back in io_event.data, so the
+ * completer can account the request latency before the callback frees the
+ * dispatch descriptor.
+ */
+static inline uint64 AioRequestClock(void)
+{
+    instr_time now;
+
+    INSTR_TIME_SET_CURRENT(now);
+    return (uint64)INSTR_TIME_GET_MICROSEC(now);
+}
+
+#define AioStampSubmitTime(iocbp) ((iocbp)->data = (void*)(uintptr_t)AioRequestClock())
+
 /* GUC options */
 extern int AioCompltrSets;
 extern int AioCompltrEvents;
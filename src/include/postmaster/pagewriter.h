@@ -30,6 +30,8 @@
 
 #define ENABLE_INCRE_CKPT g_instance.attr.attr_storage.enableIncrementalCheckpoint
 #define NEED_CONSIDER_USECOUNT u_sess->attr.attr_storage.enable_candidate_buf_usage_count
+/* candidate scans age usage counts either on demand or under the 2Q replacement policy */
+#define CANDIDATE_CONSIDER_USECOUNT (NEED_CONSIDER_USECOUNT || ENABLE_BUFFER_POLICY_2Q)
 
 #define INIT_CANDIDATE_LIST(L, list, size, xx_head, xx_tail) \
     ((L).cand_buf_list = (list), \
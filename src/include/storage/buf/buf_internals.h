@@ -253,6 +253,22 @@ typedef union BufferDescPadded {
         &t_thrd.storage_cxt.BufferDescriptors[(buffer)-1].bufferdesc)
 
 #define BufferDescriptorGetContentLock(bdesc) (((bdesc)->content_lock))
+
+/*
+ * NUMA-aware buffer pool. When the instance runs with numa_distribute_mode = 'all', the normal
+ * shared buffers are split into one contiguous partition per NUMA node. Each partition has its
+ * own clock hand and is preferably served by the pagewriter sub threads whose candidate lists
+ * fall inside it, so that backends allocate node-local buffers first and only steal from remote
+ * partitions under pressure.
+ */
+#define MAX_BUFFER_NUMA_NODES 8
+#define BUFFER_NUMA_NODE_NUM (Min(g_instance.shmem_cxt.numaNodeNum, MAX_BUFFER_NUMA_NODES))
+#define ENABLE_BUFFER_NUMA_PARTITION (BUFFER_NUMA_NODE_NUM > 1)
+#define BufferNumaPartitionStart(node) \
+    ((int)(((int64)NORMAL_SHARED_BUFFER_NUM * (node) + BUFFER_NUMA_NODE_NUM - 1) / BUFFER_NUMA_NODE_NUM))
+#define BufferNumaPartitionSize(node) (BufferNumaPartitionStart((node) + 1) - BufferNumaPartitionStart(node))
+#define BufferIdGetNumaNode(id) \
+    ((int)(((int64)(id) * BUFFER_NUMA_NODE_NUM) / NORMAL_SHARED_BUFFER_NUM))
 /*
  * Functions for acquiring/releasing a shared buffer header's spinlock.  Do
  * not apply these to local buffers!
@@ -60,6 +60,23 @@ typedef enum BufferAccessStrategyType {
     BAS_REPAIR      /* repair file */
 } BufferAccessStrategyType;
 
+/*
+ * Possible values of buffer_replacement_policy.
+ *
+ * BUFFER_POLICY_2Q approximates 2Q on top of the clock sweep: a newly read
+ * page enters the pool on probation (usage count 0) and is only promoted to
+ * the hot set when it is referenced again, while the clock sweep and the
+ * pagewriter candidate scan spare referenced buffers by ageing their usage
+ * count. Pages touched once by large scans are thus evicted before the hot set.
+ */
+typedef enum BufferReplacementPolicy {
+    BUFFER_POLICY_CLOCK, /* plain clock sweep, usage count ignored */
+    BUFFER_POLICY_2Q     /* probationary insertion with usage aware sweep */
+} BufferReplacementPolicy;
+
+#define ENABLE_BUFFER_POLICY_2Q (g_instance.attr.attr_storage.buffer_replacement_policy == BUFFER_POLICY_2Q)
+#define BUFFER_INITIAL_USAGECOUNT (ENABLE_BUFFER_POLICY_2Q ? 0 : BUF_USAGECOUNT_ONE)
+
 /* Possible modes for ReadBufferExtended() */
 typedef enum {
     RBM_NORMAL,                /* Normal read */
@@ -263,6 +280,8 @@ void shared_buffer_write_error_callback(void *arg);
  * prototypes for functions in bufmgr.c
  */
 extern void PrefetchBuffer(Relation reln, ForkNumber forkNum, BlockNumber blockNum);
+extern void PrefetchBufferRange(Relation reln, ForkNumber forkNum, BlockNumber startBlock, BlockNumber nblocks);
+extern void PrefetchSharedBuffer(struct SMgrRelationData* smgr, ForkNumber forkNum, BlockNumber blockNum);
 extern void PageRangePrefetch(
     Relation reln, ForkNumber forkNum, BlockNumber blockNum, int32 n, uint32 flags, uint32 col);
 extern void PageListPrefetch(
@@ -67,6 +67,7 @@ struct compression_options {
     /* common flags */
     bool m_adopt_dict; /* Dictionary encoding */
     bool m_adopt_rle;  /* RLE encoding */
+    bool m_adopt_zlib; /* zlib instead of lz4 for middle compression */
 
     void reset(void);
     void set_numeric_flags(uint16 modes);
@@ -138,7 +139,9 @@ public:
     virtual ~StringCoder()
     {}
 
-    StringCoder() : m_adopt_rle(true), m_adopt_dict(true), m_dicCodes(NULL), m_dicCodesNum(0)
+    StringCoder()
+        : m_adopt_rle(true), m_adopt_dict(true), m_adopt_zlib(false), m_sampling(false), m_dicCodes(NULL),
+          m_dicCodesNum(0)
     {}
 
     int Compress(_in_ CompressionArg1& in, _in_ CompressionArg2& out);
@@ -147,6 +150,9 @@ public:
     /* optimizing flags */
     bool m_adopt_rle;
     bool m_adopt_dict;
+    bool m_adopt_zlib;
+    /* sampling CU, try both lz4 and zlib for middle compression */
+    bool m_sampling;
 
 private:
     /* inner implement for compress api */
@@ -157,6 +163,8 @@ private:
     //
     int CompressWithoutDict(_in_ char* inBuf, _in_ int inBufSize, _in_ int compressing_modes, _out_ char* outBuf,
         _in_ int outBufSize, _out_ int& mode);
+    int CompressWithoutDictInner(_in_ char* inBuf, _in_ int inBufSize, _in_ int8 compression, _in_ int8 compresslevel,
+        _out_ char* outBuf, _in_ int outBufSize, _out_ int& mode);
     int DecompressWithoutDict(
         _in_ char* inBuf, _in_ int inBufSize, _in_ uint16 mode, _out_ char* outBuf, _out_ int outBufSize);
 
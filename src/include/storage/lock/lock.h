@@ -569,6 +569,12 @@ typedef enum {
 #define FAST_PATH_CHECK_LOCKMODE(proc, n, l) \
     ((proc)->fpLockBits[n / FP_LOCK_SLOTS_PER_LOCKBIT] & \
     (UINT64CONST(UINT64CONST(1) << FAST_PATH_BIT_POSITION((n % FP_LOCK_SLOTS_PER_LOCKBIT), l))))
+/*
+ * True if slot n is the first of a lockbit word whose slots are all unused,
+ * so that slot scans can step over the whole word at once.
+ */
+#define FAST_PATH_LOCKBIT_IS_EMPTY(proc, n) \
+    ((n) % FP_LOCK_SLOTS_PER_LOCKBIT == 0 && (proc)->fpLockBits[(n) / FP_LOCK_SLOTS_PER_LOCKBIT] == 0)
 
 #define PRINT_WAIT_LENTH (8 + 1)
 #define CHECK_LOCKMETHODID(lockMethodId)                                             \
@@ -157,6 +157,7 @@ extern void smgrdounlinkfork(SMgrRelation reln, ForkNumber forknum, bool isRedo)
 extern void smgrextend(SMgrRelation reln, ForkNumber forknum, BlockNumber blocknum,
                        char* buffer, bool skipFsync);
 extern void smgrprefetch(SMgrRelation reln, ForkNumber forknum, BlockNumber blocknum);
+extern void smgrprefetchrange(SMgrRelation reln, ForkNumber forknum, BlockNumber blocknum, BlockNumber nblocks);
 extern SMGR_READ_STATUS smgrread(SMgrRelation reln, ForkNumber forknum, BlockNumber blocknum, char* buffer);
 extern void smgrwrite(SMgrRelation reln, ForkNumber forknum, BlockNumber blocknum, const char* buffer, bool skipFsync);
 extern void smgrwriteback(SMgrRelation reln, ForkNumber forknum, BlockNumber blocknum, BlockNumber nblocks);
@@ -185,6 +186,7 @@ extern bool mdexists(SMgrRelation reln, ForkNumber forknum, BlockNumber blocknum
 extern void mdunlink(const RelFileNodeBackend& rnode, ForkNumber forknum, bool isRedo, BlockNumber blocknum);
 extern void mdextend(SMgrRelation reln, ForkNumber forknum, BlockNumber blocknum, char* buffer, bool skipFsync);
 extern void mdprefetch(SMgrRelation reln, ForkNumber forknum, BlockNumber blocknum);
+extern void mdprefetchrange(SMgrRelation reln, ForkNumber forknum, BlockNumber blocknum, BlockNumber nblocks);
 extern SMGR_READ_STATUS mdread(SMgrRelation reln, ForkNumber forknum, BlockNumber blocknum, char* buffer);
 extern void mdwrite(SMgrRelation reln, ForkNumber forknum, BlockNumber blocknum, const char* buffer, bool skipFsync);
 extern void mdwriteback(SMgrRelation reln, ForkNumber forknum, BlockNumber blocknum, BlockNumber nblocks);
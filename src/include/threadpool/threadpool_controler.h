@@ -102,6 +102,11 @@ public:
         return m_groupNum;
     }
 
+    inline ThreadPoolGroup* GetGroup(int idx)
+    {
+        return m_groups[idx];
+    }
+
     inline MemoryContext GetMemCxt()
     {
         return m_threadPoolContext;
@@ -170,6 +170,9 @@ private:
 
     instr_time m_current_time;
     uint64 m_sessionId;
+    /* same for the head of the listener's latency-critical session list */
+    instr_time m_criticalTime;
+    uint64 m_criticalSessionId;
 };
 
 #endif /* THREAD_POOL_GROUP_H */
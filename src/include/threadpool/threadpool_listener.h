@@ -31,6 +31,19 @@
 #include "lib/dllist.h"
 #include "knl/knl_variable.h"
 
+/*
+ * Sessions waiting for a worker are queued by latency class, see
+ * session_latency_critical.  Their queue waits are counted in buckets of
+ * below 1ms, 10ms, 100ms, 1s and the rest.
+ */
+typedef enum {
+    TP_LATENCY_NORMAL = 0,
+    TP_LATENCY_CRITICAL,
+    TP_LATENCY_CLASS_NUM
+} ThreadPoolLatencyClass;
+
+#define TP_QUEUE_WAIT_BUCKETS 5
+
 class ThreadPoolListener : public BaseObject {
 public:
     ThreadPoolGroup* m_group;
@@ -51,7 +64,8 @@ public:
     void SendShutDown();
     void ReaperAllSession();
     void ShutDown() const;
-    bool GetSessIshang(instr_time* current_time, uint64* sessionId);
+    bool GetSessIshang(instr_time* current_time, uint64* sessionId, instr_time* criticalTime, uint64* criticalId);
+    void GetQueueWaitStat(char* buf, int len);
 
     inline ThreadPoolGroup* GetGroup()
     {
@@ -73,6 +87,10 @@ private:
     void DispatchSession(knl_session_context* session);
     Dlelem *GetReadySession(ThreadPoolWorker* worker);
     Dlelem *GetSessFromReadySessionList(ThreadPoolWorker *worker);
+    bool TryStealSession(ThreadPoolWorker* worker);
+    Dlelem *GetCriticalSession(bool force);
+    static bool ListHeadIsStuck(DllistWithLock* list, instr_time* current_time, uint64* sessionId);
+    void CountQueueWait(Dlelem *elt, ThreadPoolLatencyClass latencyClass);
     void AddIdleSessionToTail(knl_session_context* session);
     void AddIdleSessionToHead(knl_session_context* session);
 
@@ -85,6 +103,11 @@ private:
     DllistWithLock* m_readySessionList;
     DllistWithLock* m_idleSessionList;
 
+    /* latency-critical ready sessions, served ahead of m_readySessionList */
+    DllistWithLock* m_criticalSessionList;
+    volatile uint32 m_criticalServed;
+    pg_atomic_uint64 m_queueWait[TP_LATENCY_CLASS_NUM][TP_QUEUE_WAIT_BUCKETS];
+
     // split session by dbid, put them into hashtable as a sessionlist
     // key is dbid, and value is a sessionlist, who has same elements as m_readySessionList
     int m_session_nbucket;
@@ -77,6 +77,7 @@ typedef enum {
 } ThreadStayReason;
 
 class ThreadPoolGroup;
+class ThreadPoolListener;
 class ThreadPoolWorker : public BaseObject {
 public:
     ThreadPoolWorker(uint idx, ThreadPoolGroup* group, pthread_mutex_t* mutex, pthread_cond_t* m_cond);
@@ -103,9 +104,10 @@ public:
         return m_tid;
     }
 
-    inline void SetSession(knl_session_context* session)
+    inline void SetSession(knl_session_context* session, ThreadPoolListener* listener = NULL)
     {
         m_currentSession = session;
+        m_sessionListener = listener;
     }
     const inline knl_thrd_context *GetThreadContextPtr()
     {
@@ -138,6 +140,7 @@ private:
     void RestoreThreadVariable();
     void RestoreLocaleInfo();
     void SetSessionInfo();
+    ThreadPoolListener* GetSessionListener();
 
 private:
     ThreadId m_tid;
@@ -147,6 +150,7 @@ private:
     ThreadStayReason m_reason;
     Dlelem m_elem;
     ThreadPoolGroup* m_group;
+    ThreadPoolListener* m_sessionListener;
     pthread_mutex_t* m_mutex;
     pthread_cond_t* m_cond;
     knl_thrd_context *m_thrd;
@@ -219,6 +219,8 @@ public:
 
     void SortInMem();
 
+    bool RadixSortInMem();
+
     int GetSortMergeOrder();
 
     void InitTapes();
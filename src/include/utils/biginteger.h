@@ -259,6 +259,46 @@ extern const biopfun BiFunMatrix[11][2][2];
  */
 extern const biopfun BiAggFunMatrix[3][2][2];
 
+/*
+ * @Description: Fast path of BiAggFunMatrix[BI_AGG_ADD] for sum/avg over a
+ *               fixed-scale numeric column: the bi64 argument has the same
+ *               scale as the bi64/bi128 transition value, so the sum is
+ *               added in place without any scale adjustment or call.
+ * @IN state: transition value, updated in place on success.
+ * @IN arg: value to add.
+ * @return: false if the caller must fall back to BiAggFunMatrix, which
+ *          also covers the overflow cases.
+ */
+inline bool BiAggAddSameScale(Numeric state, Numeric arg)
+{
+    uint16 stateFlags = NUMERIC_NB_FLAGBITS(state);
+
+    if (!NUMERIC_IS_BI64(arg) || NUMERIC_BI_SCALE(state) != NUMERIC_BI_SCALE(arg)) {
+        return false;
+    }
+
+    if (NUMERIC_FLAG_IS_BI64(stateFlags)) {
+        int64 result;
+        if (unlikely(__builtin_add_overflow(NUMERIC_64VALUE(state), NUMERIC_64VALUE(arg), &result))) {
+            return false;
+        }
+        NUMERIC_64VALUE(state) = result;
+        return true;
+    } else if (NUMERIC_FLAG_IS_BI128(stateFlags)) {
+        int128 result;
+        errno_t rc = memcpy_s(&result, sizeof(int128), state->choice.n_bi.n_data, sizeof(int128));
+        securec_check(rc, "\0", "\0");
+        if (unlikely(__builtin_add_overflow(result, (int128)NUMERIC_64VALUE(arg), &result))) {
+            return false;
+        }
+        rc = memcpy_s(state->choice.n_bi.n_data, sizeof(int128), &result, sizeof(int128));
+        securec_check(rc, "\0", "\0");
+        return true;
+    }
+
+    return false;
+}
+
 /* convert big integer data to numeric */
 extern Numeric bitonumeric(Datum arg);
 /* convert int(int1/int2/int4/int8) to big integer type */
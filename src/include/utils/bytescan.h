@@ -0,0 +1,133 @@
+/* ---------------------------------------------------------------------------------------
+ *
+ * bytescan.h
+ *        Find the next interesting byte of a buffer, 16 bytes at a time.
+ *
+ * Line splitters of the COPY and bulkload parsers only care about a handful
+ * of structural characters: newlines, quotes, escapes and the like.  Instead of
+ * looking at every byte of the input, they can ask for the length of the
+ * run of ordinary bytes ahead and jump over it.  The JSON lexer does the
+ * same over the body of string tokens.  SSE2 (always there on x86-64) and
+ * NEON are used where available, with a plain loop for the remainder and
+ * for other platforms.  Also used by the standalone GDS
+ * build, so this file must not depend on anything beyond c.h.
+ *
+ * IDENTIFICATION
+ *        src/include/utils/bytescan.h
+ *
+ * ---------------------------------------------------------------------------------------
+ */
+#ifndef BYTESCAN_H
+#define BYTESCAN_H
+
+#if defined(__amd64) || defined(__x86_64__)
+#include <emmintrin.h>
+#define BYTESCAN_USE_SSE2
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#define BYTESCAN_USE_NEON
+#endif
+
+#define BYTESCAN_MAX_CHARS 6
+
+typedef struct ByteScanSet {
+    unsigned char chars[BYTESCAN_MAX_CHARS]; /* bytes that stop the scan, unused slots repeat chars[0] */
+    bool highbit;                            /* do bytes with the high bit set stop it too? */
+    bool control;                            /* do control characters (below 0x20) stop it too? */
+} ByteScanSet;
+
+/* nchars must be between 1 and BYTESCAN_MAX_CHARS */
+static inline void ByteScanSetInit(
+    ByteScanSet* set, const char* chars, int nchars, bool highbit, bool control = false)
+{
+    for (int i = 0; i < BYTESCAN_MAX_CHARS; i++) {
+        set->chars[i] = (unsigned char)chars[(i < nchars) ? i : 0];
+    }
+    set->highbit = highbit;
+    set->control = control;
+}
+
+static inline bool ByteScanIsStop(const ByteScanSet* set, unsigned char c)
+{
+    if (set->highbit && (c & 0x80)) {
+        return true;
+    }
+    if (set->control && c < 0x20) {
+        return true;
+    }
+    for (int i = 0; i < BYTESCAN_MAX_CHARS; i++) {
+        if (c == set->chars[i]) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/*
+ * Return the offset of the first byte of buf[0 .. len) that is in the set,
+ * or len if there is none.
+ */
+static inline int ByteScanPlain(const ByteScanSet* set, const char* buf, int len)
+{
+    int i = 0;
+
+#if defined(BYTESCAN_USE_SSE2)
+    const __m128i c0 = _mm_set1_epi8((char)set->chars[0]);
+    const __m128i c1 = _mm_set1_epi8((char)set->chars[1]);
+    const __m128i c2 = _mm_set1_epi8((char)set->chars[2]);
+    const __m128i c3 = _mm_set1_epi8((char)set->chars[3]);
+    const __m128i c4 = _mm_set1_epi8((char)set->chars[4]);
+    const __m128i c5 = _mm_set1_epi8((char)set->chars[5]);
+    const __m128i ctrl = _mm_set1_epi8(0x1F);
+
+    for (; i + 16 <= len; i += 16) {
+        __m128i v = _mm_loadu_si128((const __m128i*)(buf + i));
+        __m128i m = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, c0), _mm_cmpeq_epi8(v, c1)),
+            _mm_or_si128(_mm_cmpeq_epi8(v, c2), _mm_cmpeq_epi8(v, c3)));
+        m = _mm_or_si128(m, _mm_or_si128(_mm_cmpeq_epi8(v, c4), _mm_cmpeq_epi8(v, c5)));
+        if (set->control) {
+            /* unsigned v <= 0x1F */
+            m = _mm_or_si128(m, _mm_cmpeq_epi8(_mm_min_epu8(v, ctrl), v));
+        }
+
+        unsigned int mask = (unsigned int)_mm_movemask_epi8(m);
+        if (set->highbit) {
+            mask |= (unsigned int)_mm_movemask_epi8(v);
+        }
+        if (mask != 0) {
+            return i + __builtin_ctz(mask);
+        }
+    }
+#elif defined(BYTESCAN_USE_NEON)
+    const uint8x16_t c0 = vdupq_n_u8(set->chars[0]);
+    const uint8x16_t c1 = vdupq_n_u8(set->chars[1]);
+    const uint8x16_t c2 = vdupq_n_u8(set->chars[2]);
+    const uint8x16_t c3 = vdupq_n_u8(set->chars[3]);
+    const uint8x16_t c4 = vdupq_n_u8(set->chars[4]);
+    const uint8x16_t c5 = vdupq_n_u8(set->chars[5]);
+    const uint8x16_t high = vdupq_n_u8(set->highbit ? 0x80 : 0);
+    const uint8x16_t ctrl = vdupq_n_u8(set->control ? 0xFF : 0);
+
+    for (; i + 16 <= len; i += 16) {
+        uint8x16_t v = vld1q_u8((const uint8_t*)(buf + i));
+        uint8x16_t m = vorrq_u8(vorrq_u8(vceqq_u8(v, c0), vceqq_u8(v, c1)), vorrq_u8(vceqq_u8(v, c2), vceqq_u8(v, c3)));
+        m = vorrq_u8(m, vorrq_u8(vceqq_u8(v, c4), vceqq_u8(v, c5)));
+        m = vorrq_u8(m, vandq_u8(v, high));
+        m = vorrq_u8(m, vandq_u8(vcltq_u8(v, vdupq_n_u8(0x20)), ctrl));
+
+        /* the exact position is found by the loop below */
+        if (vmaxvq_u8(m) != 0) {
+            break;
+        }
+    }
+#endif
+
+    for (; i < len; i++) {
+        if (ByteScanIsStop(set, (unsigned char)buf[i])) {
+            return i;
+        }
+    }
+    return len;
+}
+
+#endif /* BYTESCAN_H */
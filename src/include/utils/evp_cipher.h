@@ -44,5 +44,10 @@ bool encrypt_partial_mode(const char* plainText, const size_t plainLength, char*
     size_t* cipherLength, unsigned char* key, unsigned char* iv, TdeAlgo algo);
 bool decrypt_partial_mode(const char* cipherText, const size_t cipherLength, char* plainText,
     size_t* plainLength, unsigned char* key, unsigned char* iv, TdeAlgo algo);
+/* TDE page path, reuses a per-thread cipher context keyed with the data key */
+bool encrypt_page_partial_mode(const char* plainText, const size_t plainLength, char* cipherText,
+    size_t* cipherLength, unsigned char* key, unsigned char* iv, TdeAlgo algo);
+bool decrypt_page_partial_mode(const char* cipherText, const size_t cipherLength, char* plainText,
+    size_t* plainLength, unsigned char* key, unsigned char* iv, TdeAlgo algo);
 
 #endif /* EVP_CIPHER_H */
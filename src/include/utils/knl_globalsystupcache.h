@@ -454,4 +454,6 @@ private:
     volatile uint64 *m_newloads;
 };
 
+extern void FlushGlobalSysTupCacheStat();
+
 #endif
\ No newline at end of file
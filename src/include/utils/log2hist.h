@@ -0,0 +1,34 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * ---------------------------------------------------------------------------------------
+ *
+ * log2hist.h
+ *        power-of-two bucketed histograms for background thread statistics
+ *
+ * IDENTIFICATION
+ *        src/include/utils/log2hist.h
+ *
+ * ---------------------------------------------------------------------------------------
+ */
+
+#ifndef LOG2HIST_H
+#define LOG2HIST_H
+
+/* Bucket i counts values below 2^i, the last bucket everything above. */
+#define LOG2HIST_MAX_BUCKETS 64
+
+extern void Log2HistAdd(uint64* hist, int nbuckets, uint64 value);
+extern void Log2HistReport(int elevel, const uint64* hist, int nbuckets, const char* prefix);
+
+#endif /* LOG2HIST_H */
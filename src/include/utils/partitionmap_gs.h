@@ -91,6 +91,11 @@ typedef struct ListPartElement {
     Const** boundary;                      /* list values */
 } ListPartElement;
 
+typedef struct ListPartValue {
+    Const* value; /* points into the boundary of listElements[partSeq] */
+    int partSeq;  /* index of the list element holding the value */
+} ListPartValue;
+
 typedef struct HashPartElement {
     Oid partitionOid;                     /* the oid of partition */
     Const* boundary[1];                   /* hash bucket */
@@ -127,6 +132,10 @@ typedef struct ListPartitionMap {
     /* section 1: list partition specific */
     int listElementsNum;          /* the number of list partition */
     ListPartElement* listElements;   /* array of listElement */
+    /* section 2: values of all list elements in ascending order, for binary search routing */
+    int sortedValuesNum;
+    ListPartValue* sortedValues;  /* NULL if not built, routing then scans listElements */
+    int defaultPartSeq;           /* index of the default partition, -1 if none */
 } ListPartitionMap;
 
 typedef struct HashPartitionMap {
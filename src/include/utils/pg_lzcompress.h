@@ -126,5 +126,6 @@ extern const PGLZ_Strategy* const PGLZ_strategy_always;
  */
 extern bool pglz_compress(const char* source, int32 slen, PGLZ_Header* dest, const PGLZ_Strategy* strategy);
 extern int32 pglz_decompress(const PGLZ_Header* source, char* dest);
+extern int32 pglz_decompress_prefix(const PGLZ_Header* source, char* dest, int32 rawsize);
 
 #endif /* _PG_LZCOMPRESS_H_ */
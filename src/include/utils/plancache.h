@@ -455,6 +455,19 @@ typedef struct CachedPlan {
     bool is_candidate;
 } CachedPlan;
 
+/*
+ * Execution statistics of a candidate plan for one selectivity region, i.e.
+ * for queries whose base-rel selectivities fall into the same log2 buckets.
+ * Slots are direct-mapped by region key; a new region takes over its slot.
+ */
+#define PMGR_REGION_SLOTS 8
+
+typedef struct PlanRegionStats {
+    volatile uint32 region;     /* region key, 0 if the slot is unused */
+    volatile uint64 exec_costs; /* unit: microsecond */
+    volatile uint32 times;
+} PlanRegionStats;
+
 typedef struct CachedPlanInfo {
     NodeTag type;
     List *relCis;      /* list of relCI(s)*/
@@ -466,6 +479,7 @@ typedef struct CachedPlanInfo {
     volatile uint32 verification_times;
     volatile uint64 sample_exec_costs;
     volatile uint32 sample_times;
+    PlanRegionStats regionStats[PMGR_REGION_SLOTS];
     AdaptCachedPlanStat status;
     bool usePartIdx;
 } CachedPlanInfo;
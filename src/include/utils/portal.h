@@ -253,6 +253,8 @@ typedef struct PortalData {
     bool isPkgCur; /* cursor variable is a package variable? */
 #endif
     int nextval_default_expr_type; /* nextval does not support lightproxy and sqlbypass */
+    uint64 exec_usecs;             /* time spent in PortalRun, fed back to adaptive plan selection */
+    uint32 plan_region;            /* selectivity region cplan was matched for, 0 if none */
 } PortalData;
 
 /*
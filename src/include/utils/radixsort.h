@@ -0,0 +1,137 @@
+/* ---------------------------------------------------------------------------------------
+ *
+ * radixsort.h
+ *        In-memory radix sort on an integer leading sort key.
+ *
+ * When the leading sort key is a fixed-width integer type (int4, int8, date,
+ * integer timestamps), its value can be turned into an unsigned 64-bit key
+ * whose unsigned order is the sort order, and the array can then be
+ * distributed byte by byte instead of being sorted through comparator
+ * calls.  We use an in-place MSD radix sort ("American flag sort"), so no
+ * second array of sort elements is needed.  Buckets that get small are
+ * finished by the caller's comparison sort, and runs whose keys are equal
+ * are handed back so that the caller can order them on the remaining sort
+ * columns.
+ *
+ * IDENTIFICATION
+ *        src/include/utils/radixsort.h
+ *
+ * ---------------------------------------------------------------------------------------
+ */
+#ifndef RADIXSORT_H
+#define RADIXSORT_H
+
+#include "miscadmin.h"
+
+/* Below this many elements the counting passes cost more than quicksort */
+#define RADIX_SORT_MIN_ELEMS 1024
+
+/* Buckets no bigger than this are finished by the fallback sort */
+#define RADIX_SORT_SMALL_BUCKET 64
+
+#define RADIX_SORT_BUCKETS 256
+
+/*
+ * Normalize a signed integer so that comparing the results as unsigned
+ * values gives the requested sort order.  32-bit values are placed in the
+ * high-order half, so that both widths are consumed from the top byte down.
+ */
+static inline uint64 RadixSortNormalizeInt32(int32 value, bool reverse)
+{
+    uint64 key = ((uint64)((uint32)value ^ 0x80000000U)) << 32;
+
+    return reverse ? ~key : key;
+}
+
+static inline uint64 RadixSortNormalizeInt64(int64 value, bool reverse)
+{
+    uint64 key = (uint64)value ^ ((uint64)1 << 63);
+
+    return reverse ? ~key : key;
+}
+
+/*
+ * Sort elems[0..n) on the key produced by keyFn, starting at byte "depth"
+ * (0 is the most significant) and consuming key bytes up to "nbytes".
+ *
+ * fallbackFn(elems, n, keysEqual) is called for every bucket the radix
+ * passes do not finish: with keysEqual false for a small bucket that still
+ * needs a complete comparison sort, with keysEqual true for a run whose
+ * keys are identical and which only needs ordering on the other columns.
+ */
+template <typename T, typename KeyFn, typename FallbackFn>
+static void RadixSortElems(T* elems, size_t n, int depth, int nbytes, KeyFn& keyFn, FallbackFn& fallbackFn)
+{
+    size_t counts[RADIX_SORT_BUCKETS];
+    size_t heads[RADIX_SORT_BUCKETS];
+
+    for (; depth < nbytes; depth++) {
+        int shift = 56 - 8 * depth;
+        size_t offset = 0;
+
+        if (n <= RADIX_SORT_SMALL_BUCKET) {
+            fallbackFn(elems, n, false);
+            return;
+        }
+
+        CHECK_FOR_INTERRUPTS();
+
+        for (int b = 0; b < RADIX_SORT_BUCKETS; b++) {
+            counts[b] = 0;
+        }
+        for (size_t i = 0; i < n; i++) {
+            counts[(keyFn(elems[i]) >> shift) & 0xFF]++;
+        }
+
+        /* Every key has the same byte here, just move on to the next one */
+        if (counts[(keyFn(elems[0]) >> shift) & 0xFF] == n) {
+            continue;
+        }
+
+        for (int b = 0; b < RADIX_SORT_BUCKETS; b++) {
+            heads[b] = offset;
+            offset += counts[b];
+        }
+
+        /*
+         * Permute in place: take the element at the head of each bucket and
+         * keep swapping it into the bucket it belongs to until one that
+         * belongs here turns up.  heads[b] ends up at the end of bucket b.
+         */
+        offset = 0;
+        for (int b = 0; b < RADIX_SORT_BUCKETS; b++) {
+            size_t end = offset + counts[b];
+
+            while (heads[b] < end) {
+                T elem = elems[heads[b]];
+                int digit = (int)((keyFn(elem) >> shift) & 0xFF);
+
+                while (digit != b) {
+                    T tmp = elems[heads[digit]];
+
+                    elems[heads[digit]++] = elem;
+                    elem = tmp;
+                    digit = (int)((keyFn(elem) >> shift) & 0xFF);
+                }
+                elems[heads[b]++] = elem;
+            }
+            offset = end;
+        }
+
+        offset = 0;
+        for (int b = 0; b < RADIX_SORT_BUCKETS; b++) {
+            if (counts[b] > 1) {
+                RadixSortElems(elems + offset, counts[b], depth + 1, nbytes, keyFn, fallbackFn);
+            }
+            offset += counts[b];
+        }
+        return;
+    }
+
+    /* All key bytes consumed, so the whole run shares one key */
+    if (n > 1) {
+        fallbackFn(elems, n, true);
+    }
+}
+
+#endif /* RADIXSORT_H */
@@ -48,6 +48,7 @@
 #define SORTSUPPORT_H
 
 #include "access/attnum.h"
+#include "fmgr.h"
 
 typedef struct SortSupportData* SortSupport;
 
@@ -224,5 +225,9 @@ extern int ApplySortComparator(Datum datum1, bool isNull1, Datum datum2, bool is
 /* Other functions in utils/sort/sortsupport.c */
 extern void PrepareSortSupportComparisonShim(Oid cmpFunc, SortSupport ssup);
 extern void PrepareSortSupportFromOrderingOp(Oid orderingOp, SortSupport ssup);
+extern int ssup_datum_int32_cmp(Datum x, Datum y, SortSupport ssup);
+extern int ssup_datum_int64_cmp(Datum x, Datum y, SortSupport ssup);
+extern int BtreeCmpRadixKeyWidth(PGFunction cmpFunc);
+extern int SortSupportRadixKeyWidth(SortSupport ssup);
 
 #endif /* SORTSUPPORT_H */
@@ -44,6 +44,23 @@ typedef struct BloomFilterRuntime {
     filter::BloomFilter** bf_array; /* bloomfilter array. */
 } BloomFilterRuntime;
 
+/*
+ * Withdraw the filters published by the last build.  They live in the hash
+ * context and describe the old inner rows, so scans below the probe side must
+ * not see them once the hash table is rebuilt.
+ */
+static inline void ResetRuntimeBloomFilter(BloomFilterRuntime* bf_runtime)
+{
+    ListCell* lc = NULL;
+
+    if (bf_runtime->bf_array == NULL)
+        return;
+
+    foreach (lc, bf_runtime->bf_filter_index) {
+        bf_runtime->bf_array[lfirst_int(lc)] = NULL;
+    }
+}
+
 typedef struct VecHashJoinState : public HashJoinState {
     int joinState;
 
@@ -24,6 +24,66 @@
 #ifndef VECTORBATCH_INL
 #define VECTORBATCH_INL
 
+/*
+ * @Description: Collect the positions of the rows kept by a Pack.  Rows in
+ * front of the first dropped row stay where they are, so only the kept rows
+ * after it are collected and the columns can then be compacted one by one
+ * instead of row by row across all columns.
+ * @in sel - flag which row we should move.
+ * @in rows - number of rows in sel.
+ * @out keepIdx - positions of the kept rows after the first dropped one.
+ * @out nkeep - number of positions in keepIdx.
+ * @return - the position of the first dropped row, rows if none is dropped.
+ */
+template <bool copyMatch>
+static inline int PackKeepIndex(_in_ const bool *sel, int rows, _out_ int *keepIdx, _out_ int *nkeep)
+{
+	int	i = 0;
+	int	firstDrop;
+	int	n = 0;
+
+	while (i < rows && (copyMatch ? sel[i] : !sel[i]))
+		i++;
+	firstDrop = i;
+
+	for (; i < rows; i++)
+	{
+		if (copyMatch ? sel[i] : !sel[i])
+			keepIdx[n++] = i;
+	}
+
+	*nkeep = n;
+	return firstDrop;
+}
+
+/*
+ * @Description: Move the kept rows of one column down to writeIdx.
+ */
+static inline void PackColumnT(_in_ ScalarValue *pValues, _in_ uint8 *pFlag, _in_ const int *keepIdx, int nkeep,
+	int writeIdx)
+{
+	for (int k = 0; k < nkeep; k++)
+		pValues[writeIdx + k] = pValues[keepIdx[k]];
+
+	if (pFlag != NULL)
+	{
+		for (int k = 0; k < nkeep; k++)
+			pFlag[writeIdx + k] = pFlag[keepIdx[k]];
+	}
+}
+
+/*
+ * @Description: Move the kept rows of the system columns, which do not
+ * need null flags.
+ */
+static inline void PackSysColumnsT(_in_ SysColContainer *sysColumns, _in_ const int *keepIdx, int nkeep,
+	int writeIdx)
+{
+	Assert(sysColumns != NULL);
+	for (int j = 0; j < sysColumns->sysColumns; j++)
+		PackColumnT(sysColumns->m_ppColumns[j].m_vals, NULL, keepIdx, nkeep, writeIdx);
+}
+
 
 /*
  * @Description: If we call original Pack func to pack data.
@@ -37,60 +97,32 @@
 template <bool copyMatch, bool hasSysCol>
 void VectorBatch::OptimizePackT(_in_ const bool * sel, _in_ List * CopyVars)
 {
-	int     i, j, writeIdx = 0;
+	int     j, writeIdx = 0;
 	ScalarVector *pColumns = m_arr;
 	int     cRows = m_rows;
 	int     cColumns = m_cols;
-	ScalarValue 	*pValues = NULL;
-	uint8*			 pFlag = NULL;
+	int     keepIdx[BatchMaxSize];
+	int     nkeep = 0;
 	errno_t			 rc = EOK;
 
 	Assert (IsValid());
 
 	// Copy all values what we need indeed instead of copy whole table.
 	//
-	for (i = 0; i < cRows; i++)
+	writeIdx = PackKeepIndex<copyMatch>(sel, cRows, keepIdx, &nkeep);
+	if (nkeep > 0)
 	{
-		bool    curSel = *sel ++;
-
-		curSel = copyMatch ?curSel:!curSel;
-		if (curSel)
+		ListCell *var = NULL;
+		foreach (var, CopyVars)
 		{
-			if (i != writeIdx)
-			{
-				Assert (i > writeIdx);
-
-				/*
-				 * If we call original Pack func to pack data.
-				 * There are unnecessarily operations that all column data will be moved.
-				 * An optimization is using OptimizePack func to move specific column data that we want.
-				 */
-				ListCell *var = NULL;
-				foreach (var, CopyVars)
-				{
-					int k = lfirst_int(var) - 1;
-					pValues = pColumns[k].m_vals;
-					pFlag = pColumns[k].m_flag;
-
-					pValues[writeIdx] = pValues[i];
-					pFlag[writeIdx] = pFlag[i];
-				}
-
-				if(hasSysCol)
-				{
-					Assert(m_sysColumns != NULL);
-					for(j = 0 ; j < m_sysColumns->sysColumns; j++)
-					{
-						//sys column do not need null flag
-						pValues = m_sysColumns->m_ppColumns[j].m_vals;
-						pValues[writeIdx] = pValues[i];
-					}
-				}
-			}
-
-			writeIdx ++;
+			int k = lfirst_int(var) - 1;
+			PackColumnT(pColumns[k].m_vals, pColumns[k].m_flag, keepIdx, nkeep, writeIdx);
 		}
+
+		if (hasSysCol)
+			PackSysColumnsT(m_sysColumns, keepIdx, nkeep, writeIdx);
 	}
+	writeIdx += nkeep;
 
 	for (j = 0; j < cColumns; j++)
 	{
@@ -119,67 +151,35 @@ void VectorBatch::OptimizePackT(_in_ const bool * sel, _in_ List * CopyVars)
 template <bool copyMatch, bool hasSysCol>
 void VectorBatch::OptimizePackTForLateRead(_in_ const bool * sel, _in_ List * lateVars, int ctidColIdx)
 {
-	int     i, j, k, writeIdx = 0;
+	int     j, k, writeIdx = 0;
 	ScalarVector *pColumns = m_arr;
 	int     cRows = m_rows;
 	int     cColumns = m_cols;
-	ScalarValue 	*pValues = NULL;
-	uint8*			 pFlag = NULL;
+	int     keepIdx[BatchMaxSize];
+	int     nkeep = 0;
 	errno_t			 rc = EOK;
 
 	Assert (IsValid());
 
 	// Copy all values what we need indeed instead of copy whole table.
 	//
-	for (i = 0; i < cRows; i++)
+	writeIdx = PackKeepIndex<copyMatch>(sel, cRows, keepIdx, &nkeep);
+	if (nkeep > 0)
 	{
-		bool    curSel = *sel ++;
-
-		curSel = copyMatch ?curSel:!curSel;
-		if (curSel)
+		ListCell *var = NULL;
+		foreach (var, lateVars)
 		{
-			if (i != writeIdx)
-			{
-				Assert (i > writeIdx);
-
-				/*
-				 * If we call original Pack func to pack data.
-				 * There are unnecessarily operations that all column data will be moved.
-				 * An optimization is using OptimizePack func to move specific column data that we want.
-				 */
-				
-				ListCell *var = NULL;
-				foreach (var, lateVars)
-				{
-					k = lfirst_int(var) - 1;
-					pValues = pColumns[k].m_vals;
-					pFlag = pColumns[k].m_flag;
-
-					pValues[writeIdx] = pValues[i];
-					pFlag[writeIdx] = pFlag[i];
-				}
-				
-				k = ctidColIdx;
-				pValues = pColumns[k].m_vals;
-				pFlag = pColumns[k].m_flag;
-
-				pValues[writeIdx] = pValues[i];
-				pFlag[writeIdx] = pFlag[i];
-
-				if(hasSysCol)
-				{
-					Assert(m_sysColumns != NULL);
-					for(j = 0 ; j < m_sysColumns->sysColumns; j++)
-					{
-						//sys column do not need null flag
-						pValues = m_sysColumns->m_ppColumns[j].m_vals;
-						pValues[writeIdx] = pValues[i];
-					}
-				}
-			}
-			writeIdx ++;
-		}	
+			k = lfirst_int(var) - 1;
+			PackColumnT(pColumns[k].m_vals, pColumns[k].m_flag, keepIdx, nkeep, writeIdx);
+		}
+
+		k = ctidColIdx;
+		PackColumnT(pColumns[k].m_vals, pColumns[k].m_flag, keepIdx, nkeep, writeIdx);
+
+		if (hasSysCol)
+			PackSysColumnsT(m_sysColumns, keepIdx, nkeep, writeIdx);
 	}
+	writeIdx += nkeep;
 
 	for (j = 0; j < cColumns; j++)
 	{
@@ -198,12 +198,12 @@ void VectorBatch::OptimizePackTForLateRead(_in_ const bool * sel, _in_ List * la
 template <bool copyMatch, bool hasSysCol>
 void VectorBatch::PackT (_in_ const bool *sel)
 {
-	int     i, j, writeIdx = 0;
+	int     j, writeIdx = 0;
 	ScalarVector *pColumns = m_arr;
 	int     cRows = m_rows;
 	int     cColumns = m_cols;
-	ScalarValue 	*pValues = NULL;
-	uint8*			 pFlag = NULL;
+	int     keepIdx[BatchMaxSize];
+	int     nkeep = 0;
 	errno_t			 rc = EOK;
 
 	Assert (IsValid());
@@ -211,41 +211,16 @@ void VectorBatch::PackT (_in_ const bool *sel)
 
 	// Copy all values
 	//
-	for (i = 0; i < cRows; i++)
+	writeIdx = PackKeepIndex<copyMatch>(sel, cRows, keepIdx, &nkeep);
+	if (nkeep > 0)
 	{
-		bool    curSel = *sel ++;
+		for (j = 0; j < cColumns; j++)
+			PackColumnT(pColumns[j].m_vals, pColumns[j].m_flag, keepIdx, nkeep, writeIdx);
 
-		curSel = copyMatch ?curSel:!curSel;
-		if (curSel)
-		{
-			if (i != writeIdx)
-			{
-				Assert (i > writeIdx);
-
-				for (j = 0; j < cColumns; j++)
-				{
-					pValues = pColumns[j].m_vals;
-					pFlag = pColumns[j].m_flag;
-					
-					pValues[writeIdx] = pValues[i];
-					pFlag[writeIdx] = pFlag[i];
-				}
-
-				if(hasSysCol)
-				{
-					Assert(m_sysColumns != NULL);
-					for(j = 0 ; j < m_sysColumns->sysColumns; j++)
-					{
-						//sys column do not need null flag
-						pValues = m_sysColumns->m_ppColumns[j].m_vals;
-						pValues[writeIdx] = pValues[i];
-					}
-				}
-			}
-
-			writeIdx ++;
-		}
+		if (hasSysCol)
+			PackSysColumnsT(m_sysColumns, keepIdx, nkeep, writeIdx);
 	}
+	writeIdx += nkeep;
 
 	// Restore constant columns
 	//
@@ -30,6 +30,16 @@
 #include "vectorsonic/vsonichash.h"
 #include "vectorsonic/vsonicpartition.h"
 
+/*
+ * Partial (lower stage) hashagg samples this many input batches before deciding
+ * whether the group keys reduce the input at all.
+ */
+#define SONIC_AGG_FLUSH_SAMPLE_BATCHES 16
+/* groups over input rows above this ratio means aggregation hardly reduces rows */
+#define SONIC_AGG_FLUSH_GROUP_RATIO 0.8
+/* flush the hash table to the upper agg once used memory exceeds this ratio of work mem */
+#define SONIC_AGG_FLUSH_MEM_RATIO 0.8
+
 class SonicHashAgg : public SonicHash {
 public:
     SonicHashAgg(VecAggState* node, int arrSize);
@@ -111,6 +121,10 @@ private:
 
     void expandHashTable();
 
+    bool judgePartialFlush();
+
+    void resetHashTableForFlush();
+
     /* following functions are about partiton function */
     int64 calcLeftRows(int64 rows_in_mem);
 
@@ -187,6 +201,21 @@ private:
     /* current partition index */
     int m_currPartIdx;
 
+    /*
+     * For a lower stage agg, groups may be handed to the upper agg before the
+     * input is exhausted instead of spilling when keys are nearly unique.
+     */
+    bool m_partialFlush;
+
+    /* hash table is emitted before the input is exhausted, build again after fetch */
+    bool m_flushPending;
+
+    /* hash table has been flushed at least once, so it can't be rescanned */
+    bool m_flushed;
+
+    /* input rows consumed since the hash table was last rebuilt */
+    int64 m_buildRows;
+
     /*
      * Create a list of the tuple columns that actually need to be stored in
      * hashtable entries.  The incoming tuples from the outer plan node will
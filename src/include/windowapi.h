@@ -136,6 +136,14 @@ typedef struct WindowStatePerAggData {
     bool transValueIsNull;
 
     bool noTransValue; /* true if transValue not set yet */
+
+    /*
+     * true if rows can be removed from transValue as the frame head moves,
+     * see retreat_windowaggregate.  transCount is the number of non-NULL
+     * inputs currently accumulated, so a SUM can go back to NULL.
+     */
+    bool invertible;
+    int64 transCount;
 } WindowStatePerAggData;
 
 #define PG_WINDOW_OBJECT() ((WindowObject)fcinfo->context)
@@ -0,0 +1,27 @@
+--
+-- moving window frames over invertible aggregates
+--
+create table window_moving_frame_t(a int, x int);
+insert into window_moving_frame_t values (1, 1), (2, 2), (3, 3), (4, NULL), (5, 5);
+
+-- frame head moves, frame end stays at the partition end
+select a, sum(x) over w as s, count(x) over w as c, count(*) over w as n
+from window_moving_frame_t
+window w as (order by a rows between current row and unbounded following)
+order by a;
+
+-- frame head moves, frame end is the current row
+select a, sum(x) over w as s, count(x) over w as c
+from window_moving_frame_t
+window w as (order by a rows between 1 preceding and current row)
+order by a;
+
+-- frame becomes all NULL; an initcond has to come back, not NULL
+create aggregate window_moving_frame_sum100(int4) (sfunc = int4_sum, stype = int8, initcond = '100');
+select a, sum(x) over w as s, count(x) over w as c, window_moving_frame_sum100(x) over w as s100
+from window_moving_frame_t
+window w as (order by a rows between current row and current row)
+order by a;
+drop aggregate window_moving_frame_sum100(int4);
+
+drop table window_moving_frame_t;